@@ -27,7 +27,8 @@
 //****************************************************************************
 // random numbers
 
-static unsigned long seed = 0;
+// per-thread so that islands stepped concurrently don't race on it
+static thread_local unsigned long seed = 0;
 
 unsigned long dRand()
 {
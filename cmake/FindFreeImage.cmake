@@ -0,0 +1,51 @@
+# - Find FreeImage library
+# Find the native FreeImage and FreeImagePlus includes and libraries
+# This module defines
+#  FREEIMAGE_INCLUDE_DIRS, where to find FreeImage.h and FreeImagePlus.h
+#  FREEIMAGE_LIBRARIES, libraries to link against to use FreeImage and FreeImagePlus
+#  FREEIMAGE_FOUND, If false, do not try to use FreeImage.
+#
+# also defined, but not for general use are
+#  FREEIMAGE_INCLUDE_DIR, FREEIMAGEPLUS_INCLUDE_DIR, FREEIMAGE_LIBRARY, FREEIMAGEPLUS_LIBRARY
+
+FIND_PATH(FREEIMAGE_INCLUDE_DIR FreeImage.h
+  PATH_SUFFIXES
+    include
+)
+
+FIND_PATH(FREEIMAGEPLUS_INCLUDE_DIR FreeImagePlus.h
+  PATH_SUFFIXES
+    include
+)
+
+FIND_LIBRARY(FREEIMAGE_LIBRARY
+  NAMES
+    freeimage FreeImage
+  PATH_SUFFIXES
+    lib64 lib
+)
+
+FIND_LIBRARY(FREEIMAGEPLUS_LIBRARY
+  NAMES
+    freeimageplus FreeImagePlus
+  PATH_SUFFIXES
+    lib64 lib
+)
+
+# handle the QUIETLY and REQUIRED arguments and set FREEIMAGE_FOUND to TRUE if
+# all listed variables are TRUE
+INCLUDE(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(FreeImage DEFAULT_MSG
+  FREEIMAGE_LIBRARY FREEIMAGEPLUS_LIBRARY FREEIMAGE_INCLUDE_DIR FREEIMAGEPLUS_INCLUDE_DIR)
+
+IF(FREEIMAGE_FOUND)
+  SET(FREEIMAGE_LIBRARIES ${FREEIMAGE_LIBRARY} ${FREEIMAGEPLUS_LIBRARY})
+  SET(FREEIMAGE_INCLUDE_DIRS ${FREEIMAGE_INCLUDE_DIR} ${FREEIMAGEPLUS_INCLUDE_DIR})
+ENDIF(FREEIMAGE_FOUND)
+
+MARK_AS_ADVANCED(
+  FREEIMAGE_INCLUDE_DIR
+  FREEIMAGEPLUS_INCLUDE_DIR
+  FREEIMAGE_LIBRARY
+  FREEIMAGEPLUS_LIBRARY
+)
@@ -280,6 +280,8 @@ void D3DXRenderBase::DumpStatistics(IGameFont& font, IPerformanceAlert* alert)
     font.OutNext("DT_Cache:     %2.2fms", BasicStats.DetailCache.result);
     font.OutNext("Wallmarks:    %2.2fms, %d/%d - %d", BasicStats.Wallmarks.result, BasicStats.StaticWMCount,
         BasicStats.DynamicWMCount, BasicStats.WMTriCount);
+    font.OutNext("Particles:    %2.2fms, %u, %2.2fM/s", BasicStats.Particles.result, BasicStats.ParticlesCount,
+        BasicStats.Particles.result > 0.f ? BasicStats.ParticlesCount / (BasicStats.Particles.result * 1000.f) : 0.f);
     font.OutNext("Glows:        %2.2fms", BasicStats.Glows.result);
     font.OutNext("Lights:       %2.2fms, %d", BasicStats.Lights.result, BasicStats.Lights.count);
     font.OutNext("RT:           %2.2fms, %d", BasicStats.RenderTargets.result, BasicStats.RenderTargets.count);
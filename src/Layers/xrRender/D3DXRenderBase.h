@@ -6,6 +6,8 @@
 #include "r__sector.h"
 #include "xr_effgamma.h"
 
+class CKinematics;
+
 // feedback	for receiving visuals
 class R_feedback
 {
@@ -69,6 +71,7 @@ public:
     xr_vector<ISpatial*> lstSpatial;
     xr_vector<dxRender_Visual*> lstVisuals;
     xr_vector<R_dsgraph::_LodItem> lstLODs;
+    xr_vector<CKinematics*> lstKinematics;
 
     u32 counter_S;
     u32 counter_D;
@@ -121,6 +124,7 @@ public:
         lstRenderables.clear();
         lstSpatial.clear();
         lstVisuals.clear();
+        lstKinematics.clear();
 
         for (int i = 0; i < SHADER_PASSES_MAX; ++i)
         {
@@ -157,6 +161,7 @@ protected:
 public:
     void r_dsgraph_insert_dynamic(IRenderable* root, dxRender_Visual* pVisual, Fmatrix& xform, Fvector& Center);
     void r_dsgraph_insert_static(dxRender_Visual* pVisual);
+    void r_dsgraph_calculate_bones(const CFrustum& view); // evaluate skeletons in view before the graph is built
 
     // render primitives
     void r_dsgraph_render_graph(u32 _priority);
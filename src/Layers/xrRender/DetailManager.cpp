@@ -17,6 +17,8 @@
 #else
 #include "xrEngine/IGame_Persistent.h"
 #include "xrEngine/Environment.h"
+#endif
+
 #if defined(XR_ARCHITECTURE_X86) || defined(XR_ARCHITECTURE_X64) || defined(XR_ARCHITECTURE_E2K)
 #include <xmmintrin.h>
 #elif defined(XR_ARCHITECTURE_ARM) || defined(XR_ARCHITECTURE_ARM64)
@@ -24,7 +26,6 @@
 #else
 #error Add your platform here
 #endif
-#endif
 
 const float dbgOffset = 0.f;
 const int dbgItems = 128;
@@ -80,7 +81,7 @@ void CDetailManager::SSwingValue::lerp(const SSwingValue& A, const SSwingValue&
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 // XXX stats: add to statistics
-CDetailManager::CDetailManager() : xrc("detail manager")
+CDetailManager::CDetailManager()
 {
     dtFS = nullptr;
     dtSlots = nullptr;
@@ -90,6 +91,8 @@ CDetailManager::CDetailManager() : xrc("detail manager")
     m_time_rot_2 = 0;
     m_time_pos = 0;
     m_global_time_old = 0;
+    m_visible_buffer = 0;
+    m_render_buffer = 0;
 
     // KD: variable detail radius
     dm_size = dm_current_size;
@@ -187,8 +190,9 @@ void CDetailManager::Load()
     m_slots->close();
 
     // Initialize 'vis' and 'cache'
-    for (u32 i = 0; i < 3; ++i)
-        m_visibles[i].resize(objects.size());
+    for (auto& buffer : m_visibles)
+        for (u32 i = 0; i < 3; ++i)
+            buffer[i].resize(objects.size());
     cache_Initialize();
 
     // Make dither matrix
@@ -222,24 +226,102 @@ void CDetailManager::Unload()
     }
 
     objects.clear();
-    m_visibles[0].clear();
-    m_visibles[1].clear();
-    m_visibles[2].clear();
+    for (auto& buffer : m_visibles)
+    {
+        buffer[0].clear();
+        buffer[1].clear();
+        buffer[2].clear();
+    }
+    for (SlotItem* item : cache_retired)
+        poolSI.destroy(item);
+    cache_retired.clear();
     FS.r_close(dtFS);
 }
 
 extern ECORE_API float r_ssaDISCARD;
 
+namespace
+{
+static_assert(dm_cache1_count * dm_cache1_count % 4 == 0, "Slots are tested by 4");
+
+// Frustum planes splatted for testing bounds of 4 slots at once
+struct SlotsFrustum
+{
+    __m128 nx[FRUSTUM_MAXPLANES], ny[FRUSTUM_MAXPLANES], nz[FRUSTUM_MAXPLANES], d[FRUSTUM_MAXPLANES];
+    __m128 ax[FRUSTUM_MAXPLANES], ay[FRUSTUM_MAXPLANES], az[FRUSTUM_MAXPLANES]; // abs(n)
+    size_t count;
+
+    explicit SlotsFrustum(const CFrustum& F) : count(F.p_count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Fplane& P = F.planes[i];
+            nx[i] = _mm_set1_ps(P.n.x);
+            ny[i] = _mm_set1_ps(P.n.y);
+            nz[i] = _mm_set1_ps(P.n.z);
+            d[i] = _mm_set1_ps(P.d);
+            ax[i] = _mm_set1_ps(_abs(P.n.x));
+            ay[i] = _mm_set1_ps(_abs(P.n.y));
+            az[i] = _mm_set1_ps(_abs(P.n.z));
+        }
+    }
+
+    // Bit i is set if the box of slots[i] isn't outside of any plane from the mask.
+    // Box is outside if its nearest to the plane corner is, same as CFrustum::AABB_OverlapPlane.
+    u32 test(CDetailManager::Slot** const* slots, u32 mask) const
+    {
+        const Fbox& B0 = (*slots[0])->vis.box;
+        const Fbox& B1 = (*slots[1])->vis.box;
+        const Fbox& B2 = (*slots[2])->vis.box;
+        const Fbox& B3 = (*slots[3])->vis.box;
+
+        const __m128 half = _mm_set1_ps(.5f);
+        const __m128 min_x = _mm_setr_ps(B0.vMin.x, B1.vMin.x, B2.vMin.x, B3.vMin.x);
+        const __m128 min_y = _mm_setr_ps(B0.vMin.y, B1.vMin.y, B2.vMin.y, B3.vMin.y);
+        const __m128 min_z = _mm_setr_ps(B0.vMin.z, B1.vMin.z, B2.vMin.z, B3.vMin.z);
+        const __m128 max_x = _mm_setr_ps(B0.vMax.x, B1.vMax.x, B2.vMax.x, B3.vMax.x);
+        const __m128 max_y = _mm_setr_ps(B0.vMax.y, B1.vMax.y, B2.vMax.y, B3.vMax.y);
+        const __m128 max_z = _mm_setr_ps(B0.vMax.z, B1.vMax.z, B2.vMax.z, B3.vMax.z);
+
+        const __m128 cx = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+        const __m128 cy = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+        const __m128 cz = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+        const __m128 ex = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+        const __m128 ey = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+        const __m128 ez = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+        __m128 outside = _mm_setzero_ps();
+        u32 bit = 1;
+        for (size_t i = 0; i < count; ++i, bit <<= 1)
+        {
+            if (!(mask & bit))
+                continue;
+            const __m128 dist = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(nx[i], cx), _mm_mul_ps(ny[i], cy)), _mm_add_ps(_mm_mul_ps(nz[i], cz), d[i]));
+            const __m128 radius =
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[i], ex), _mm_mul_ps(ay[i], ey)), _mm_mul_ps(az[i], ez));
+            outside = _mm_or_ps(outside, _mm_cmpgt_ps(_mm_sub_ps(dist, radius), _mm_setzero_ps()));
+        }
+        return ~u32(_mm_movemask_ps(outside)) & 0xf;
+    }
+};
+} // namespace
+
 void CDetailManager::UpdateVisibleM()
 {
+    // Render keeps reading the other buffer meanwhile
+    const u32 buffer = 1 - m_visible_buffer;
+    vis_list* visibles = m_visibles[buffer];
+
     for (int i = 0; i != 3; ++i)
-        for (auto& vis : m_visibles[i])
+        for (auto& vis : visibles[i])
             vis.clear();
 
     Fvector EYE = Device.vCameraPositionSaved;
 
     CFrustum View;
     View.CreateFromMatrix(Device.mFullTransformSaved, FRUSTUM_P_LRTB + FRUSTUM_P_FAR);
+    const SlotsFrustum ViewSlots(View);
 
     float fade_limit = dm_fade;
     fade_limit = fade_limit * fade_limit;
@@ -268,7 +350,16 @@ void CDetailManager::UpdateVisibleM()
             }
             // test slots
 
-            u32 dwCC = dm_cache1_count * dm_cache1_count;
+            constexpr u32 dwCC = dm_cache1_count * dm_cache1_count;
+
+            // if upper test = fcvPartial - test inner slots, only planes crossing MS are left in mask
+            u32 visible_slots = u32(-1);
+            if (fcvPartial == res)
+            {
+                visible_slots = 0;
+                for (u32 _i = 0; _i < dwCC; _i += 4)
+                    visible_slots |= ViewSlots.test(MS.slots + _i, mask) << _i;
+            }
 
             for (u32 _i = 0; _i < dwCC; _i++)
             {
@@ -284,15 +375,9 @@ void CDetailManager::UpdateVisibleM()
                     continue;
                 }
 
-                // if upper test = fcvPartial - test inner slots
-                if (fcvPartial == res)
+                if (!(visible_slots & (1 << _i)))
                 {
-                    u32 _mask = mask;
-                    u32 _res = View.testSAABB(S.vis.sphere.P, S.vis.sphere.R, S.vis.box.data(), _mask);
-                    if (fcvNone == _res)
-                    {
-                        continue; // invisible-view frustum
-                    }
+                    continue; // invisible-view frustum
                 }
 #ifndef _EDITOR
                 if (!RImplementation.HOM.visible(S.vis))
@@ -312,15 +397,17 @@ void CDetailManager::UpdateVisibleM()
                     float dist_sq_rcp = 1.f / dist_sq;
 
                     S.frame = RDEVICE.dwFrame + Random.randI(15, 30);
+                    S.r_buffer = buffer;
+                    S.r_both = 0;
                     for (int sp_id = 0; sp_id < dm_obj_in_slot; sp_id++)
                     {
                         SlotPart& sp = S.G[sp_id];
                         if (sp.id == DetailSlot::ID_Empty)
                             continue;
 
-                        sp.r_items[0].clear();
-                        sp.r_items[1].clear();
-                        sp.r_items[2].clear();
+                        sp.r_items[buffer][0].clear();
+                        sp.r_items[buffer][1].clear();
+                        sp.r_items[buffer][2].clear();
 
                         float R = objects[sp.id]->bv_sphere.R;
                         float Rq_drcp = R * R * dist_sq_rcp; // reordered expression for 'ssa' calc
@@ -328,7 +415,7 @@ void CDetailManager::UpdateVisibleM()
                         for(auto &siIT : sp.items)
                         {
                             SlotItem& Item = *siIT;
-                            float scale = Item.scale_calculated = Item.scale * alpha_i;
+                            float scale = Item.scale_calculated[buffer] = Item.scale * alpha_i;
                             float ssa = scale * scale * Rq_drcp;
                             if (ssa < r_ssaDISCARD)
                             {
@@ -338,28 +425,45 @@ void CDetailManager::UpdateVisibleM()
                             if (ssa > r_ssaCHEAP)
                                 vis_id = Item.vis_ID;
 
-                            sp.r_items[vis_id].push_back(siIT);
+                            sp.r_items[buffer][vis_id].push_back(siIT);
 
                             // 2 visible[vis_id][sp.id].push_back(&Item);
                         }
                     }
                 }
+                else if (S.r_buffer != buffer && !S.r_both)
+                {
+                    // Lists are still valid, but were built for the other buffer
+                    const u32 built = S.r_buffer;
+                    S.r_both = 1;
+                    for (int sp_id = 0; sp_id < dm_obj_in_slot; sp_id++)
+                    {
+                        SlotPart& sp = S.G[sp_id];
+                        if (sp.id == DetailSlot::ID_Empty)
+                            continue;
+
+                        for (u32 vis_id = 0; vis_id < 3; vis_id++)
+                            sp.r_items[buffer][vis_id] = sp.r_items[built][vis_id];
+                        for (SlotItem* item : sp.items)
+                            item->scale_calculated[buffer] = item->scale_calculated[built];
+                    }
+                }
                 for (int sp_id = 0; sp_id < dm_obj_in_slot; sp_id++)
                 {
                     SlotPart& sp = S.G[sp_id];
                     if (sp.id == DetailSlot::ID_Empty)
                         continue;
-                    if (!sp.r_items[0].empty())
+                    if (!sp.r_items[buffer][0].empty())
                     {
-                        m_visibles[0][sp.id].push_back(&sp.r_items[0]);
+                        visibles[0][sp.id].push_back(&sp.r_items[buffer][0]);
                     }
-                    if (!sp.r_items[1].empty())
+                    if (!sp.r_items[buffer][1].empty())
                     {
-                        m_visibles[1][sp.id].push_back(&sp.r_items[1]);
+                        visibles[1][sp.id].push_back(&sp.r_items[buffer][1]);
                     }
-                    if (!sp.r_items[2].empty())
+                    if (!sp.r_items[buffer][2].empty())
                     {
-                        m_visibles[2][sp.id].push_back(&sp.r_items[2]);
+                        visibles[2][sp.id].push_back(&sp.r_items[buffer][2]);
                     }
                 }
             }
@@ -379,6 +483,7 @@ void CDetailManager::Render()
 
     // MT
     MT_SYNC();
+    m_render_buffer = m_visible_buffer;
 
     RImplementation.BasicStats.DetailRender.Begin();
     g_pGamePersistent->m_pGShaderConstants->m_blender_mode.w = 1.0f; //--#SM+#-- Флаг начала рендера травы [begin of grass render]
@@ -414,6 +519,12 @@ void __stdcall CDetailManager::MT_CALC()
 #endif
 
     MT.Enter();
+    MT_Update();
+    MT.Leave();
+}
+
+void CDetailManager::MT_Update()
+{
     if (m_frame_calc != RDEVICE.dwFrame)
         if ((m_frame_rendered + 1) == RDEVICE.dwFrame) // already rendered
         {
@@ -427,7 +538,7 @@ void __stdcall CDetailManager::MT_CALC()
             RImplementation.BasicStats.DetailCache.End();
 
             UpdateVisibleM();
+            m_visible_buffer = 1 - m_visible_buffer;
             m_frame_calc = RDEVICE.dwFrame;
         }
-    MT.Leave();
 }
@@ -56,7 +56,7 @@ public:
     struct SlotItem
     { // один кустик
         float scale;
-        float scale_calculated;
+        float scale_calculated[2]; // per visible lists buffer
         Fmatrix mRotY;
         u32 vis_ID; // индекс в visibility списке он же тип [не качается, качается1, качается2]
         float c_hemi;
@@ -72,7 +72,7 @@ public:
     { //
         u32 id; // ID модельки
         SlotItemVec items; // список кустиков
-        SlotItemVec r_items[3]; // список кустиков for render
+        SlotItemVec r_items[2][3]; // список кустиков for render, per visible lists buffer
     };
 
     enum SlotType
@@ -89,7 +89,9 @@ public:
         {
             u32 empty : 1;
             u32 type : 1;
-            u32 frame : 30;
+            u32 r_buffer : 1; // visible lists buffer r_items were built for
+            u32 r_both : 1; // r_items were copied to the other buffer too
+            u32 frame : 28;
         };
         int sx, sz; // координаты слота X x Y
         vis_data vis; //
@@ -100,6 +102,8 @@ public:
             frame = 0;
             empty = 1;
             type = stReady;
+            r_buffer = 0;
+            r_both = 0;
             sx = sz = 0;
             vis.clear();
         }
@@ -147,15 +151,22 @@ public:
     DetailSlot DS_empty;
 
     DetailVec objects;
-    vis_list m_visibles[3]; // 0=still, 1=Wave1, 2=Wave2
+    // Calc fills one buffer while Render reads the other one
+    vis_list m_visibles[2][3]; // 0=still, 1=Wave1, 2=Wave2
 
-#ifndef _EDITOR
-    xrXRC xrc;
-#endif
     //AVO: detail draw radius
     CacheSlot1** cache_level1;
     Slot*** cache; // grid-cache itself
     svector<Slot*, dm_max_cache_size> cache_task; // non-unpacked slots
+
+    // Slot unpacked by a worker, items are moved into poolSI after the batch
+    struct DecompressTask
+    {
+        Slot* slot;
+        xr_vector<SlotItem> items[dm_obj_in_slot];
+    };
+    xr_vector<DecompressTask> cache_decompress;
+    SlotItemVec cache_retired; // items of re-tasked slots, render may still use them until the next calc
     Slot* cache_pool; // just memory for slots
 
     int cache_cx;
@@ -204,7 +215,8 @@ public:
     void cache_Update(int sx, int sz, Fvector& view, int limit);
     void cache_Task(int gx, int gz, Slot* D);
     Slot* cache_Query(int sx, int sz);
-    void cache_Decompress(Slot* D);
+    void cache_Decompress(DecompressTask& task);
+    void cache_DecompressBatch();
     BOOL cache_Validate();
     // cache grid to world
     int cg2w_X(int x) { return cache_cx - dm_size + x; }
@@ -220,14 +232,21 @@ public:
     Lock MT;
     volatile u32 m_frame_calc;
     volatile u32 m_frame_rendered;
+    volatile u32 m_visible_buffer; // filled by the last calc
+    u32 m_render_buffer; // latched by Render for hw_Render_dump
 
     void __stdcall MT_CALC();
+    void MT_Update(); // MT must be held
     ICF void MT_SYNC()
     {
         if (m_frame_calc == RDEVICE.dwFrame)
             return;
 
-        MT_CALC();
+        // Parallel calc is in flight, render its previous lists instead of waiting
+        if (!MT.TryEnter())
+            return;
+        MT_Update();
+        MT.Leave();
     }
 
     CDetailManager();
@@ -57,6 +57,7 @@ void CDetailManager::cache_Task(int gx, int gz, Slot* D)
     D->type = stPending;
     D->sx = sx;
     D->sz = sz;
+    D->frame = 0;
 
     D->vis.box.vMin.set(sx * dm_slot_size, DS.r_ybase(), sz * dm_slot_size);
     D->vis.box.vMax.set(D->vis.box.vMin.x + dm_slot_size, DS.r_ybase() + DS.r_yheight(), D->vis.box.vMin.z + dm_slot_size);
@@ -65,8 +66,8 @@ void CDetailManager::cache_Task(int gx, int gz, Slot* D)
     for (u32 i = 0; i < dm_obj_in_slot; i++)
     {
         D->G[i].id = DS.r_id(i);
-        for (u32 clr = 0; clr < D->G[i].items.size(); clr++)
-            poolSI.destroy(D->G[i].items[clr]);
+        // Render lists of the previous calc may still point to them
+        cache_retired.insert(cache_retired.end(), D->G[i].items.begin(), D->G[i].items.end());
         D->G[i].items.clear();
     }
 
@@ -98,6 +99,11 @@ BOOL CDetailManager::cache_Validate()
 
 void CDetailManager::cache_Update(int v_x, int v_z, Fvector& view, int limit)
 {
+    // Lists referencing them were replaced by the previous calc
+    for (SlotItem* item : cache_retired)
+        poolSI.destroy(item);
+    cache_retired.clear();
+
     bool bNeedMegaUpdate = (cache_cx != v_x) || (cache_cz != v_z);
     // ***** Cache shift
     while (cache_cx != v_x)
@@ -164,47 +170,36 @@ void CDetailManager::cache_Update(int v_x, int v_z, Fvector& view, int limit)
     }
 
     // Task performer
-    BOOL bFullUnpack = FALSE;
     if (cache_task.size() == dm_cache_size)
-    {
-        limit = dm_cache_size;
-        bFullUnpack = TRUE;
-    }
+        limit = dm_cache_size; // full unpack
 
-    for (int iteration = 0; cache_task.size() && (iteration < limit); iteration++)
+    const u32 count = std::min(u32(cache_task.size()), u32(limit));
+    if (count)
     {
-        u32 best_id = 0;
-        float best_dist = flt_max;
-
-        if (bFullUnpack)
-        {
-            best_id = cache_task.size() - 1;
-        }
-        else
+        // Nearest slots go first
+        if (count < cache_task.size())
         {
-            for (u32 entry = 0; entry < cache_task.size(); entry++)
+            std::nth_element(cache_task.begin(), cache_task.begin() + count, cache_task.end(),
+                [&view](const Slot* A, const Slot* B)
             {
-                // Gain access to data
-                Slot* S = cache_task[entry];
-                VERIFY(stPending == S->type);
-
-                // Estimate
-                Fvector C;
-                S->vis.box.getcenter(C);
-                float D = view.distance_to_sqr(C);
-
-                // Select
-                if (D < best_dist)
-                {
-                    best_dist = D;
-                    best_id = entry;
-                }
-            }
+                VERIFY(stPending == A->type && stPending == B->type);
+                Fvector CA, CB;
+                A->vis.box.getcenter(CA);
+                B->vis.box.getcenter(CB);
+                return view.distance_to_sqr(CA) < view.distance_to_sqr(CB);
+            });
         }
 
-        // Decompress and remove task
-        cache_Decompress(cache_task[best_id]);
-        cache_task.erase(best_id);
+        // Decompress and remove tasks
+        cache_decompress.resize(count);
+        for (u32 i = 0; i < count; i++)
+            cache_decompress[i].slot = cache_task[i];
+        cache_DecompressBatch();
+
+        const u32 left = cache_task.size() - count;
+        for (u32 i = 0; i < left; i++)
+            cache_task[i] = cache_task[count + i];
+        cache_task.resize(left);
     }
 
     if (bNeedMegaUpdate)
@@ -2,6 +2,7 @@
 #pragma hdrstop
 #include "DetailManager.h"
 #include "xrCDB/Intersect.hpp"
+#include "xrCore/Threading/ParallelFor.hpp"
 #ifdef _EDITOR
 #include "scene.h"
 #include "sceneobject.h"
@@ -68,11 +69,43 @@ bool det_render_debug = false;
 
 #include "xrEngine/GameMtlLib.h"
 
+void CDetailManager::cache_DecompressBatch()
+{
+    const auto decompress = [this](const TaskRange<size_t>& range)
+    {
+        for (size_t i = range.begin(); i != range.end(); ++i)
+            cache_Decompress(cache_decompress[i]);
+    };
+#if !defined(_EDITOR) && defined(DEBUG)
+    if (det_render_debug)
+        decompress(TaskRange<size_t>(0, cache_decompress.size(), 1)); // debug render isn't thread-safe
+    else
+#endif
+        xr_parallel_for(TaskRange<size_t>(0, cache_decompress.size(), 1), decompress);
+
+    // poolSI isn't thread-safe, fill slots afterwards
+    for (DecompressTask& task : cache_decompress)
+    {
+        Slot& D = *task.slot;
+        for (u32 i = 0; i < dm_obj_in_slot; i++)
+        {
+            for (const SlotItem& item : task.items[i])
+            {
+                SlotItem* ItemP = poolSI.create();
+                *ItemP = item;
+                D.G[i].items.push_back(ItemP);
+            }
+            task.items[i].clear();
+        }
+        D.frame = 0; // rebuild render lists with new items
+    }
+}
+
 //#define		DBG_SWITCHOFF_RANDOMIZE
-void CDetailManager::cache_Decompress(Slot* S)
+void CDetailManager::cache_Decompress(DecompressTask& task)
 {
-    VERIFY(S);
-    Slot& D = *S;
+    VERIFY(task.slot);
+    Slot& D = *task.slot;
     D.type = stReady;
     if (D.empty)
         return;
@@ -83,9 +116,11 @@ void CDetailManager::cache_Decompress(Slot* S)
     Fvector bC, bD;
     D.vis.box.get_CD(bC, bD);
 
+    // Slots are decompressed in parallel, collider can't be shared
+    CDB::COLLIDER xrc;
     xrc.box_options(CDB::OPT_FULL_TEST);
     xrc.box_query(g_pGameLevel->ObjectSpace.GetStaticModel(), bC, bD);
-    u32 triCount = xrc.r_count();
+    u32 triCount = u32(xrc.r_count());
     CDB::TRI* tris = g_pGameLevel->ObjectSpace.GetStaticTris();
     Fvector* verts = g_pGameLevel->ObjectSpace.GetStaticVerts();
 
@@ -113,6 +148,7 @@ void CDetailManager::cache_Decompress(Slot* S)
     CRandom r_jitter(0x12071980 ^ p_rnd);
     CRandom r_yaw(0x12071980 ^ p_rnd);
     CRandom r_scale(0x12071980 ^ p_rnd);
+    CRandom r_wave(0x12071980 ^ p_rnd);
 
     // Prepare to actual-bounds-calculations
     Fbox Bounds;
@@ -172,8 +208,7 @@ void CDetailManager::cache_Decompress(Slot* S)
 #endif
 
             CDetail* Dobj = objects[DS.r_id(index)];
-            SlotItem* ItemP = poolSI.create();
-            SlotItem& Item = *ItemP;
+            SlotItem Item;
 
             // Position (XZ)
             float rx = (float(x) / float(d_size)) * dm_slot_size + D.vis.box.vMin.x;
@@ -274,7 +309,7 @@ gray255[3]						=	255.f*float(c_pal->a3)/15.f;
                 Item.vis_ID = 0;
             else
             {
-                if (::Random.randI(0, 3) == 0)
+                if (r_wave.randI(0, 3) == 0)
                     Item.vis_ID = 2; // Second wave
                 else
                     Item.vis_ID = 1; // First wave
@@ -284,7 +319,7 @@ gray255[3]						=	255.f*float(c_pal->a3)/15.f;
             Item.vis_ID = 0;
 #endif
             // Save it
-            D.G[index].items.push_back(ItemP);
+            task.items[index].push_back(Item);
         }
     }
 
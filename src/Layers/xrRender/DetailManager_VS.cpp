@@ -190,7 +190,7 @@ void CDetailManager::hw_Render_dump(ref_constant x_array, u32 var_id, u32 lod_id
     u32 vOffset = 0;
     u32 iOffset = 0;
 
-    vis_list& list = m_visibles[var_id];
+    vis_list& list = m_visibles[m_render_buffer][var_id];
 
     Fvector c_sun, c_ambient, c_hemi;
 #ifndef _EDITOR
@@ -236,7 +236,7 @@ void CDetailManager::hw_Render_dump(ref_constant x_array, u32 var_id, u32 lod_id
                     u32 base = dwBatch * 4;
 
                     // Build matrix ( 3x4 matrix, last row - color )
-                    float scale = Instance.scale_calculated;
+                    float scale = Instance.scale_calculated[m_render_buffer];
                     Fmatrix& M = Instance.mRotY;
                     c_storage[base + 0].set(M._11 * scale, M._21 * scale, M._31 * scale, M._41);
                     c_storage[base + 1].set(M._12 * scale, M._22 * scale, M._32 * scale, M._42);
@@ -8,11 +8,22 @@
 
 #include "HOM.h"
 #include "occRasterizer.h"
+#include "xrRender_console.h"
 #include "xrEngine/GameFont.h"
 #include "xrEngine/PerformanceAlert.hpp"
 
+#if defined(XR_ARCHITECTURE_X86) || defined(XR_ARCHITECTURE_X64) || defined(XR_ARCHITECTURE_E2K)
+#include <xmmintrin.h>
+#elif defined(XR_ARCHITECTURE_ARM) || defined(XR_ARCHITECTURE_ARM64)
+#include "sse2neon/sse2neon.h"
+#else
+#error Add your platform here
+#endif
+
 float psOSSR = .001f;
 
+constexpr u32 HOM_RECORD_VERSION = 1;
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -20,8 +31,13 @@ float psOSSR = .001f;
 CHOM::CHOM() : xrc("HOM")
 {
     bEnabled = FALSE;
+    bTiled = false;
     m_pModel = nullptr;
     m_pTris = nullptr;
+    m_record_state = RECORD_NONE;
+    m_record_name[0] = 0;
+    m_bench_name[0] = 0;
+    m_bench_iterations = 0;
 #ifdef DEBUG
     Device.seqRender.Add(this, REG_PRIORITY_LOW - 1000);
 #endif
@@ -169,23 +185,26 @@ public:
     }
 };
 
-void CHOM::Render_DB(CFrustum& base)
+// Maps clip space to [0..width]x[0..height]
+static Fmatrix hom_viewport(float width, float height)
 {
-    // Update projection matrices on every frame to ensure valid HOM culling
-    float view_dim = occ_dim_0;
 #if defined(USE_DX9) || defined(USE_DX11)
-    Fmatrix m_viewport = {view_dim / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, view_dim / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        view_dim / 2.f + 0 + 0, view_dim / 2.f + 0 + 0, 0.0f, 1.0f};
-    Fmatrix m_viewport_01 = {1.f / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, 1.f / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        1.f / 2.f + 0 + 0, 1.f / 2.f + 0 + 0, 0.0f, 1.0f};
+    return {width / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, height / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        width / 2.f + 0 + 0, height / 2.f + 0 + 0, 0.0f, 1.0f};
 #elif defined(USE_OGL)
-    Fmatrix m_viewport = {view_dim / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, -view_dim / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        view_dim / 2.f + 0 + 0, view_dim / 2.f + 0 + 0, 0.0f, 1.0f};
-    Fmatrix m_viewport_01 = {1.f / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, -1.f / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        1.f / 2.f + 0 + 0, 1.f / 2.f + 0 + 0, 0.0f, 1.0f};
+    return {width / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, -height / 2.f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        width / 2.f + 0 + 0, height / 2.f + 0 + 0, 0.0f, 1.0f};
 #else
 #   error No graphics API selected or enabled!
 #endif
+}
+
+void CHOM::Render_DB(CFrustum& base)
+{
+    // Update projection matrices on every frame to ensure valid HOM culling
+    const Fmatrix m_viewport = bTiled ? hom_viewport(float(occ_tiled_width), float(occ_tiled_height)) :
+                                        hom_viewport(float(occ_dim_0), float(occ_dim_0));
+    const Fmatrix m_viewport_01 = hom_viewport(1.f, 1.f);
     m_xform.mul(m_viewport, Device.mFullTransform);
     m_xform_01.mul(m_viewport_01, Device.mFullTransform);
 
@@ -210,6 +229,7 @@ void CHOM::Render_DB(CFrustum& base)
     u32 _frame = Device.dwFrame;
     stats.FrustumTriangleCount = xrc.r_count();
     stats.VisibleTriangleCount = 0;
+    const bool record = m_record_state == RECORD_REQUESTED;
 
     // Perfrom selection, sorting, culling
     for (auto &it : *xrc.r_get())
@@ -249,7 +269,18 @@ void CHOM::Render_DB(CFrustum& base)
             m_xform.transform(T.raster[0], (*P)[0]);
             m_xform.transform(T.raster[1], (*P)[v2 + 0]);
             m_xform.transform(T.raster[2], (*P)[v2 + 1]);
-            pixels += Raster.rasterize(&T);
+            if (bTiled)
+                pixels += m_tiled.submit(&T, T.raster[0], T.raster[1], T.raster[2]) ? 1 : 0;
+            else
+                pixels += Raster.rasterize(&T);
+
+            if (record)
+            {
+                m_record_ids.push_back(it.id);
+                m_record_tris.push_back((*P)[0]);
+                m_record_tris.push_back((*P)[v2 + 0]);
+                m_record_tris.push_back((*P)[v2 + 1]);
+            }
         }
         if (0 == pixels)
         {
@@ -257,6 +288,22 @@ void CHOM::Render_DB(CFrustum& base)
             continue;
         }
     }
+
+    if (!bTiled)
+        return;
+
+    // Tiles are rasterized once everything is binned, occluders which were hidden are skipped the same way
+    m_tiled.rasterize();
+    stats.TiledTriangleCount = m_tiled.get_triangles_count();
+    for (u32 id = 0, count = m_tiled.get_triangles_count(); id < count;)
+    {
+        occTri* T = m_tiled.get_owner(id);
+        bool written = false;
+        for (; id < count && m_tiled.get_owner(id) == T; ++id)
+            written |= m_tiled.is_written(id);
+        if (!written)
+            T->skip = _frame + ::Random.randI(3, 10);
+    }
 }
 
 void CHOM::Render(CFrustum& base)
@@ -264,11 +311,35 @@ void CHOM::Render(CFrustum& base)
     if (!bEnabled)
         return;
 
+    if (m_bench_name[0])
+    {
+        bench();
+        m_bench_name[0] = 0;
+    }
+    if (m_record_state == RECORD_QUERIES)
+        record_save();
+    if (m_record_state == RECORD_REQUESTED)
+    {
+        m_record_ids.clear();
+        m_record_tris.clear();
+    }
+
     stats.Total.Begin();
-    Raster.clear();
+    bTiled = ps_r__common_flags.test(RFLAG_HOM_TILED);
+    if (bTiled)
+        m_tiled.clear();
+    else
+        Raster.clear();
     Render_DB(base);
-    Raster.propagade();
+    if (!bTiled)
+        Raster.propagade();
     stats.Total.End();
+
+    if (m_record_state == RECORD_REQUESTED)
+    {
+        m_record_transform = Device.mFullTransform;
+        m_record_state = RECORD_QUERIES;
+    }
 }
 
 void xr_stdcall CHOM::MT_RENDER(Task& /*thisTask*/, void* /*data*/)
@@ -313,28 +384,79 @@ ICF BOOL xform_b1(Fvector2& min, Fvector2& max, float& minz, const Fmatrix& X, f
     return FALSE;
 }
 
-IC BOOL _visible(const Fbox& B, const Fmatrix& m_xform_01)
+ICF float hmin(__m128 r)
+{
+    r = _mm_min_ps(r, _mm_movehl_ps(r, r));
+    return _mm_cvtss_f32(_mm_min_ss(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+ICF float hmax(__m128 r)
+{
+    r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+    return _mm_cvtss_f32(_mm_max_ss(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+// Projects 8 corners of the box, 4 at a time.
+// Returns FALSE if any of them is in front of the near plane, the box is visible then.
+ICF BOOL xform_box(Fvector2& min, Fvector2& max, float& minz, const Fmatrix& X, const Fbox3& B)
+{
+    const __m128 xs = _mm_setr_ps(B.vMin.x, B.vMax.x, B.vMin.x, B.vMax.x);
+    const __m128 ys = _mm_setr_ps(B.vMin.y, B.vMin.y, B.vMax.y, B.vMax.y);
+    const auto row = [&](const __m128 zs, float m1, float m2, float m3, float m4)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, _mm_set1_ps(m1)), _mm_mul_ps(ys, _mm_set1_ps(m2))),
+            _mm_add_ps(_mm_mul_ps(zs, _mm_set1_ps(m3)), _mm_set1_ps(m4)));
+    };
+
+    __m128 min_x{}, max_x{}, min_y{}, max_y{}, min_z{};
+    for (int i = 0; i < 2; ++i)
+    {
+        const __m128 zs = _mm_set1_ps(i ? B.vMax.z : B.vMin.z);
+        const __m128 z = row(zs, X._13, X._23, X._33, X._43);
+        if (_mm_movemask_ps(_mm_cmplt_ps(z, _mm_set1_ps(EPS))))
+            return FALSE;
+
+        const __m128 iw = _mm_div_ps(_mm_set1_ps(1.f), row(zs, X._14, X._24, X._34, X._44));
+        const __m128 px = _mm_mul_ps(row(zs, X._11, X._21, X._31, X._41), iw);
+        const __m128 py = _mm_mul_ps(row(zs, X._12, X._22, X._32, X._42), iw);
+        const __m128 pz = _mm_mul_ps(z, iw);
+        if (i == 0)
+        {
+            min_x = max_x = px;
+            min_y = max_y = py;
+            min_z = pz;
+        }
+        else
+        {
+            min_x = _mm_min_ps(min_x, px);
+            max_x = _mm_max_ps(max_x, px);
+            min_y = _mm_min_ps(min_y, py);
+            max_y = _mm_max_ps(max_y, py);
+            min_z = _mm_min_ps(min_z, pz);
+        }
+    }
+
+    min.set(hmin(min_x), hmin(min_y));
+    max.set(hmax(max_x), hmax(max_y));
+    minz = hmin(min_z);
+    return TRUE;
+}
+
+BOOL CHOM::test(float x0, float y0, float x1, float y1, float z) const
+{
+    if (bTiled)
+        return m_tiled.test(x0, y0, x1, y1, z);
+    return Raster.test(x0, y0, x1, y1, z);
+}
+
+BOOL CHOM::test(const Fbox3& B) const
 {
     // Find min/max points of xformed-box
     Fvector2 min, max;
     float z;
-    if (xform_b0(min, max, z, m_xform_01, B.vMin.x, B.vMin.y, B.vMin.z))
-        return TRUE;
-    if (xform_b1(min, max, z, m_xform_01, B.vMin.x, B.vMin.y, B.vMax.z))
-        return TRUE;
-    if (xform_b1(min, max, z, m_xform_01, B.vMax.x, B.vMin.y, B.vMax.z))
-        return TRUE;
-    if (xform_b1(min, max, z, m_xform_01, B.vMax.x, B.vMin.y, B.vMin.z))
-        return TRUE;
-    if (xform_b1(min, max, z, m_xform_01, B.vMin.x, B.vMax.y, B.vMin.z))
-        return TRUE;
-    if (xform_b1(min, max, z, m_xform_01, B.vMin.x, B.vMax.y, B.vMax.z))
+    if (!xform_box(min, max, z, m_xform_01, B))
         return TRUE;
-    if (xform_b1(min, max, z, m_xform_01, B.vMax.x, B.vMax.y, B.vMax.z))
-        return TRUE;
-    if (xform_b1(min, max, z, m_xform_01, B.vMax.x, B.vMax.y, B.vMin.z))
-        return TRUE;
-    return Raster.test(min.x, min.y, max.x, max.y, z);
+    return test(min.x, min.y, max.x, max.y, z);
 }
 
 BOOL CHOM::visible(const Fbox3& B) const
@@ -343,14 +465,16 @@ BOOL CHOM::visible(const Fbox3& B) const
         return TRUE;
     if (B.contains(Device.vCameraPosition))
         return TRUE;
-    return _visible(B, m_xform_01);
+    if (m_record_state == RECORD_QUERIES)
+        record_query(B);
+    return test(B);
 }
 
 BOOL CHOM::visible(const Fbox2& B, float depth) const
 {
     if (!bEnabled)
         return TRUE;
-    return Raster.test(B.min.x, B.min.y, B.max.x, B.max.y, depth);
+    return test(B.min.x, B.min.y, B.max.x, B.max.y, depth);
 }
 
 BOOL CHOM::visible(vis_data& vis) const
@@ -370,7 +494,9 @@ BOOL CHOM::visible(vis_data& vis) const
     const u32 frame_current = Device.dwFrame;
     // u32	frame_prev		= frame_current-1;
 
-    const BOOL result = _visible(vis.box, m_xform_01);
+    if (m_record_state == RECORD_QUERIES)
+        record_query(vis.box);
+    const BOOL result = test(vis.box);
     u32 delay = 1;
     if (result)
     {
@@ -400,7 +526,7 @@ BOOL CHOM::visible(const sPoly& P) const
     for (u32 it = 1; it < P.size(); it++)
         if (xform_b1(min, max, z, m_xform_01, P[it].x, P[it].y, P[it].z))
             return TRUE;
-    return Raster.test(min.x, min.y, max.x, max.y, z);
+    return test(min.x, min.y, max.x, max.y, z);
 }
 
 void CHOM::Disable() { bEnabled = FALSE; }
@@ -411,11 +537,182 @@ void CHOM::DumpStatistics(IGameFont& font, IPerformanceAlert* alert)
     font.OutNext("HOM:          %2.2fms, %u", stats.Total.result, stats.Total.count);
     font.OutNext("- visible:    %u", stats.VisibleTriangleCount);
     font.OutNext("- frustum:    %u", stats.FrustumTriangleCount);
+    if (bTiled)
+        font.OutNext("- tiled:      %u", stats.TiledTriangleCount);
     font.OutNext("- total:      %d", m_pModel ? m_pModel->get_tris_count() : 0);
     stats.FrameStart();
     xrc.DumpStatistics(font, alert);
 }
 
+void CHOM::Record(pcstr name)
+{
+    if (m_record_state != RECORD_NONE)
+        return;
+    xr_strcpy(m_record_name, name);
+    m_record_state = RECORD_REQUESTED;
+}
+
+void CHOM::Bench(pcstr name, u32 iterations)
+{
+    m_bench_iterations = std::max(iterations, 1u);
+    xr_strcpy(m_bench_name, name);
+}
+
+void CHOM::record_query(const Fbox3& B) const
+{
+    ScopeLock lock(&m_record_lock);
+    m_record_queries.push_back(B);
+}
+
+void CHOM::record_save()
+{
+    IWriter* W = FS.w_open("$logs$", m_record_name);
+    if (W)
+    {
+        ScopeLock lock(&m_record_lock);
+        W->w_u32(HOM_RECORD_VERSION);
+        W->w_u32(u32(m_pModel->get_tris_count()));
+        W->w(&m_record_transform, sizeof(Fmatrix));
+        W->w_u32(u32(m_record_ids.size()));
+        W->w(m_record_ids.data(), m_record_ids.size() * sizeof(u32));
+        W->w(m_record_tris.data(), m_record_tris.size() * sizeof(Fvector));
+        W->w_u32(u32(m_record_queries.size()));
+        W->w(m_record_queries.data(), m_record_queries.size() * sizeof(Fbox3));
+        FS.w_close(W);
+        Msg("* HOM record '%s': %u occluder triangles, %u queries", m_record_name, u32(m_record_ids.size()),
+            u32(m_record_queries.size()));
+    }
+    else
+        Msg("! Can't write HOM record '%s'", m_record_name);
+
+    {
+        ScopeLock lock(&m_record_lock);
+        m_record_queries.clear();
+    }
+    m_record_ids.clear();
+    m_record_tris.clear();
+    m_record_state = RECORD_NONE;
+}
+
+// Replays the recorded frame through both rasterizers, runs in the HOM task before the frame is rendered
+void CHOM::bench()
+{
+    string_path file_name;
+    FS.update_path(file_name, "$logs$", m_bench_name);
+    IReader* F = FS.r_open(file_name);
+    if (!F)
+    {
+        Msg("! Can't open HOM record '%s'", file_name);
+        return;
+    }
+
+    if (F->r_u32() != HOM_RECORD_VERSION || F->r_u32() != u32(m_pModel->get_tris_count()))
+    {
+        // Legacy rasterizer needs adjacency of the occluders
+        Msg("! HOM record '%s' is outdated or was made on another level", file_name);
+        FS.r_close(F);
+        return;
+    }
+
+    Fmatrix transform;
+    F->r(&transform, sizeof(Fmatrix));
+    xr_vector<u32> ids(F->r_u32());
+    F->r(ids.data(), ids.size() * sizeof(u32));
+    xr_vector<Fvector> tris(ids.size() * 3);
+    F->r(tris.data(), tris.size() * sizeof(Fvector));
+    xr_vector<Fbox3> queries(F->r_u32());
+    F->r(queries.data(), queries.size() * sizeof(Fbox3));
+    FS.r_close(F);
+
+    Fmatrix xform_legacy, xform_tiled, xform_01;
+    xform_legacy.mul(hom_viewport(float(occ_dim_0), float(occ_dim_0)), transform);
+    xform_tiled.mul(hom_viewport(float(occ_tiled_width), float(occ_tiled_height)), transform);
+    xform_01.mul(hom_viewport(1.f, 1.f), transform);
+
+    const auto run_queries = [&](xr_vector<u8>& culled, const auto& test)
+    {
+        u32 count = 0;
+        culled.resize(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            Fvector2 min, max;
+            float z;
+            culled[i] = xform_box(min, max, z, xform_01, queries[i]) && !test(min.x, min.y, max.x, max.y, z);
+            count += culled[i];
+        }
+        return count;
+    };
+
+    CTimer timer;
+    const u32 iterations = m_bench_iterations;
+    float legacy_raster = 0.f, legacy_queries = 0.f, tiled_raster = 0.f, tiled_queries = 0.f;
+    xr_vector<u8> legacy_culled, tiled_culled;
+    u32 legacy_count = 0, tiled_count = 0;
+
+    for (u32 it = 0; it < iterations; ++it)
+    {
+        timer.Start();
+        Raster.clear();
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            occTri& T = m_pTris[ids[i]];
+            xform_legacy.transform(T.raster[0], tris[i * 3 + 0]);
+            xform_legacy.transform(T.raster[1], tris[i * 3 + 1]);
+            xform_legacy.transform(T.raster[2], tris[i * 3 + 2]);
+            Raster.rasterize(&T);
+        }
+        Raster.propagade();
+        legacy_raster += timer.GetElapsed_sec();
+
+        timer.Start();
+        legacy_count = run_queries(legacy_culled, [](float x0, float y0, float x1, float y1, float z)
+        {
+            return Raster.test(x0, y0, x1, y1, z);
+        });
+        legacy_queries += timer.GetElapsed_sec();
+    }
+
+    for (u32 it = 0; it < iterations; ++it)
+    {
+        timer.Start();
+        m_tiled.clear();
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            Fvector v[3];
+            xform_tiled.transform(v[0], tris[i * 3 + 0]);
+            xform_tiled.transform(v[1], tris[i * 3 + 1]);
+            xform_tiled.transform(v[2], tris[i * 3 + 2]);
+            m_tiled.submit(m_pTris + ids[i], v[0], v[1], v[2]);
+        }
+        m_tiled.rasterize();
+        tiled_raster += timer.GetElapsed_sec();
+
+        timer.Start();
+        tiled_count = run_queries(tiled_culled, [this](float x0, float y0, float x1, float y1, float z)
+        {
+            return m_tiled.test(x0, y0, x1, y1, z);
+        });
+        tiled_queries += timer.GetElapsed_sec();
+    }
+
+    u32 only_legacy = 0, only_tiled = 0;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        only_legacy += legacy_culled[i] && !tiled_culled[i];
+        only_tiled += tiled_culled[i] && !legacy_culled[i];
+    }
+
+    const float to_ms = 1000.f / float(iterations);
+    const float to_percent = queries.empty() ? 0.f : 100.f / float(queries.size());
+    Msg("* HOM bench '%s': %u occluder triangles, %u queries, %u iterations", m_bench_name, u32(ids.size()),
+        u32(queries.size()), iterations);
+    Msg("* legacy %dx%d: raster %2.3fms, queries %2.3fms, culled %2.1f%%", occ_dim_0, occ_dim_0,
+        legacy_raster * to_ms, legacy_queries * to_ms, legacy_count * to_percent);
+    Msg("* tiled %dx%d: raster %2.3fms, queries %2.3fms, culled %2.1f%%", occ_tiled_width, occ_tiled_height,
+        tiled_raster * to_ms, tiled_queries * to_ms, tiled_count * to_percent);
+    Msg("* culled only by legacy: %u, only by tiled: %u", only_legacy, only_tiled);
+}
+
 #ifdef DEBUG
 void CHOM::OnRender()
 {
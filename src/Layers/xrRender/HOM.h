@@ -6,6 +6,8 @@
 #include "xrEngine/IGame_Persistent.h"
 #include "xrEngine/Render.h"
 
+#include "occRasterizer_tiled.h"
+
 class occTri;
 
 class CHOM
@@ -20,6 +22,7 @@ private:
         Lock TotalTimerLock;
         u32 FrustumTriangleCount;
         u32 VisibleTriangleCount;
+        u32 TiledTriangleCount;
 
         HOMStatistics() { FrameStart(); }
         void FrameStart()
@@ -27,6 +30,7 @@ private:
             Total.FrameStart();
             FrustumTriangleCount = 0;
             VisibleTriangleCount = 0;
+            TiledTriangleCount = 0;
         }
 
         void FrameEnd() { Total.FrameEnd(); }
@@ -39,9 +43,34 @@ private:
     Fmatrix m_xform;
     Fmatrix m_xform_01;
 
+    occTiledRasterizer m_tiled;
+    bool bTiled; // latched for the frame, tests must go to the buffer which was rendered
+
+    // Occluders and queries of one frame can be recorded and replayed by r__hom_bench
+    enum
+    {
+        RECORD_NONE,
+        RECORD_REQUESTED,
+        RECORD_QUERIES,
+    };
+    u32 m_record_state;
+    string_path m_record_name;
+    Fmatrix m_record_transform;
+    xr_vector<u32> m_record_ids;
+    xr_vector<Fvector> m_record_tris;
+    mutable xr_vector<Fbox3> m_record_queries;
+    mutable Lock m_record_lock;
+    string_path m_bench_name;
+    u32 m_bench_iterations;
+
     mutable HOMStatistics stats;
 
     void Render_DB(CFrustum& base);
+    BOOL test(float x0, float y0, float x1, float y1, float z) const;
+    BOOL test(const Fbox3& B) const;
+    void record_query(const Fbox3& B) const;
+    void record_save();
+    void bench();
 
 public:
     void Load();
@@ -61,6 +90,9 @@ public:
     BOOL visible(const sPoly& P) const;
     BOOL visible(const Fbox2& B, float depth) const; // viewport-space (0..1)
 
+    void Record(pcstr name);
+    void Bench(pcstr name, u32 iterations);
+
     CHOM();
     ~CHOM();
 
@@ -212,6 +212,8 @@ dxRender_Visual* CModelPool::Instance_Find(LPCSTR N)
 
 dxRender_Visual* CModelPool::Create(const char* name, IReader* data)
 {
+    MemoryTagScope scope(MemoryTag::Models);
+
 #ifdef _EDITOR
     if (!name || !name[0])
         return 0;
@@ -395,6 +397,22 @@ void CModelPool::Prefetch()
     string256 section;
     strconcat(sizeof(section), section, "prefetch_visuals_", g_pGamePersistent->m_game_params.m_game_type);
     const CInifile::Sect& sect = pSettings->r_section(section);
+
+    // Read all of them in parallel, Create() picks the data up from the OS and decompressed caches
+    xr_vector<xr_string> names;
+    names.reserve(sect.Data.size());
+    for (const CInifile::Item& item : sect.Data)
+    {
+        xr_string& name = names.emplace_back(item.first.c_str());
+        if (!strext(name.c_str()))
+            name += ".ogf";
+    }
+    xr_vector<pcstr> files;
+    files.reserve(names.size());
+    for (const xr_string& name : names)
+        files.push_back(name.c_str());
+    const auto prefetch = FS.r_open_async("$game_meshes$", files);
+
     for (auto I = sect.Data.cbegin(); I != sect.Data.cend(); ++I)
     {
         const CInifile::Item& item = *I;
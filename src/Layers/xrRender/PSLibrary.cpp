@@ -27,10 +27,17 @@ void CPSLibrary::OnCreate()
         FS.update_path(fn, _game_data_, "particles.xr");
         Load(fn);
     }
+#ifndef _EDITOR
+    PS::ParticleEffectsBatch.OnCreate();
+#endif
 }
 
 void CPSLibrary::OnDestroy()
 {
+#ifndef _EDITOR
+    PS::ParticleEffectsBatch.OnDestroy();
+#endif
+
     for (PS::PEDIt e_it = m_PEDs.begin(); e_it != m_PEDs.end(); ++e_it)
         (*e_it)->DestroyShader();
 
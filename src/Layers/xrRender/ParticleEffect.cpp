@@ -76,8 +76,9 @@ void PS::OnEffectParticleBirth(void* owner, u32, PAPI::Particle& m, u32)
     if (PED)
     {
         if (PED->m_Flags.is(CPEDef::dfRandomFrame))
-            m.frame = (u16)iFloor(Random.randI(PED->m_Frame.m_iFrameCount) * 255.f);
-        if (PED->m_Flags.is(CPEDef::dfAnimated) && PED->m_Flags.is(CPEDef::dfRandomPlayback) && Random.randI(2))
+            m.frame = (u16)iFloor(PAPI::random().randI(PED->m_Frame.m_iFrameCount) * 255.f);
+        if (PED->m_Flags.is(CPEDef::dfAnimated) && PED->m_Flags.is(CPEDef::dfRandomPlayback) &&
+            PAPI::random().randI(2))
             m.flags.set(Particle::ANIMATE_CCW, TRUE);
     }
 }
@@ -98,6 +99,7 @@ CParticleEffect::CParticleEffect()
     m_Def = nullptr;
     m_fElapsedLimit = 0.f;
     m_MemDT = 0;
+    m_PendingSteps = 0;
     m_InitialPosition.set(0, 0, 0);
     m_DestroyCallback = nullptr;
     m_CollisionCallback = nullptr;
@@ -106,6 +108,10 @@ CParticleEffect::CParticleEffect()
 CParticleEffect::~CParticleEffect()
 {
     // Log					("--- destroy PE");
+#ifndef _EDITOR
+    if (m_PendingSteps)
+        ParticleEffectsBatch.Remove(this);
+#endif
     OnDeviceDestroy();
     ParticleManager()->DestroyEffect(m_HandleEffect);
     ParticleManager()->DestroyActionList(m_HandleActionList);
@@ -149,80 +155,212 @@ void CParticleEffect::UpdateParent(const Fmatrix& m, const Fvector& velocity, BO
 
 void CParticleEffect::OnFrame(u32 frame_dt)
 {
-    if (m_Def && m_RT_Flags.is(flRT_Playing))
+#ifndef _EDITOR
+    // Collision calls back into the game, such effects are always updated in place
+    if (m_Def && m_RT_Flags.is(flRT_Playing) && !m_Def->m_Flags.is(CPEDef::dfCollision))
     {
-        m_MemDT += frame_dt;
+        const s32 StepCount = TakeSteps(frame_dt);
+        if (!StepCount)
+            return;
 
-        int StepCount = 0;
-        if (m_MemDT >= uDT_STEP)
+        if (m_PendingSteps || ParticleEffectsBatch.Add(this))
         {
-            // allow maximum of three steps (99ms) to avoid slowdown after loading
-            // it will really skip updates at less than 10fps, which is unplayable
-            StepCount = m_MemDT / uDT_STEP;
-            m_MemDT = m_MemDT % uDT_STEP;
-            clamp(StepCount, 0, 3);
+            m_PendingSteps = std::min(m_PendingSteps + StepCount, 3);
+            return;
         }
 
-        for (; StepCount; StepCount--)
+        auto& stats = RImplementation.BasicStats;
+        stats.Particles.Begin();
+        UpdateSteps(StepCount);
+        stats.ParticlesCount += ParticlesCount();
+        stats.Particles.End();
+        return;
+    }
+#endif
+    OnFrameImmediate(frame_dt);
+}
+
+void CParticleEffect::OnFrameImmediate(u32 frame_dt)
+{
+    if (m_Def && m_RT_Flags.is(flRT_Playing))
+        UpdateSteps(TakeSteps(frame_dt));
+    else
+        SetInitialBounds();
+}
+
+s32 CParticleEffect::TakeSteps(u32 frame_dt)
+{
+    m_MemDT += frame_dt;
+
+    s32 StepCount = 0;
+    if (m_MemDT >= uDT_STEP)
+    {
+        // allow maximum of three steps (99ms) to avoid slowdown after loading
+        // it will really skip updates at less than 10fps, which is unplayable
+        StepCount = m_MemDT / uDT_STEP;
+        m_MemDT = m_MemDT % uDT_STEP;
+        clamp(StepCount, 0, 3);
+    }
+    return StepCount;
+}
+
+void CParticleEffect::SetInitialBounds()
+{
+    vis.box.set(m_InitialPosition, m_InitialPosition);
+    vis.box.grow(EPS_L);
+    vis.box.getsphere(vis.sphere.P, vis.sphere.R);
+}
+
+void CParticleEffect::UpdateSteps(s32 StepCount)
+{
+    for (; StepCount; StepCount--)
+    {
+        if (m_Def->m_Flags.is(CPEDef::dfTimeLimit))
         {
-            if (m_Def->m_Flags.is(CPEDef::dfTimeLimit))
+            if (!m_RT_Flags.is(flRT_DefferedStop))
             {
-                if (!m_RT_Flags.is(flRT_DefferedStop))
+                m_fElapsedLimit -= fDT_STEP;
+                if (m_fElapsedLimit < 0.f)
                 {
-                    m_fElapsedLimit -= fDT_STEP;
-                    if (m_fElapsedLimit < 0.f)
-                    {
-                        m_fElapsedLimit = m_Def->m_fTimeLimit;
-                        Stop(true);
-                        break;
-                    }
+                    m_fElapsedLimit = m_Def->m_fTimeLimit;
+                    Stop(true);
+                    break;
                 }
             }
-            ParticleManager()->Update(m_HandleEffect, m_HandleActionList, fDT_STEP);
+        }
+        ParticleManager()->Update(m_HandleEffect, m_HandleActionList, fDT_STEP);
 
-            PAPI::Particle* particles;
-            u32 p_cnt;
-            ParticleManager()->GetParticles(m_HandleEffect, particles, p_cnt);
+        PAPI::Particle* particles;
+        u32 p_cnt;
+        ParticleManager()->GetParticles(m_HandleEffect, particles, p_cnt);
 
-            // our actions
-            if (m_Def->m_Flags.is(CPEDef::dfFramed | CPEDef::dfAnimated))
-                m_Def->ExecuteAnimate(particles, p_cnt, fDT_STEP);
-            if (m_Def->m_Flags.is(CPEDef::dfCollision))
-                m_Def->ExecuteCollision(particles, p_cnt, fDT_STEP, this, m_CollisionCallback);
+        // our actions
+        if (m_Def->m_Flags.is(CPEDef::dfFramed | CPEDef::dfAnimated))
+            m_Def->ExecuteAnimate(particles, p_cnt, fDT_STEP);
+        if (m_Def->m_Flags.is(CPEDef::dfCollision))
+            m_Def->ExecuteCollision(particles, p_cnt, fDT_STEP, this, m_CollisionCallback);
 
-            //-move action
-            if (p_cnt)
-            {
-                vis.box.invalidate();
-                float p_size = 0.f;
-                for (u32 i = 0; i < p_cnt; i++)
-                {
-                    Particle& m = particles[i];
-                    vis.box.modify((Fvector&)m.pos);
-                    if (m.size.x > p_size)
-                        p_size = m.size.x;
-                    if (m.size.y > p_size)
-                        p_size = m.size.y;
-                    if (m.size.z > p_size)
-                        p_size = m.size.z;
-                }
-                vis.box.grow(p_size);
-                vis.box.getsphere(vis.sphere.P, vis.sphere.R);
-            }
-            if (m_RT_Flags.is(flRT_DefferedStop) && (0 == p_cnt))
+        //-move action
+        if (p_cnt)
+        {
+            vis.box.invalidate();
+            float p_size = 0.f;
+            for (u32 i = 0; i < p_cnt; i++)
             {
-                m_RT_Flags.set(flRT_Playing | flRT_DefferedStop, FALSE);
-                break;
+                Particle& m = particles[i];
+                vis.box.modify((Fvector&)m.pos);
+                if (m.size.x > p_size)
+                    p_size = m.size.x;
+                if (m.size.y > p_size)
+                    p_size = m.size.y;
+                if (m.size.z > p_size)
+                    p_size = m.size.z;
             }
+            vis.box.grow(p_size);
+            vis.box.getsphere(vis.sphere.P, vis.sphere.R);
+        }
+        if (m_RT_Flags.is(flRT_DefferedStop) && (0 == p_cnt))
+        {
+            m_RT_Flags.set(flRT_Playing | flRT_DefferedStop, FALSE);
+            break;
         }
     }
-    else
+}
+
+#ifndef _EDITOR
+CParticleEffectsBatch PS::ParticleEffectsBatch;
+
+void CParticleEffectsBatch::OnCreate() { Device.seqFrame.Add(this, REG_PRIORITY_LOW); }
+
+void CParticleEffectsBatch::OnDestroy()
+{
+    Device.seqFrame.Remove(this);
+    for (CParticleEffect* effect : m_Effects)
+        effect->m_PendingSteps = 0;
+    m_Effects.clear();
+}
+
+bool CParticleEffectsBatch::Add(CParticleEffect* effect)
+{
+    // Batch is already executed for this frame, the effect is about to be rendered
+    if (m_FlushedFrame == Device.dwFrame || !ps_r__common_flags.test(RFLAG_MT_PARTICLES))
+        return false;
+    m_Effects.push_back(effect);
+    return true;
+}
+
+void CParticleEffectsBatch::Remove(CParticleEffect* effect)
+{
+    const auto it = std::find(m_Effects.begin(), m_Effects.end(), effect);
+    VERIFY(it != m_Effects.end());
+    m_Effects.erase(it);
+    effect->m_PendingSteps = 0;
+}
+
+void CParticleEffectsBatch::OnFrame()
+{
+    m_FlushedFrame = Device.dwFrame;
+    if (m_Effects.empty())
+        return;
+
+    auto& stats = RImplementation.BasicStats;
+    stats.Particles.Begin();
+
+    // Split effects into batches with roughly the same amount of work.
+    // Effects which have just started have no particles yet, but will spawn them now.
+    constexpr u32 batch_particles = 4096;
+    constexpr u32 min_effect_particles = 64;
+    m_Batches.clear();
+    size_t begin = 0;
+    u32 particles = 0;
+    for (size_t i = 0; i < m_Effects.size(); ++i)
     {
-        vis.box.set(m_InitialPosition, m_InitialPosition);
-        vis.box.grow(EPS_L);
-        vis.box.getsphere(vis.sphere.P, vis.sphere.R);
+        CParticleEffect* effect = m_Effects[i];
+        particles += std::max(effect->ParticlesCount(), min_effect_particles) * effect->m_PendingSteps;
+        if (particles >= batch_particles)
+        {
+            m_Batches.emplace_back(begin, i + 1);
+            begin = i + 1;
+            particles = 0;
+        }
     }
+    if (begin < m_Effects.size())
+        m_Batches.emplace_back(begin, m_Effects.size());
+
+    // Effects only touch their own particles and action lists,
+    // random numbers come from the generator of the action list.
+    const auto update = [this](const std::pair<size_t, size_t>& batch)
+    {
+        for (size_t i = batch.first; i != batch.second; ++i)
+        {
+            CParticleEffect* effect = m_Effects[i];
+            const s32 steps = effect->m_PendingSteps;
+            effect->m_PendingSteps = 0;
+            if (effect->m_Def && effect->IsPlaying())
+                effect->UpdateSteps(steps);
+            else
+                effect->SetInitialBounds();
+        }
+    };
+
+    if (m_Batches.size() > 1)
+    {
+        xr_parallel_for(TaskRange<size_t>(0, m_Batches.size(), 1), [&](const TaskRange<size_t>& range)
+        {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+                update(m_Batches[i]);
+        });
+    }
+    else
+        update(m_Batches.front());
+
+    for (CParticleEffect* effect : m_Effects)
+        stats.ParticlesCount += effect->ParticlesCount();
+    m_Effects.clear();
+
+    stats.Particles.End();
 }
+#endif // _EDITOR
 
 BOOL CParticleEffect::Compile(CPEDef* def)
 {
@@ -350,14 +488,10 @@ IC void FillSprite_fpu(FVF::LIT*& pv, const Fvector& pos, const Fvector& dir, co
 
 #ifndef _EDITOR
 //----------------------------------------------------
-Lock m_sprite_section;
-
 #if defined(XR_ARCHITECTURE_X86) || defined(XR_ARCHITECTURE_X64) || defined(XR_ARCHITECTURE_E2K)
 IC void FillSprite(FVF::LIT*& pv, const Fvector& T, const Fvector& R, const Fvector& pos, const Fvector2& lt,
     const Fvector2& rb, float r1, float r2, u32 clr, float sina, float cosa)
 {
-    m_sprite_section.Enter();
-
     __m128 Vr, Vt, _T, _R, _pos, _zz, _sa, _ca, a, b, c, d;
 
     _sa = _mm_set1_ps(sina);
@@ -410,7 +544,6 @@ IC void FillSprite(FVF::LIT*& pv, const Fvector& T, const Fvector& R, const Fvec
     pv->color = clr;
     pv->t.set(rb.x, lt.y);
     pv++;
-    m_sprite_section.Leave();
 }
 
 IC void FillSprite(FVF::LIT*& pv, const Fvector& pos, const Fvector& dir, const Fvector2& lt, const Fvector2& rb,
@@ -509,15 +642,18 @@ ICF void magnitude_sse(Fvector& vec, float& res)
 #error Specify your platform explicitly
 #endif
 
-void CParticleEffect::ParticleRenderStream(FVF::LIT* pv, u32 count, PAPI::Particle * particles)
+void CParticleEffect::ParticleRenderStream(FVF::LIT* pv_start, u32 count, PAPI::Particle * particles)
 {
-    float sina = 0.0f, cosa = 0.0f;
-    // Xottab_DUTY: changed angle to be float instead of DWORD
-    // But it must be 0xFFFFFFFF or otherwise some particles won't play
-    float angle = float(0xFFFFFFFF); // XXX: check if we can replace with flt_max
-
     const auto renderParticles = [&, this](const TaskRange<u32>& range)
     {
+        // Each range writes its own part of the vertex buffer
+        FVF::LIT* pv = pv_start + range.begin() * 4;
+
+        float sina = 0.0f, cosa = 0.0f;
+        // Xottab_DUTY: changed angle to be float instead of DWORD
+        // But it must be 0xFFFFFFFF or otherwise some particles won't play
+        float angle = float(0xFFFFFFFF); // XXX: check if we can replace with flt_max
+
         for (u32 i = range.begin(); i != range.end(); ++i)
         {
             PAPI::Particle& m = particles[i];
@@ -632,14 +768,13 @@ void CParticleEffect::ParticleRenderStream(FVF::LIT* pv, u32 count, PAPI::Partic
             }
         }
     };
-    // XXX: it turned out that singlethreaded code works way faster
-    // But on processors with small caches it may work slower, profiling needed
-    //if (count > (TaskScheduler->GetWorkersCount() * 64))
-    //    xr_parallel_for(TaskRange<u32>(0, count), renderParticles);
-    //else
-    {
+    // Tasks were too fine-grained before and FillSprite was serialized by a lock,
+    // so only big effects are split and each task gets a decent chunk of particles
+    constexpr u32 fill_grain = 1024;
+    if (count >= fill_grain * 2 && ps_r__common_flags.test(RFLAG_MT_PARTICLES))
+        xr_parallel_for(TaskRange<u32>(0, count, fill_grain), renderParticles);
+    else
         renderParticles(TaskRange<u32>(0, count));
-    }
 }
 
 void CParticleEffect::Render(float)
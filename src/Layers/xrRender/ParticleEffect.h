@@ -23,6 +23,7 @@ protected:
     int m_HandleActionList;
 
     s32 m_MemDT;
+    s32 m_PendingSteps;
 
     Fvector m_InitialPosition;
 
@@ -55,12 +56,20 @@ public:
     virtual ~CParticleEffect();
 
     void OnFrame(u32 dt);
+    // Groups read the state of their effects right after the update, so they can't wait for the batch
+    void OnFrameImmediate(u32 dt);
 
     u32 RenderTO();
     virtual void Render(float LOD);
 
 private:
-    void ParticleRenderStream(FVF::LIT* pv, u32 count, PAPI::Particle* particles);
+    friend class CParticleEffectsBatch;
+
+    s32 TakeSteps(u32 dt);
+    void UpdateSteps(s32 StepCount);
+    void SetInitialBounds();
+
+    void ParticleRenderStream(FVF::LIT* pv_start, u32 count, PAPI::Particle* particles);
 
 public:
     virtual void Copy(dxRender_Visual* pFrom);
@@ -103,6 +112,30 @@ void OnEffectParticleDead(void* owner, u32 param, PAPI::Particle& m, u32 idx);
 
 extern const u32 uDT_STEP;
 extern const float fDT_STEP;
+
+#ifndef _EDITOR
+// Standalone effects played by game objects don't depend on each other,
+// so their updates are gathered during the frame and executed in parallel
+// batches after the game update, right before the frame is rendered.
+class CParticleEffectsBatch : public pureFrame
+{
+    xr_vector<CParticleEffect*> m_Effects;
+    xr_vector<std::pair<size_t, size_t>> m_Batches;
+    u32 m_FlushedFrame = u32(-1);
+
+public:
+    void OnCreate();
+    void OnDestroy();
+
+    // Returns false if the effect has to be updated in place
+    bool Add(CParticleEffect* effect);
+    void Remove(CParticleEffect* effect);
+
+    void OnFrame() override;
+};
+
+extern CParticleEffectsBatch ParticleEffectsBatch;
+#endif
 }
 //---------------------------------------------------------------------------
 #endif
@@ -365,7 +365,7 @@ void CParticleGroup::SItem::OnFrame(u32 u_dt, const CPGDef::SEffect& def, Fbox&
     CParticleEffect* E1 = static_cast<CParticleEffect*>(_effect);
     if (E1)
     {
-        E1->OnFrame(u_dt);
+        E1->OnFrameImmediate(u_dt);
         if (E1->IsPlaying())
         {
             bPlaying = true;
@@ -402,7 +402,7 @@ void CParticleGroup::SItem::OnFrame(u32 u_dt, const CPGDef::SEffect& def, Fbox&
             CParticleEffect* E = static_cast<CParticleEffect*>(*it);
             if (E)
             {
-                E->OnFrame(u_dt);
+                E->OnFrameImmediate(u_dt);
                 if (E->IsPlaying())
                 {
                     bPlaying = true;
@@ -427,7 +427,7 @@ void CParticleGroup::SItem::OnFrame(u32 u_dt, const CPGDef::SEffect& def, Fbox&
             CParticleEffect* E = static_cast<CParticleEffect*>(*it);
             if (E)
             {
-                E->OnFrame(u_dt);
+                E->OnFrameImmediate(u_dt);
                 if (E->IsPlaying())
                 {
                     bPlaying = true;
@@ -527,8 +527,16 @@ void CParticleGroup::OnFrame(u32 u_dt)
         bool bPlaying = false;
         Fbox box;
         box.invalidate();
+#ifndef _EDITOR
+        auto& stats = RImplementation.BasicStats;
+        stats.Particles.Begin();
+#endif
         for (auto i_it = items.begin(); i_it != items.end(); ++i_it)
             i_it->OnFrame(u_dt, *m_Def->m_Effects[i_it - items.begin()], box, bPlaying);
+#ifndef _EDITOR
+        stats.ParticlesCount += ParticlesCount();
+        stats.Particles.End();
+#endif
 
         if (m_RT_Flags.is(flRT_DefferedStop) && !bPlaying)
         {
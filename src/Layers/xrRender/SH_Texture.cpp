@@ -147,6 +147,7 @@ void CTexture::Preload()
 
 void CTexture::Load()
 {
+    MemoryTagScope scope(MemoryTag::Textures);
     flags.bLoaded = true;
     desc_cache = nullptr;
     if (pSurface)
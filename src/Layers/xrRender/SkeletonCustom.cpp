@@ -429,6 +429,7 @@ void CKinematics::CalculateBones_Invalidate()
 {
     UCalc_Time = 0x0;
     UCalc_Visibox = psSkeletonUpdate;
+    UCalc_UpdateBounds = false;
 }
 
 void CKinematics::Spawn()
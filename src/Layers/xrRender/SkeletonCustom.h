@@ -150,6 +150,7 @@ protected:
     BOOL Update_Visibility;
     u32 UCalc_Time;
     s32 UCalc_Visibox;
+    bool UCalc_UpdateBounds; // box/sphere should be recalculated along with bones
 
     Flags64 visimask;
 
@@ -268,6 +269,14 @@ public:
 
     // Main functionality
     void CalculateBones(BOOL bForceExact = FALSE) override; // Recalculate skeleton
+    // CalculateBones split in stages for the batched update before dsgraph build:
+    // Prepare and Finish call game code (animation and update callbacks) and must stay on the main thread,
+    // Evaluate only calculates bone matrices and bounds of this model and may run on a worker thread,
+    // unless the model has bone callbacks: they are game code and read physics and other objects
+    bool CalculateBones_Prepare(BOOL bForceExact);
+    bool CalculateBones_HasCallbacks() const;
+    void CalculateBones_Evaluate();
+    void CalculateBones_Finish();
     void CalculateBones_Invalidate() override;
     void Callback(UpdateCallback C, void* Param) override
     {
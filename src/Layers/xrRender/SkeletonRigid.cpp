@@ -18,104 +18,136 @@ void CKinematics::CalculateBones(BOOL bForceExact)
     if (RDEVICE.dwTimeGlobal == UCalc_Time)
         return; // early out for "fast" update
     UCalc_mtlock lock;
+    if (!CalculateBones_Prepare(bForceExact))
+        return;
+
+// exact computation
+// Calculate bones
+#ifdef DEBUG
+    RImplementation.BasicStats.Animation.Begin();
+#endif
+    CalculateBones_Evaluate();
+#ifdef DEBUG
+    RImplementation.BasicStats.Animation.End();
+#endif
+    CalculateBones_Finish();
+}
+
+bool CKinematics::CalculateBones_Prepare(BOOL bForceExact)
+{
+    if (RDEVICE.dwTimeGlobal == UCalc_Time)
+        return false; // already calculated during this frame
     OnCalculateBones();
     if (!bForceExact && (RDEVICE.dwTimeGlobal < (UCalc_Time + UCalc_Interval)))
-        return; // early out for "slow" update
+        return false; // early out for "slow" update
     if (Update_Visibility)
         Visibility_Update();
 
-    _DBG_SINGLE_USE_MARKER;
     // here we have either:
     //	1:	timeout elapsed
     //	2:	exact computation required
     UCalc_Time = RDEVICE.dwTimeGlobal;
 
-// exact computation
-// Calculate bones
-#ifdef DEBUG
-    RImplementation.BasicStats.Animation.Begin();
-#endif
+    // Calculate BOXes/Spheres if needed
+    UCalc_Visibox++;
+    UCalc_UpdateBounds = UCalc_Visibox >= psSkeletonUpdate;
+    if (UCalc_UpdateBounds)
+    {
+        // mark
+        UCalc_Visibox = -(::Random.randI(psSkeletonUpdate - 1));
+    }
+    return true;
+}
 
+bool CKinematics::CalculateBones_HasCallbacks() const
+{
+    for (u16 i = 0; i < LL_BoneCount(); ++i)
+    {
+        if (bone_instances[i].callback())
+            return true;
+    }
+    return false;
+}
+
+void CKinematics::CalculateBones_Evaluate()
+{
+    _DBG_SINGLE_USE_MARKER;
     Bone_Calculate(bones->at(iRoot), &Fidentity);
 #ifdef DEBUG
     check_kinematics(this, dbg_name.c_str());
-    RImplementation.BasicStats.Animation.End();
 #endif
     VERIFY(LL_GetBonesVisible() != 0);
-    // Calculate BOXes/Spheres if needed
-    UCalc_Visibox++;
-    if (UCalc_Visibox >= psSkeletonUpdate)
-    {
-        // mark
-        UCalc_Visibox = -(::Random.randI(psSkeletonUpdate - 1));
+    if (!UCalc_UpdateBounds)
+        return;
 
-        // the update itself
-        Fbox Box;
-        Box.invalidate();
-        for (u32 b = 0; b < bones->size(); b++)
-        {
-            if (!LL_GetBoneVisible(u16(b)))
-                continue;
-            Fobb& obb = (*bones)[b]->obb;
-            Fmatrix& Mbone = bone_instances[b].mTransform;
-            Fmatrix Mbox;
-            obb.xform_get(Mbox);
-            Fmatrix X;
-            X.mul_43(Mbone, Mbox);
-            Fvector& S = obb.m_halfsize;
+    // the update itself
+    Fbox Box;
+    Box.invalidate();
+    for (u32 b = 0; b < bones->size(); b++)
+    {
+        if (!LL_GetBoneVisible(u16(b)))
+            continue;
+        Fobb& obb = (*bones)[b]->obb;
+        Fmatrix& Mbone = bone_instances[b].mTransform;
+        Fmatrix Mbox;
+        obb.xform_get(Mbox);
+        Fmatrix X;
+        X.mul_43(Mbone, Mbox);
+        Fvector& S = obb.m_halfsize;
 
-            Fvector P, A;
-            A.set(-S.x, -S.y, -S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-            A.set(-S.x, -S.y, S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-            A.set(S.x, -S.y, S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-            A.set(S.x, -S.y, -S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-            A.set(-S.x, S.y, -S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-            A.set(-S.x, S.y, S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-            A.set(S.x, S.y, S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-            A.set(S.x, S.y, -S.z);
-            X.transform_tiny(P, A);
-            Box.modify(P);
-        }
-        if (bones->size())
-        {
-            // previous frame we have updated box - update sphere
-            vis.box.vMin = (Box.vMin);
-            vis.box.vMax = (Box.vMax);
-            vis.box.getsphere(vis.sphere.P, vis.sphere.R);
-        }
+        Fvector P, A;
+        A.set(-S.x, -S.y, -S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+        A.set(-S.x, -S.y, S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+        A.set(S.x, -S.y, S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+        A.set(S.x, -S.y, -S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+        A.set(-S.x, S.y, -S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+        A.set(-S.x, S.y, S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+        A.set(S.x, S.y, S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+        A.set(S.x, S.y, -S.z);
+        X.transform_tiny(P, A);
+        Box.modify(P);
+    }
+    if (bones->size())
+    {
+        // previous frame we have updated box - update sphere
+        vis.box.vMin = (Box.vMin);
+        vis.box.vMax = (Box.vMax);
+        vis.box.getsphere(vis.sphere.P, vis.sphere.R);
+    }
 #ifdef DEBUG
-        // Validate
-        VERIFY3(_valid(vis.box.vMin) && _valid(vis.box.vMax), "Invalid bones-xform in model", dbg_name.c_str());
-        if (vis.sphere.R > 1000.f)
+    // Validate
+    VERIFY3(_valid(vis.box.vMin) && _valid(vis.box.vMax), "Invalid bones-xform in model", dbg_name.c_str());
+    if (vis.sphere.R > 1000.f)
+    {
+        for (u16 ii = 0; ii < LL_BoneCount(); ++ii)
         {
-            for (u16 ii = 0; ii < LL_BoneCount(); ++ii)
-            {
-                Fmatrix tr;
-                tr = LL_GetTransform(ii);
-                Log("bone ", LL_BoneName_dbg(ii));
-                Log("bone_matrix", tr);
-            }
-            Log("end-------");
+            Fmatrix tr;
+            tr = LL_GetTransform(ii);
+            Log("bone ", LL_BoneName_dbg(ii));
+            Log("bone_matrix", tr);
         }
-        VERIFY3(vis.sphere.R < 1000.f, "Invalid bones-xform in model", dbg_name.c_str());
-#endif
+        Log("end-------");
     }
+    VERIFY3(vis.sphere.R < 1000.f, "Invalid bones-xform in model", dbg_name.c_str());
+#endif
+}
 
-    //
+void CKinematics::CalculateBones_Finish()
+{
     if (Update_Callback)
         Update_Callback(this);
 }
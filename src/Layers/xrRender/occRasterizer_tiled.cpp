@@ -0,0 +1,258 @@
+// occRasterizer_tiled.cpp: implementation of the occTiledRasterizer class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "occRasterizer_tiled.h"
+
+#include "xrCore/Threading/ParallelFor.hpp"
+
+#if defined(XR_ARCHITECTURE_X86) || defined(XR_ARCHITECTURE_X64) || defined(XR_ARCHITECTURE_E2K)
+#include <emmintrin.h>
+#elif defined(XR_ARCHITECTURE_ARM) || defined(XR_ARCHITECTURE_ARM64)
+#include "sse2neon/sse2neon.h"
+#else
+#error Add your platform here
+#endif
+
+static_assert(occ_tile_size % 4 == 0, "Tile rows are rasterized by 4 pixels");
+static_assert(occ_tile_size % occ_block_size == 0, "Blocks must not cross tiles");
+static_assert(occ_block_size == 8, "Block rows are tested by 2 registers");
+
+occTiledRasterizer::occTiledRasterizer()
+{
+    ZeroMemory(m_depth, sizeof(m_depth));
+    ZeroMemory(m_depth_max, sizeof(m_depth_max));
+}
+
+void occTiledRasterizer::clear()
+{
+    m_triangles.clear();
+    for (auto& bin : m_bins)
+        bin.clear();
+
+    const float f = 1.f;
+    MemFill32(m_depth, *(u32*)(&f), occ_tiled_width * occ_tiled_height);
+    MemFill32(m_depth_max, *(u32*)(&f), occ_blocks_x * occ_blocks_y);
+}
+
+bool occTiledRasterizer::submit(occTri* owner, const Fvector& v0, const Fvector& v1, const Fvector& v2)
+{
+    // Twice the signed area, edge functions are positive inside of counter-clockwise triangle
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (_abs(area) < EPS_S)
+        return false;
+
+    const Fvector* v[3] = { &v0, &v1, &v2 };
+    if (area < 0.f)
+    {
+        std::swap(v[1], v[2]);
+        area = -area;
+    }
+
+    // Covered pixel centers
+    const float min_x = std::min({ v[0]->x, v[1]->x, v[2]->x });
+    const float max_x = std::max({ v[0]->x, v[1]->x, v[2]->x });
+    const float min_y = std::min({ v[0]->y, v[1]->y, v[2]->y });
+    const float max_y = std::max({ v[0]->y, v[1]->y, v[2]->y });
+
+    int x0 = iCeil(min_x - .5f), x1 = iFloor(max_x - .5f);
+    int y0 = iCeil(min_y - .5f), y1 = iFloor(max_y - .5f);
+    clamp(x0, 0, occ_tiled_width - 1);
+    clamp(x1, 0, occ_tiled_width - 1);
+    clamp(y0, 0, occ_tiled_height - 1);
+    clamp(y1, 0, occ_tiled_height - 1);
+    if (x0 > x1 || y0 > y1 || max_x < .5f || max_y < .5f || min_x > occ_tiled_width - .5f ||
+        min_y > occ_tiled_height - .5f)
+    {
+        return false;
+    }
+
+    occTriSetup& T = m_triangles.emplace_back();
+    T.owner = owner;
+    T.written = false;
+    T.x0 = x0;
+    T.x1 = x1;
+    T.y0 = y0;
+    T.y1 = y1;
+
+    // Edge i goes from vertex i to the next one and is opposite to the vertex after it
+    const float inv_area = 1.f / area;
+    float z_a = 0.f, z_b = 0.f, z_c = 0.f;
+    for (int i = 0; i < 3; ++i)
+    {
+        const Fvector& p = *v[i];
+        const Fvector& q = *v[(i + 1) % 3];
+        const float z = v[(i + 2) % 3]->z * inv_area;
+
+        T.edge_a[i] = p.y - q.y;
+        T.edge_b[i] = q.x - p.x;
+        T.edge_c[i] = -(T.edge_a[i] * p.x + T.edge_b[i] * p.y);
+
+        z_a += T.edge_a[i] * z;
+        z_b += T.edge_b[i] * z;
+        z_c += T.edge_c[i] * z;
+    }
+
+    // Take the farthest depth inside of the pixel, the occluder must not grow
+    T.z_a = z_a;
+    T.z_b = z_b;
+    T.z_c = z_c + .5f * (_abs(z_a) + _abs(z_b));
+    T.z_max = std::max({ v[0]->z, v[1]->z, v[2]->z });
+
+    const u32 id = u32(m_triangles.size() - 1);
+    for (int ty = y0 / occ_tile_size; ty <= y1 / occ_tile_size; ++ty)
+        for (int tx = x0 / occ_tile_size; tx <= x1 / occ_tile_size; ++tx)
+            m_bins[ty * occ_tiles_x + tx].push_back(id);
+
+    return true;
+}
+
+void occTiledRasterizer::rasterize_tile(u32 tile)
+{
+    const int tile_x0 = int(tile % occ_tiles_x) * occ_tile_size;
+    const int tile_y0 = int(tile / occ_tiles_x) * occ_tile_size;
+    const int tile_x1 = tile_x0 + occ_tile_size - 1;
+    const int tile_y1 = tile_y0 + occ_tile_size - 1;
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 centers = _mm_setr_ps(.5f, 1.5f, 2.5f, 3.5f);
+
+    for (const u32 id : m_bins[tile])
+    {
+        const occTriSetup& T = m_triangles[id];
+
+        // Rows are processed from 4-pixel aligned start, edge functions discard the extra pixels
+        const int x0 = std::max(T.x0, tile_x0) & ~3;
+        const int x1 = std::min(T.x1, tile_x1);
+        const int y0 = std::max(T.y0, tile_y0);
+        const int y1 = std::min(T.y1, tile_y1);
+
+        const __m128 fx = _mm_add_ps(_mm_set1_ps(float(x0)), centers);
+        const __m128 fy = _mm_set1_ps(float(y0) + .5f);
+
+        __m128 edge_row[3], edge_dx[3], edge_dy[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            const __m128 a = _mm_set1_ps(T.edge_a[i]);
+            const __m128 b = _mm_set1_ps(T.edge_b[i]);
+            edge_row[i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, fx), _mm_mul_ps(b, fy)), _mm_set1_ps(T.edge_c[i]));
+            edge_dx[i] = _mm_mul_ps(a, _mm_set1_ps(4.f));
+            edge_dy[i] = b;
+        }
+
+        const __m128 z_a = _mm_set1_ps(T.z_a);
+        const __m128 z_b = _mm_set1_ps(T.z_b);
+        __m128 z_row = _mm_add_ps(_mm_add_ps(_mm_mul_ps(z_a, fx), _mm_mul_ps(z_b, fy)), _mm_set1_ps(T.z_c));
+        const __m128 z_dx = _mm_mul_ps(z_a, _mm_set1_ps(4.f));
+        const __m128 z_max = _mm_set1_ps(T.z_max);
+
+        __m128 written = zero;
+        for (int y = y0; y <= y1; ++y)
+        {
+            __m128 e0 = edge_row[0], e1 = edge_row[1], e2 = edge_row[2];
+            __m128 z = z_row;
+            float* depth = &m_depth[y][x0];
+            for (int x = x0; x <= x1; x += 4, depth += 4)
+            {
+                const __m128 inside =
+                    _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+                const __m128 d = _mm_load_ps(depth);
+                const __m128 pixel_z = _mm_min_ps(z, z_max);
+                const __m128 closer = _mm_and_ps(inside, _mm_cmplt_ps(pixel_z, d));
+                _mm_store_ps(depth, _mm_or_ps(_mm_and_ps(closer, pixel_z), _mm_andnot_ps(closer, d)));
+                written = _mm_or_ps(written, closer);
+
+                e0 = _mm_add_ps(e0, edge_dx[0]);
+                e1 = _mm_add_ps(e1, edge_dx[1]);
+                e2 = _mm_add_ps(e2, edge_dx[2]);
+                z = _mm_add_ps(z, z_dx);
+            }
+            edge_row[0] = _mm_add_ps(edge_row[0], edge_dy[0]);
+            edge_row[1] = _mm_add_ps(edge_row[1], edge_dy[1]);
+            edge_row[2] = _mm_add_ps(edge_row[2], edge_dy[2]);
+            z_row = _mm_add_ps(z_row, z_b);
+        }
+
+        if (_mm_movemask_ps(written))
+            m_written[tile].push_back(id);
+    }
+
+    // Max depth of the blocks
+    for (int by = tile_y0 / occ_block_size; by <= tile_y1 / occ_block_size; ++by)
+    {
+        for (int bx = tile_x0 / occ_block_size; bx <= tile_x1 / occ_block_size; ++bx)
+        {
+            __m128 r = zero;
+            for (int y = by * occ_block_size; y < (by + 1) * occ_block_size; ++y)
+            {
+                const float* depth = &m_depth[y][bx * occ_block_size];
+                r = _mm_max_ps(r, _mm_max_ps(_mm_load_ps(depth), _mm_load_ps(depth + 4)));
+            }
+            r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+            r = _mm_max_ss(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1)));
+            _mm_store_ss(&m_depth_max[by][bx], r);
+        }
+    }
+}
+
+void occTiledRasterizer::rasterize()
+{
+    xr_parallel_for(TaskRange<u32>(0, occ_tiles, 1), [this](const TaskRange<u32>& range)
+    {
+        for (u32 tile = range.begin(); tile != range.end(); ++tile)
+            rasterize_tile(tile);
+    });
+
+    for (auto& written : m_written)
+    {
+        for (const u32 id : written)
+            m_triangles[id].written = true;
+        written.clear();
+    }
+}
+
+bool occTiledRasterizer::test(float _x0, float _y0, float _x1, float _y1, float z) const
+{
+    int x0 = iFloor(_x0 * occ_tiled_width);
+    clamp(x0, 0, occ_tiled_width - 1);
+    int x1 = iFloor(_x1 * occ_tiled_width);
+    clamp(x1, x0, occ_tiled_width - 1);
+    int y0 = iFloor(_y0 * occ_tiled_height);
+    clamp(y0, 0, occ_tiled_height - 1);
+    int y1 = iFloor(_y1 * occ_tiled_height);
+    clamp(y1, y0, occ_tiled_height - 1);
+
+    const __m128 zz = _mm_set1_ps(z);
+    const __m128 lanes = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+    const __m128 first = _mm_set1_ps(float(x0));
+    const __m128 last = _mm_set1_ps(float(x1));
+
+    for (int by = y0 / occ_block_size; by <= y1 / occ_block_size; ++by)
+    {
+        for (int bx = x0 / occ_block_size; bx <= x1 / occ_block_size; ++bx)
+        {
+            // Whole block is closer than z
+            if (!(z < m_depth_max[by][bx]))
+                continue;
+
+            // Columns of the block inside of the rectangle
+            const __m128 x = _mm_add_ps(_mm_set1_ps(float(bx * occ_block_size)), lanes);
+            const __m128 x_hi = _mm_add_ps(x, _mm_set1_ps(4.f));
+            const __m128 mask_lo = _mm_and_ps(_mm_cmpge_ps(x, first), _mm_cmple_ps(x, last));
+            const __m128 mask_hi = _mm_and_ps(_mm_cmpge_ps(x_hi, first), _mm_cmple_ps(x_hi, last));
+
+            const int row0 = std::max(y0, by * occ_block_size);
+            const int row1 = std::min(y1, by * occ_block_size + occ_block_size - 1);
+            for (int y = row0; y <= row1; ++y)
+            {
+                const float* depth = &m_depth[y][bx * occ_block_size];
+                const __m128 lo = _mm_and_ps(_mm_cmplt_ps(zz, _mm_load_ps(depth)), mask_lo);
+                const __m128 hi = _mm_and_ps(_mm_cmplt_ps(zz, _mm_load_ps(depth + 4)), mask_hi);
+                if (_mm_movemask_ps(_mm_or_ps(lo, hi)))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,64 @@
+// occRasterizer_tiled.h: interface for the occTiledRasterizer class.
+//////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Higher resolution replacement for occRasterizer.
+// Triangles are set up and binned into screen tiles on submit, then tiles are
+// rasterized in parallel with SSE edge functions, 4 pixels at a time.
+// Pixel is covered when its center is inside of the triangle, so triangles
+// sharing an edge leave no cracks and adjacency isn't needed.
+const int occ_tiled_width = 256;
+const int occ_tiled_height = 128;
+const int occ_tile_size = 32;
+const int occ_tiles_x = occ_tiled_width / occ_tile_size;
+const int occ_tiles_y = occ_tiled_height / occ_tile_size;
+const int occ_tiles = occ_tiles_x * occ_tiles_y;
+const int occ_block_size = 8; // max depth of each block is kept for the early-out in test()
+const int occ_blocks_x = occ_tiled_width / occ_block_size;
+const int occ_blocks_y = occ_tiled_height / occ_block_size;
+
+class occTri;
+
+class occTiledRasterizer
+{
+private:
+    struct occTriSetup
+    {
+        // Edge functions, pixel center is inside if all of them are non-negative
+        float edge_a[3];
+        float edge_b[3];
+        float edge_c[3];
+        // Depth plane, moved to the far side of the pixel
+        float z_a, z_b, z_c;
+        float z_max;
+        int x0, y0, x1, y1; // inclusive pixel bounds
+        occTri* owner;
+        bool written;
+    };
+
+    xr_vector<occTriSetup> m_triangles;
+    xr_vector<u32> m_bins[occ_tiles];
+    xr_vector<u32> m_written[occ_tiles];
+
+    alignas(16) float m_depth[occ_tiled_height][occ_tiled_width];
+    float m_depth_max[occ_blocks_y][occ_blocks_x];
+
+    void rasterize_tile(u32 tile);
+
+public:
+    void clear();
+    // Vertices are in raster space: x in [0..occ_tiled_width], y in [0..occ_tiled_height].
+    // Returns false if the triangle covers no pixel centers.
+    bool submit(occTri* owner, const Fvector& v0, const Fvector& v1, const Fvector& v2);
+    void rasterize();
+
+    u32 get_triangles_count() const { return u32(m_triangles.size()); }
+    occTri* get_owner(u32 id) const { return m_triangles[id].owner; }
+    // True if the triangle is closer than the depth buffer in at least one pixel
+    bool is_written(u32 id) const { return m_triangles[id].written; }
+
+    // Viewport-space (0..1) rectangle, true if anything inside of it is farther than z
+    bool test(float x0, float y0, float x1, float y1, float z) const;
+
+    occTiledRasterizer();
+};
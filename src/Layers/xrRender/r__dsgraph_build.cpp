@@ -9,6 +9,8 @@
 #include "ParticleGroup.h"
 #include "FTreeVisual.h"
 
+#include "xrCore/Threading/ParallelFor.hpp"
+
 using namespace R_dsgraph;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -444,6 +446,69 @@ void D3DXRenderBase::add_leafs_Dynamic(IRenderable* root, dxRender_Visual* pVisu
     }
 }
 
+void D3DXRenderBase::r_dsgraph_calculate_bones(const CFrustum& view)
+{
+    if (!ps_r__common_flags.test(RFLAG_MT_SKELETONS))
+        return;
+
+    // Keep anyone else from calculating bones until the whole batch is done
+    UCalc_mtlock lock;
+
+    // Collect skeletons of the renderables in view, the same way add_leafs_Dynamic selects them.
+    // Anything missed here (shadow casters outside of the view, HUD) is still calculated lazily.
+    g_SpatialSpace->q_frustum(lstRenderables, 0, STYPE_RENDERABLE, view);
+    lstKinematics.clear();
+    for (ISpatial* spatial : lstRenderables)
+    {
+        IRenderable* renderable = spatial->dcast_Renderable();
+        if (!renderable)
+            continue;
+        auto& data = renderable->GetRenderData();
+        dxRender_Visual* pVisual = (dxRender_Visual*)data.visual;
+        if (!pVisual || (pVisual->Type != MT_SKELETON_ANIM && pVisual->Type != MT_SKELETON_RIGID))
+            continue;
+
+        CKinematics* pV = (CKinematics*)pVisual;
+        if (pV->m_lod)
+        {
+            Fvector Tpos;
+            float D;
+            data.xform.transform_tiny(Tpos, pV->vis.sphere.P);
+            if (CalcSSA(D, Tpos, pV->vis.sphere.R / 2.f) < r_ssaLOD_A)
+                continue;
+        }
+
+        // Animation tracks may call back into game code, so they are updated here
+        if (pV->CalculateBones_Prepare(TRUE))
+            lstKinematics.push_back(pV);
+    }
+    lstRenderables.clear();
+    if (lstKinematics.empty())
+        return;
+
+    // Bone callbacks (IK, physics, root motion) read other objects, so such models are calculated here
+    const auto serial = std::partition(lstKinematics.begin(), lstKinematics.end(),
+        [](const CKinematics* pV) { return !pV->CalculateBones_HasCallbacks(); });
+
+    BasicStats.Animation.Begin();
+    const size_t parallel_count = serial - lstKinematics.begin();
+    if (parallel_count)
+    {
+        xr_parallel_for(TaskRange<size_t>(0, parallel_count, 4), [this](const TaskRange<size_t>& range)
+        {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+                lstKinematics[i]->CalculateBones_Evaluate();
+        });
+    }
+    for (auto it = serial; it != lstKinematics.end(); ++it)
+        (*it)->CalculateBones_Evaluate();
+    BasicStats.Animation.End();
+
+    // Update callbacks (IK and such) are not thread-safe
+    for (CKinematics* pV : lstKinematics)
+        pV->CalculateBones_Finish();
+}
+
 void D3DXRenderBase::add_leafs_Static(dxRender_Visual* pVisual)
 {
     if (!RImplementation.HOM.visible(pVisual->vis))
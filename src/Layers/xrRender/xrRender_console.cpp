@@ -90,7 +90,7 @@ const xr_token qminmax_sm_token[] = {{"off", 0}, {"on", 1}, {"auto", 2}, {"autod
 extern int psSkeletonUpdate;
 extern float r__dtex_range;
 
-Flags32 ps_r__common_flags = { RFLAG_ACTOR_SHADOW }; // All renders
+Flags32 ps_r__common_flags = { RFLAG_ACTOR_SHADOW | RFLAG_MT_PARTICLES | RFLAG_MT_SKELETONS | RFLAG_HOM_TILED }; // All renders
 
 //int ps_r__Supersample = 1;
 int ps_r__LightSleepFrames = 10;
@@ -391,6 +391,43 @@ public:
     }
 };
 
+class CCC_HOMRecord : public IConsole_Command
+{
+public:
+    CCC_HOMRecord(LPCSTR N) : IConsole_Command(N) {}
+    virtual void Execute(LPCSTR args)
+    {
+        string_path name;
+        name[0] = 0;
+        sscanf(args, "%s", name);
+        if (!xr_strlen(name))
+        {
+            Msg("! Usage: %s <file name>", cName);
+            return;
+        }
+        RImplementation.HOM.Record(name);
+    }
+};
+
+class CCC_HOMBench : public IConsole_Command
+{
+public:
+    CCC_HOMBench(LPCSTR N) : IConsole_Command(N) {}
+    virtual void Execute(LPCSTR args)
+    {
+        string_path name;
+        name[0] = 0;
+        int iterations = 100;
+        sscanf(args, "%s %d", name, &iterations);
+        if (!xr_strlen(name))
+        {
+            Msg("! Usage: %s <file name> [iterations]", cName);
+            return;
+        }
+        RImplementation.HOM.Bench(name, u32(std::max(iterations, 1)));
+    }
+};
+
 class CCC_ModelPoolStat : public IConsole_Command
 {
 public:
@@ -774,6 +811,11 @@ void xrRender_initconsole()
 
     CMD3(CCC_Mask, "r__no_ram_textures", &ps_r__common_flags, RFLAG_NO_RAM_TEXTURES);
     CMD3(CCC_Mask, "r__actor_shadow", &ps_r__common_flags, RFLAG_ACTOR_SHADOW);
+    CMD3(CCC_Mask, "r__mt_particles", &ps_r__common_flags, RFLAG_MT_PARTICLES);
+    CMD3(CCC_Mask, "r__mt_skeletons", &ps_r__common_flags, RFLAG_MT_SKELETONS);
+    CMD3(CCC_Mask, "r__hom_tiled", &ps_r__common_flags, RFLAG_HOM_TILED);
+    CMD1(CCC_HOMRecord, "r__hom_record");
+    CMD1(CCC_HOMBench, "r__hom_bench");
 
     CMD2(CCC_tf_Aniso, "r__tf_aniso", &ps_r__tf_Anisotropic); // {1..16}
     CMD2(CCC_tf_MipBias, "r1_tf_mipbias", &ps_r__tf_Mipbias); // {-3 +3}
@@ -61,6 +61,9 @@ enum
 {
     RFLAG_NO_RAM_TEXTURES = (1 << 0),
     RFLAG_ACTOR_SHADOW = (1 << 1),
+    RFLAG_MT_PARTICLES = (1 << 2),
+    RFLAG_MT_SKELETONS = (1 << 3),
+    RFLAG_HOM_TILED = (1 << 4),
 };
 
 extern ECORE_API Flags32 ps_r__common_flags;
@@ -108,7 +108,7 @@ void CDetailManager::hw_Render_dump(const Fvector4& consts, const Fvector4& wave
     u32 vOffset = 0;
     u32 iOffset = 0;
 
-    vis_list& list = m_visibles [var_id];
+    vis_list& list = m_visibles[m_render_buffer][var_id];
 
     CEnvDescriptor& desc = *g_pGamePersistent->Environment().CurrentEnv;
     Fvector c_sun, c_ambient, c_hemi;
@@ -170,7 +170,7 @@ void CDetailManager::hw_Render_dump(const Fvector4& consts, const Fvector4& wave
                         u32 base = dwBatch * 4;
 
                         // Build matrix ( 3x4 matrix, last row - color )
-                        float scale = Instance.scale_calculated;
+                        float scale = Instance.scale_calculated[m_render_buffer];
                         Fmatrix& M = Instance.mRotY;
                         RCache.set_ca(&*constArray, base + 0, M._11 * scale, M._21 * scale, M._31 * scale, M._41);
                         RCache.set_ca(&*constArray, base + 1, M._12 * scale, M._22 * scale, M._32 * scale, M._42);
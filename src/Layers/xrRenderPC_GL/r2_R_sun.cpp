@@ -369,7 +369,7 @@ void CRender::render_sun()
     // Compute volume(s) - something like a frustum for infinite directional light
     // Also compute virtual light position and sector it is inside
     CFrustum cull_frustum;
-    xr_vector<Fplane> cull_planes;
+    xr_frame_vector<Fplane> cull_planes;
     Fvector3 cull_COP;
     CSector* cull_sector;
     glm::mat4 cull_xform;
@@ -861,7 +861,7 @@ void CRender::render_sun_near()
     // Compute volume(s) - something like a frustum for infinite directional light
     // Also compute virtual light position and sector it is inside
     CFrustum cull_frustum;
-    xr_vector<Fplane> cull_planes;
+    xr_frame_vector<Fplane> cull_planes;
     Fvector3 cull_COP;
     CSector* cull_sector;
     glm::mat4 cull_xform;
@@ -1120,7 +1120,7 @@ void CRender::render_sun_cascade(u32 cascade_ind)
     // Compute volume(s) - something like a frustum for infinite directional light
     // Also compute virtual light position and sector it is inside
     CFrustum cull_frustum;
-    xr_vector<Fplane> cull_planes;
+    xr_frame_vector<Fplane> cull_planes;
     Fvector3 cull_COP;
     CSector* cull_sector;
     Fmatrix cull_xform;
@@ -76,7 +76,7 @@ void CRender::render_rain()
     // Compute volume(s) - something like a frustum for infinite directional light
     // Also compute virtual light position and sector it is inside
     CFrustum cull_frustum;
-    xr_vector<Fplane> cull_planes;
+    xr_frame_vector<Fplane> cull_planes;
     Fvector3 cull_COP;
     CSector* cull_sector;
     Fmatrix cull_xform;
@@ -474,6 +474,9 @@ void CRender::Calculate()
     // Frustum
     ViewBase.CreateFromMatrix(Device.mFullTransform, FRUSTUM_P_LRTB | FRUSTUM_P_FAR);
 
+    // Skeletons in view are evaluated in parallel, dsgraph build only picks up their matrices
+    r_dsgraph_calculate_bones(ViewBase);
+
     gm_SetNearer(FALSE);
     phase = PHASE_NORMAL;
 
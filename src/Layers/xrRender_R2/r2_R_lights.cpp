@@ -1,4 +1,5 @@
 #include "stdafx.h"
+#include "xrCore/Memory/FrameArena.h"
 
 IC bool pred_area(light* _1, light* _2)
 {
@@ -83,7 +84,7 @@ void CRender::render_lights(light_Package& LP)
     while (LP.v_shadowed.size())
     {
         // if (has_spot_shadowed)
-        xr_vector<light*> L_spot_s;
+        xr_frame_vector<light*> L_spot_s;
         Stats.s_used++;
 
         // generate spot shadowmap
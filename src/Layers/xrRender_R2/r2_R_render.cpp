@@ -257,6 +257,9 @@ void CRender::Render()
     // Frustum
     ViewBase.CreateFromMatrix(Device.mFullTransform, FRUSTUM_P_LRTB + FRUSTUM_P_FAR);
 
+    // Skeletons in view are evaluated in parallel, dsgraph build only picks up their matrices
+    r_dsgraph_calculate_bones(ViewBase);
+
     //******* Z-prefill calc - DEFERRER RENDERER
     if (ps_r2_ls_flags.test(R2FLAG_ZFILL))
     {
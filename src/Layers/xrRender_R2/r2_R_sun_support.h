@@ -1,5 +1,7 @@
 #pragma once
 
+#include "xrCore/Memory/FrameArena.h"
+
 const u32 LIGHT_CUBOIDSIDEPOLYS_COUNT = 4;
 const u32 LIGHT_CUBOIDVERTICES_COUNT = 2 * LIGHT_CUBOIDSIDEPOLYS_COUNT;
 
@@ -50,7 +52,7 @@ public:
     }
 
     void compute_caster_model_fixed(
-        xr_vector<Fplane>& dest, Fvector3& translation, float map_size, bool clip_by_view_near)
+        xr_frame_vector<Fplane>& dest, Fvector3& translation, float map_size, bool clip_by_view_near)
     {
         translation.set(0.f, 0.f, 0.f);
 
@@ -283,7 +285,7 @@ class DumbConvexVolume
 public:
     struct _poly
     {
-        xr_vector<int> points;
+        xr_frame_vector<int> points;
         Fvector3 planeN;
         float planeD;
         float classify(Fvector3& p) { return planeN.dotproduct(p) + planeD; }
@@ -301,9 +303,10 @@ public:
     };
 
 public:
-    xr_vector<Fvector3> points;
-    xr_vector<_poly> polys;
-    xr_vector<_edge> edges;
+    // The volume is built from scratch every frame
+    xr_frame_vector<Fvector3> points;
+    xr_frame_vector<_poly> polys;
+    xr_frame_vector<_edge> edges;
 
 public:
     void compute_planes()
@@ -365,7 +368,7 @@ public:
         }
     }
 
-    void compute_caster_model(xr_vector<Fplane>& dest, Fvector3 direction)
+    void compute_caster_model(xr_frame_vector<Fplane>& dest, Fvector3 direction)
     {
         CRenderTarget& T = *RImplementation.Target;
 
@@ -394,7 +397,7 @@ public:
             int marker = (base.planeN.dotproduct(direction) <= 0) ? -1 : 1;
 
             // register edges
-            xr_vector<int>& plist = polys[it].points;
+            xr_frame_vector<int>& plist = polys[it].points;
             for (int p = 0; p < int(plist.size()); p++)
             {
                 _edge E(plist[p], plist[(p + 1) % plist.size()], marker);
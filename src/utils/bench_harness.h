@@ -0,0 +1,88 @@
+#pragma once
+
+// Shared parts of the headless benchmarks: core setup, command line and timings report.
+
+namespace bench
+{
+// Parameters are matched as whole words, so "-st" doesn't match "-start".
+// Returns the text right after the parameter name or nullptr.
+inline pcstr find_param(pcstr name)
+{
+    const size_t length = xr_strlen(name);
+    for (pcstr p = strstr(Core.Params, name); p; p = strstr(p + 1, name))
+    {
+        const bool word_start = p == Core.Params || isspace(u8(p[-1]));
+        const bool word_end = !p[length] || isspace(u8(p[length]));
+        if (word_start && word_end)
+            return p + length;
+    }
+    return nullptr;
+}
+
+inline bool has_param(pcstr name) { return !!find_param(name); }
+
+inline int int_param(pcstr name, int default_value)
+{
+    int value = default_value;
+    if (pcstr p = find_param(name))
+        sscanf(p, "%d", &value);
+    return value;
+}
+
+inline bool str_param(pcstr name, string_path& value)
+{
+    pcstr p = find_param(name);
+    return p && 1 == sscanf(p, " %[^ ]", value);
+}
+
+struct timings
+{
+    float total;
+    float avg;
+    float p50;
+    float p90;
+    float p99;
+    float max;
+};
+
+inline float percentile(xr_vector<float>& values, float p)
+{
+    if (values.empty())
+        return 0.f;
+    const size_t n = std::min(values.size() - 1, size_t(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + n, values.end());
+    return values[n];
+}
+
+inline timings summarize(xr_vector<float> values)
+{
+    timings result{};
+    for (const float time : values)
+        result.total += time;
+
+    result.avg = result.total / float(std::max<size_t>(values.size(), 1));
+    result.p50 = percentile(values, 0.5f);
+    result.p90 = percentile(values, 0.9f);
+    result.p99 = percentile(values, 0.99f);
+    result.max = percentile(values, 1.f);
+    return result;
+}
+
+// Initializes the core without game data requirements, runs the benchmark and returns its exit code
+template <typename Body>
+int run(pcstr name, int argc, char* argv[], Body&& body)
+{
+    xr_string commandLine;
+    for (int i = 1; i < argc; ++i)
+    {
+        commandLine += argv[i];
+        commandLine += " ";
+    }
+
+    xrDebug::Initialize(commandLine.c_str());
+    Core.Initialize(name, commandLine.c_str(), nullptr, true);
+    const int result = body();
+    Core._destroy();
+    return result;
+}
+} // namespace bench
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "compiler.h"
+#include "xrCore/Threading/TaskManager.hpp"
 
 CDB::MODEL Level;
 Nodes g_nodes;
@@ -11,18 +12,36 @@ void mem_Optimize()
     Msg("* Memory usage: %d M", Memory.mem_usage() / (1024 * 1024));
 }
 
-void xrCompiler(LPCSTR name, bool draft_mode, bool pure_covers, LPCSTR out_name)
+void xrCompiler(LPCSTR name, bool draft_mode, bool pure_covers, LPCSTR out_name, bool benchmark)
 {
+    CTimer timer;
+    float load_time = 0.f, cover_time = 0.f, save_time = 0.f;
+
     Logger.Phase("Loading level...");
+    timer.Start();
     xrLoad(name, draft_mode);
+    load_time = timer.GetElapsed_sec();
     mem_Optimize();
     if (!draft_mode)
     {
         Logger.Phase("Calculating coverage...");
+        timer.Start();
         xrCover(pure_covers);
+        cover_time = timer.GetElapsed_sec();
         mem_Optimize();
     }
-    Logger.Phase("Saving nodes...");
-    xrSaveNodes(name, out_name);
-    mem_Optimize();
+    // Benchmark measures the stages only, the level graph isn't written
+    if (!benchmark)
+    {
+        Logger.Phase("Saving nodes...");
+        timer.Start();
+        xrSaveNodes(name, out_name);
+        save_time = timer.GetElapsed_sec();
+        mem_Optimize();
+    }
+
+    Logger.clMsg("Stage timings (%d nodes, %d workers):", u32(g_nodes.size()), u32(TaskScheduler->GetWorkersCount()));
+    Logger.clMsg("- load:  %.3fs", load_time);
+    Logger.clMsg("- cover: %.3fs", cover_time);
+    Logger.clMsg("- save:  %.3fs", save_time);
 }
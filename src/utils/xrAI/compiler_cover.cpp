@@ -1,7 +1,8 @@
 #include "stdafx.h"
 #include "compiler.h"
 #include "xrCDB/Intersect.hpp"
-#include <mmsystem.h>
+#include "xrCore/Threading/ParallelFor.hpp"
+#include "xrCore/Threading/ScopeLock.hpp"
 
 #include "xrGame/quadtree.h"
 #include "xrGame/cover_point.h"
@@ -218,9 +219,9 @@ struct RC
     RayCache C;
 };
 
-class CoverThread : public CThread
+// Collider, query and ray cache of one worker, reused by the ranges it takes
+class CoverContext
 {
-    u32 Nstart, Nend;
     xr_vector<RC> cache;
     CDB::COLLIDER DB;
     Query Q;
@@ -228,10 +229,19 @@ class CoverThread : public CThread
     typedef float Cover[4];
 
 public:
-    CoverThread(u32 ID, u32 _start, u32 _end) : CThread(ID, ProxyMsg), Q()
+    CoverContext()
     {
-        Nstart = _start;
-        Nend = _end;
+        DB.ray_options(CDB::OPT_CULL);
+        {
+            RC rc;
+            rc.C[0].set(0, 0, 0);
+            rc.C[1].set(0, 0, 0);
+            rc.C[2].set(0, 0, 0);
+
+            cache.assign(g_nodes.size() * 2, rc);
+        }
+
+        Q.Begin(g_nodes.size());
     }
 
     void compute_cover_value(u32 const& N, vertex& BaseNode, float const& cover_height, Cover& cover)
@@ -291,25 +301,12 @@ public:
         clamp(cover[3], 0.f, 1.f); // back
     }
 
-    virtual void Execute()
+    void Execute(u32 Nstart, u32 Nend)
     {
-        DB.ray_options(CDB::OPT_CULL);
-        {
-            RC rc;
-            rc.C[0].set(0, 0, 0);
-            rc.C[1].set(0, 0, 0);
-            rc.C[2].set(0, 0, 0);
-
-            cache.assign(g_nodes.size() * 2, rc);
-        }
-
         FPU::m24r();
 
-        Q.Begin(g_nodes.size());
         for (u32 N = Nstart; N < Nend; N++)
         {
-            // initialize process
-            thProgress = float(N - Nstart) / float(Nend - Nstart);
             vertex& BaseNode = g_nodes[N];
 
             if (!g_cover_nodes[N])
@@ -331,6 +328,57 @@ public:
     }
 };
 
+class CoverContextPool
+{
+    xr_vector<CoverContext*> free;
+    Lock lock;
+
+public:
+    ~CoverContextPool() { delete_data(free); }
+
+    CoverContext* acquire()
+    {
+        {
+            ScopeLock scope(&lock);
+            if (!free.empty())
+            {
+                CoverContext* context = free.back();
+                free.pop_back();
+                return context;
+            }
+        }
+        return xr_new<CoverContext>();
+    }
+
+    void release(CoverContext* context)
+    {
+        ScopeLock scope(&lock);
+        free.push_back(context);
+    }
+};
+
+// Cost of a node differs a lot (number of neighbours in the cover radius, covers or not),
+// so the nodes are split into small ranges and idle workers steal them
+constexpr u32 cover_grain = 64;
+
+void compute_covers()
+{
+    CoverContextPool contexts;
+    std::atomic<u32> processed = 0;
+    const u32 total = u32(g_nodes.size());
+
+    xr_parallel_for(TaskRange<u32>(0, total, cover_grain), [&](const TaskRange<u32>& range)
+    {
+        CoverContext* context = contexts.acquire();
+        context->Execute(range.begin(), range.end());
+        contexts.release(context);
+
+        const u32 count = u32(range.size());
+        const u32 done = processed.fetch_add(count) + count;
+        Logger.Progress(float(done) / float(total));
+    });
+}
+
 bool valid_vertex_id(const u32& vertex_id) { return (vertex_id != InvalidNode); }
 bool cover(const vertex& v, u32 index0, u32 index1)
 {
@@ -534,17 +582,10 @@ void xrCover(bool pure_covers)
     else
         g_cover_nodes.assign(g_nodes.size(), true);
 
-    // Start threads, wait, continue --- perform all the work
     CTimer timer;
     timer.Start();
-    CThreadManager Threads(ProxyStatus, ProxyProgress);
-    u32 stride = g_nodes.size() / NUM_THREADS;
-    u32 last = g_nodes.size() - stride * (NUM_THREADS - 1);
-    for (u32 thID = 0; thID < NUM_THREADS; thID++)
-        Threads.start(
-            xr_new<CoverThread>(thID, thID * stride, thID * stride + ((thID == (NUM_THREADS - 1)) ? last : stride)));
-    Threads.wait();
-    Logger.clMsg("%f seconds elapsed.", timer.GetElapsed_sec());
+    compute_covers();
+    Logger.clMsg("%f seconds elapsed, %d workers.", timer.GetElapsed_sec(), u32(TaskScheduler->GetWorkersCount()));
 
     if (!pure_covers)
     {
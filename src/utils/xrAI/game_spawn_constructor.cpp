@@ -13,6 +13,10 @@
 #include "level_spawn_constructor.h"
 #include "xrAI.h"
 
+#if !defined(XR_PLATFORM_WINDOWS)
+#include <glob.h>
+#endif
+
 extern LPCSTR GAME_CONFIG;
 extern LPCSTR generate_temp_file_name(LPCSTR header0, LPCSTR header1, string_path& buffer);
 
@@ -292,12 +296,13 @@ void clear_temp_folder()
     FS.update_path(path_root, "$app_data_root$", "temp\\");
     string_path path_final;
 
+    xr_vector<shared_str> files;
+#if defined(XR_PLATFORM_WINDOWS)
     _finddata_t file;
     auto handle = _findfirst(query, &file);
     if (handle == intptr_t(-1))
         return;
 
-    xr_vector<shared_str> files;
     do
     {
         if (file.attrib & _A_SUBDIR)
@@ -308,10 +313,27 @@ void clear_temp_folder()
     } while (!_findnext(handle, &file));
 
     _findclose(handle);
+#else
+    convert_path_separators(query);
+    glob_t globbuf;
+    if (0 != glob(query, GLOB_NOSORT, nullptr, &globbuf))
+        return;
+
+    // glob returns full paths
+    for (size_t i = 0; i < globbuf.gl_pathc; ++i)
+    {
+        struct stat fi;
+        if (stat(globbuf.gl_pathv[i], &fi) || S_ISDIR(fi.st_mode))
+            continue;
+        files.push_back(globbuf.gl_pathv[i]);
+    }
+
+    globfree(&globbuf);
+#endif
 
     for (const auto &i : files)
     {
-        if (DeleteFile(*i))
+        if (0 == remove(*i))
             Msg("file %s is successfully deleted", *i);
         else
             Msg("cannot delete file %s", *i);
@@ -0,0 +1,36 @@
+#include "stdafx.h"
+#if defined(XR_PLATFORM_WINDOWS)
+#include "utils/xrLCUtil/LevelCompilerLoggerWindow.hpp"
+
+ILevelCompilerLogger& Logger = LevelCompilerLoggerWindow::instance();
+#else
+#include "utils/xrLCUtil/LevelCompilerLoggerConsole.hpp"
+
+ILevelCompilerLogger& Logger = LevelCompilerLoggerConsole::instance();
+#endif
+
+namespace
+{
+// Plain functions instead of cdecl_cast'ed lambdas, GCC can't deduce variadic lambda signatures
+void LogMsg(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Logger.clMsgV(format, args);
+    va_end(args);
+}
+
+void LogStatus(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Logger.StatusV(format, args);
+    va_end(args);
+}
+
+void LogProgress(float progress) { Logger.Progress(progress); }
+} // namespace
+
+CThread::LogFunc ProxyMsg = LogMsg;
+CThreadManager::ReportStatusFunc ProxyStatus = LogStatus;
+CThreadManager::ReportProgressFunc ProxyProgress = LogProgress;
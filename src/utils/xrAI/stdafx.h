@@ -7,17 +7,20 @@
 #include "xrCore/xrCore.h"
 
 #include "xrAICore/AISpaceBase.hpp"
+#include "xrScriptEngine/DebugMacros.hpp" // for THROW2 in xrAICore navigation // XXX: move debug macros to xrCore
+#include "xrEngine/Engine.h"
+#include "xrEngine/device.h" // for restriction_space.h
 
 #include <memory>
 
+#if defined(XR_PLATFORM_WINDOWS)
 #include <d3dx9.h>
+#endif
 #include "Common/_d3d_extensions.h"
 
 #include "utils/xrLCUtil/ILevelCompilerLogger.hpp"
 #include "utils/xrLCUtil/xrThread.hpp"
 
-#define NUM_THREADS 8
-
 extern ILevelCompilerLogger& Logger;
 extern CThread::LogFunc ProxyMsg;
 extern CThreadManager::ReportStatusFunc ProxyStatus;
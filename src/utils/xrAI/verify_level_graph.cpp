@@ -120,12 +120,11 @@ void verify_level_graph(LPCSTR name, bool verbose)
     {
         marks.assign(level_graph.header().vertex_count(), false);
         floodfill(level_graph, stack_storage, marks, i);
-        for (auto &j : marks)
+        for (u32 J = 0; J < marks.size(); ++J)
         {
-            if (!j)
+            if (!marks[J])
             {
                 valid = false;
-                auto J = std::distance(&marks.front(), &j);
                 Msg("AI-map is NOT valid :\nNode \n%6d[%f][%f][%f]\ncannot be reached from the node\n%6d[%f][%f][%f]\n",
                     J, VPUSH(level_graph.vertex_position(J)),
                     i, VPUSH(level_graph.vertex_position(i)));
@@ -3,11 +3,13 @@
 
 #include "game_spawn_constructor.h"
 
+#if defined(XR_PLATFORM_WINDOWS)
 #include <mmsystem.h>
 
 #pragma comment(linker, "/STACK:0x800000,0x400000")
 
 #pragma comment(lib, "winmm.LIB")
+#endif
 
 #include "xrCore/ModuleLookup.hpp"
 
@@ -16,16 +18,24 @@
 CreateEntity* create_entity = nullptr;
 DestroyEntity* destroy_entity = nullptr;
 
-extern void xrCompiler(LPCSTR name, bool draft_mode, bool pure_covers, LPCSTR out_name);
+extern void xrCompiler(LPCSTR name, bool draft_mode, bool pure_covers, LPCSTR out_name, bool benchmark);
 extern void verify_level_graph(LPCSTR name, bool verbose);
 
 static const char* h_str =
     "-? or -h == this help\n"
     "-f <NAME> == compile level.ai\n"
+    "-f <NAME> -benchmark == compile level.ai without saving, report stage timings\n"
     "-s <NAME,...> == build game spawn data\n"
     "-verify <NAME> == verify compiled level.ai\n";
 
-void Help() { MessageBox(0, h_str, "Command line options", MB_OK | MB_ICONINFORMATION); }
+void Help()
+{
+#if defined(XR_PLATFORM_WINDOWS)
+    MessageBox(0, h_str, "Command line options", MB_OK | MB_ICONINFORMATION);
+#else
+    printf("%s", h_str);
+#endif
+}
 string_path INI_FILE;
 
 LPCSTR GAME_CONFIG = "game.ltx";
@@ -74,7 +84,7 @@ void execute(pstr cmd)
         else
             output = (pstr)LEVEL_GRAPH_NAME;
 
-        xrCompiler(prjName, !!strstr(cmd, "-draft"), !!strstr(cmd, "-pure_covers"), output);
+        xrCompiler(prjName, !!strstr(cmd, "-draft"), !!strstr(cmd, "-pure_covers"), output, !!strstr(cmd, "-benchmark"));
     }
     else
     {
@@ -113,8 +123,8 @@ void execute(pstr cmd)
             pcstr create_entity_name = "_create_entity@4";
             pcstr destroy_entity_name = "_destroy_entity@4";
 #endif
-            create_entity = static_cast<CreateEntity*>(hFactory->GetProcAddress(create_entity_name));
-            destroy_entity = static_cast<DestroyEntity*>(hFactory->GetProcAddress(destroy_entity_name));
+            create_entity = reinterpret_cast<CreateEntity*>(hFactory->GetProcAddress(create_entity_name));
+            destroy_entity = reinterpret_cast<DestroyEntity*>(hFactory->GetProcAddress(destroy_entity_name));
 
             R_ASSERT(create_entity);
             R_ASSERT(destroy_entity);
@@ -160,14 +170,32 @@ void Startup(pstr lpCmdLine)
     Logger.Destroy();
 }
 
-int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, pstr lpCmdLine, int nCmdShow)
+int entry_point(pstr commandLine)
 {
-    xrDebug::Initialize(lpCmdLine);
+    xrDebug::Initialize(commandLine);
     Core.Initialize("xrAI");
 
-    Startup(lpCmdLine);
+    Startup(commandLine);
 
     Core._destroy();
 
     return 0;
 }
+
+#if defined(XR_PLATFORM_WINDOWS)
+int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, pstr lpCmdLine, int nCmdShow)
+{
+    return entry_point(lpCmdLine);
+}
+#else
+int main(int argc, char* argv[])
+{
+    string4096 commandLine{};
+    for (int i = 1; i < argc; ++i)
+    {
+        xr_strcat(commandLine, argv[i]);
+        xr_strcat(commandLine, " ");
+    }
+    return entry_point(commandLine);
+}
+#endif
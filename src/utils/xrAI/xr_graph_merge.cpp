@@ -15,7 +15,9 @@
 #include "guid_generator.h"
 #include "game_graph_builder.h"
 #include "xrServerEntities/xrMessages.h"
+#if defined(XR_PLATFORM_WINDOWS)
 #include <direct.h>
+#endif
 #include <random>
 
 extern LPCSTR GAME_CONFIG;
@@ -55,6 +57,8 @@ u32 dwfGetIDByLevelName(CInifile* Ini, LPCSTR caLevelName)
     return (u32(-1));
 }
 
+class CLevelGameGraph;
+
 using GRAPH_P_MAP = xr_map<u32, ::CLevelGameGraph*>;
 using VERTEX_MAP = xr_map<pstr, SConnectionVertex, CCompareVertexPredicate>;
 
@@ -500,6 +504,9 @@ LPCSTR generate_temp_file_name(LPCSTR header0, LPCSTR header1, string_path& buff
     FS.update_path(path, "$app_data_root$", "temp");
     xr_strcat(path, sizeof(path), "\\");
 
+#if !defined(XR_PLATFORM_WINDOWS)
+    convert_path_separators(path);
+#endif
     _mkdir(path);
 
     strconcat(sizeof(buffer), buffer, path, header0, header1);
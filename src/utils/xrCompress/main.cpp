@@ -29,6 +29,7 @@ int __cdecl main(int argc, char* argv[])
             printf("-diff /? option to get information about creating difference.\n");
             printf("-fast	- fast compression.\n");
             printf("-store	- store files. No compression.\n");
+            printf("-blocks	- compress big files in blocks instead of storing them, they still can be streamed.\n");
             printf("-ltx <file_name.ltx> - pathes to compress.\n");
             printf("\n");
             printf("LTX format:\n");
@@ -54,6 +55,7 @@ int __cdecl main(int argc, char* argv[])
 
         C.SetStoreFiles(NULL != strstr(params, "-store"));
         C.SetFastMode(NULL != strstr(params, "-fast"));
+        C.SetBlockMode(NULL != strstr(params, "-blocks"));
         C.SetTargetName(argv[1]);
 
         LPCSTR p = strstr(params, "-ltx");
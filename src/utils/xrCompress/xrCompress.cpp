@@ -2,8 +2,8 @@
 #include "xrCompress.h"
 
 xrCompressor::xrCompressor()
-    : fs_pack_writer(NULL), bFast(false), files_list(NULL), folders_list(NULL), bStoreFiles(false), pPackHeader(NULL),
-      config_ltx(NULL)
+    : fs_pack_writer(NULL), bFast(false), files_list(NULL), folders_list(NULL), bStoreFiles(false), bBlocks(false),
+      pPackHeader(NULL), config_ltx(NULL)
 {
     bytesSRC = 0;
     bytesDST = 0;
@@ -177,6 +177,58 @@ void xrCompressor::write_file_header(
     fs_desc.w(buffer_start, full_buffer_size);
 }
 
+// Compresses the file in independent blocks, so it still can be streamed (see CBlockStreamReader)
+bool xrCompressor::CompressBlocks(IReader* src, u32& size_compressed)
+{
+    const u32 size = src->length();
+    const u32 block_count = (size + CFS_BlockSize - 1) / CFS_BlockSize;
+
+    xr_vector<u32> offsets;
+    offsets.reserve(block_count + 1);
+    CMemoryWriter blocks;
+    u8* c_data = xr_alloc<u8>(rtc_csize(CFS_BlockSize));
+    u32 offset = (2 + block_count + 1) * sizeof(u32);
+
+    t_compress.Begin();
+    for (u32 i = 0; i < block_count; ++i)
+    {
+        const u8* block = (const u8*)src->pointer() + i * CFS_BlockSize;
+        const u32 block_size = std::min<u32>(CFS_BlockSize, size - i * CFS_BlockSize);
+
+        lzo_uint c_size = rtc_csize(CFS_BlockSize);
+        if (bFast)
+            R_ASSERT(LZO_E_OK == lzo1x_1_compress(block, block_size, c_data, &c_size, c_heap));
+        else
+            R_ASSERT(LZO_E_OK == lzo1x_999_compress(block, block_size, c_data, &c_size, c_heap));
+
+        offsets.push_back(offset);
+        if (c_size >= block_size)
+        {
+            // Stored as is
+            blocks.w(block, block_size);
+            offset += block_size;
+        }
+        else
+        {
+            blocks.w(c_data, c_size);
+            offset += c_size;
+        }
+    }
+    offsets.push_back(offset);
+    t_compress.End();
+    xr_free(c_data);
+
+    if (offset + 16 >= size)
+        return false;
+
+    fs_pack_writer->w_u32(CFS_BlockSize);
+    fs_pack_writer->w_u32(block_count);
+    fs_pack_writer->w(offsets.data(), offsets.size() * sizeof(u32));
+    fs_pack_writer->w(blocks.pointer(), blocks.size());
+    size_compressed = offset | CFS_BlockCompressMark;
+    return true;
+}
+
 void xrCompressor::CompressOne(LPCSTR path)
 {
     filesTOTAL++;
@@ -233,15 +285,24 @@ void xrCompressor::CompressOne(LPCSTR path)
     {
         if (testVFS(path))
         {
-            filesVFS++;
-
-            // Write into BaseFS
             c_ptr = fs_pack_writer->tell();
             c_size_real = src->length();
-            c_size_compressed = src->length();
-            fs_pack_writer->w(src->pointer(), c_size_real);
-            printf("VFS");
-            Msg("%-80s   - VFS", path);
+            if (bBlocks && !bStoreFiles && c_size_real > CFS_BlockSize && CompressBlocks(src, c_size_compressed))
+            {
+                const u32 c_size_stored = c_size_compressed & ~CFS_BlockCompressMark;
+                printf("BLOCKS %3.1f%%", 100.f * float(c_size_stored) / float(c_size_real));
+                Msg("%-80s   - BLOCKS (%3.1f%%)", path, 100.f * float(c_size_stored) / float(c_size_real));
+            }
+            else
+            {
+                filesVFS++;
+
+                // Write into BaseFS
+                c_size_compressed = src->length();
+                fs_pack_writer->w(src->pointer(), c_size_real);
+                printf("VFS");
+                Msg("%-80s   - VFS", path);
+            }
         }
         else
         { // if(testVFS(path))
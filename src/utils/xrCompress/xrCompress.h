@@ -6,6 +6,7 @@ class xrCompressor
 {
     bool bFast;
     bool bStoreFiles;
+    bool bBlocks;
     IWriter* fs_pack_writer;
     CMemoryWriter fs_desc;
     shared_str target_name;
@@ -41,6 +42,7 @@ class xrCompressor
     void PerformWork();
 
     void CompressOne(LPCSTR path);
+    bool CompressBlocks(IReader* src, u32& size_compressed);
 
     u32 bytesSRC;
     u32 bytesDST;
@@ -59,6 +61,7 @@ public:
     ~xrCompressor();
     void SetFastMode(bool b) { bFast = b; }
     void SetStoreFiles(bool b) { bStoreFiles = b; }
+    void SetBlockMode(bool b) { bBlocks = b; }
     void SetMaxVolumeSize(u32 sz) { XRP_MAX_SIZE = sz; }
     void SetTargetName(LPCSTR n) { target_name = n; }
     void SetPackHeaderName(LPCSTR n);
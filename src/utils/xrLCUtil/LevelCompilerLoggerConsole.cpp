@@ -0,0 +1,100 @@
+#include "pch.hpp"
+#include "LevelCompilerLoggerConsole.hpp"
+#include "xrCore/Threading/ScopeLock.hpp"
+
+LevelCompilerLoggerConsole::LevelCompilerLoggerConsole() { phase[0] = 0; }
+
+void LevelCompilerLoggerConsole::Initialize(const char* name)
+{
+    Msg("* %s", name);
+    phase_start_time = CPU::GetTicks();
+}
+
+void LevelCompilerLoggerConsole::Destroy()
+{
+    ScopeLock lock(&csLog);
+    EndPhase();
+}
+
+void LevelCompilerLoggerConsole::clMsg(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    clMsgV(format, args);
+    va_end(args);
+}
+
+void LevelCompilerLoggerConsole::clMsgV(const char* format, va_list args)
+{
+    char buf[1024];
+    vsprintf(buf, format, args);
+    ScopeLock lock(&csLog);
+    string1024 msg;
+    strconcat(sizeof(msg), msg, "    |    | ", buf);
+    Log(msg);
+}
+
+void LevelCompilerLoggerConsole::clLog(const char* format, ...)
+{
+    va_list args;
+    char buf[1024];
+    va_start(args, format);
+    vsprintf(buf, format, args);
+    va_end(args);
+    ScopeLock lock(&csLog);
+    Log(buf);
+}
+
+void LevelCompilerLoggerConsole::Status(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    StatusV(format, args);
+    va_end(args);
+}
+
+void LevelCompilerLoggerConsole::StatusV(const char* format, va_list args)
+{
+    char buf[1024];
+    vsprintf(buf, format, args);
+    ScopeLock lock(&csLog);
+    Msg("    | %s", buf);
+}
+
+void LevelCompilerLoggerConsole::Progress(float progress)
+{
+    // Log every 10%, progress is reported from worker threads
+    const int value = iFloor(progress * 10.f);
+    ScopeLock lock(&csLog);
+    if (value == last_progress)
+        return;
+    last_progress = value;
+    Msg("    | %d%%", value * 10);
+}
+
+void LevelCompilerLoggerConsole::EndPhase()
+{
+    if (!phase[0])
+        return;
+    const u32 phase_total_time = CPU::GetTicks() - phase_start_time;
+    Msg("* Phase finished: %s (%s)", phase, make_time(phase_total_time / 1000).c_str());
+}
+
+void LevelCompilerLoggerConsole::Phase(const char* phaseName)
+{
+    ScopeLock lock(&csLog);
+    EndPhase();
+    phase_start_time = CPU::GetTicks();
+    xr_strcpy(phase, phaseName);
+    last_progress = -1;
+    Msg("\n* New phase started: %s", phaseName);
+}
+
+void LevelCompilerLoggerConsole::Success(const char* msg) { Msg("* %s", msg); }
+void LevelCompilerLoggerConsole::Failure(const char* msg) { Msg("! %s", msg); }
+
+LevelCompilerLoggerConsole& LevelCompilerLoggerConsole::instance()
+{
+    static LevelCompilerLoggerConsole instance;
+    return instance;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "ILevelCompilerLogger.hpp"
+#include "xrCore/Threading/Lock.hpp"
+
+// Writes to the log only, for the platforms without the log window and for unattended builds
+class XRLCUTIL_API LevelCompilerLoggerConsole : public ILevelCompilerLogger
+{
+private:
+    Lock csLog;
+    char phase[1024];
+    u32 phase_start_time = 0;
+    int last_progress = -1;
+
+protected:
+    LevelCompilerLoggerConsole();
+public:
+    virtual void Initialize(const char* name) override;
+    virtual void Destroy() override;
+    virtual void clMsg(const char* format, ...) override;
+    virtual void clMsgV(const char* format, va_list args) override;
+    virtual void clLog(const char* format, ...) override;
+    virtual void Status(const char* format, ...) override;
+    virtual void StatusV(const char* format, va_list args) override;
+    virtual void Progress(float progress) override;
+    virtual void Phase(const char* phaseName) override;
+    virtual void Success(const char* msg) override;
+    virtual void Failure(const char* msg) override;
+    static LevelCompilerLoggerConsole& instance();
+
+private:
+    void EndPhase();
+};
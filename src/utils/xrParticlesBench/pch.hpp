@@ -0,0 +1,5 @@
+#pragma once
+
+#include "Common/Common.hpp"
+#include "xrCore/xrCore.h"
+#include "xrCore/_std_extensions.h"
@@ -0,0 +1,215 @@
+#include "pch.hpp"
+
+#include "xrParticles/psystem.h"
+#include "utils/bench_harness.h"
+
+// Headless particles benchmark.
+// Loads effect definitions from particles.xr and plays every effect through PAPI
+// without renderer, first with scalar action kernels and then with SIMD ones.
+// Reports update timings for both and checks the resulting particles are bit-identical.
+//
+// Usage:
+//   xrParticlesBench [-file <particles.xr>] [-frames N] [-instances N]
+
+// Same as in Layers/xrRender/PSLibrary.h
+#define PS_VERSION 0x0001
+#define PS_CHUNK_VERSION 0x0001
+#define PS_CHUNK_SECONDGEN 0x0003
+
+// Same as in Layers/xrRender/ParticleEffectDef.h
+#define PED_VERSION 0x0001
+#define PED_CHUNK_VERSION 0x0001
+#define PED_CHUNK_NAME 0x0002
+#define PED_CHUNK_EFFECTDATA 0x0003
+#define PED_CHUNK_ACTIONLIST 0x0004
+
+namespace
+{
+struct effect_def
+{
+    shared_str name;
+    u32 max_particles;
+    xr_vector<u8> actions;
+};
+
+bool load_effects(pcstr file_name, xr_vector<effect_def>& effects)
+{
+    if (!FS.exist(file_name))
+    {
+        Msg("! Can't find file: '%s'", file_name);
+        return false;
+    }
+
+    IReader* F = FS.r_open(file_name);
+    R_ASSERT(F->find_chunk(PS_CHUNK_VERSION));
+    if (F->r_u16() != PS_VERSION)
+    {
+        Msg("! Unsupported particles version: '%s'", file_name);
+        FS.r_close(F);
+        return false;
+    }
+
+    // Only second generation effects have action lists, groups just reference them
+    IReader* OBJ = F->open_chunk(PS_CHUNK_SECONDGEN);
+    if (OBJ)
+    {
+        IReader* O = OBJ->open_chunk(0);
+        for (int count = 1; O; count++)
+        {
+            R_ASSERT(O->find_chunk(PED_CHUNK_VERSION));
+            if (O->r_u16() == PED_VERSION)
+            {
+                effect_def& def = effects.emplace_back();
+
+                R_ASSERT(O->find_chunk(PED_CHUNK_NAME));
+                O->r_stringZ(def.name);
+
+                R_ASSERT(O->find_chunk(PED_CHUNK_EFFECTDATA));
+                def.max_particles = O->r_u32();
+
+                const size_t size = O->find_chunk(PED_CHUNK_ACTIONLIST);
+                R_ASSERT(size);
+                def.actions.resize(size);
+                O->r(def.actions.data(), size);
+            }
+            O->close();
+            O = OBJ->open_chunk(count);
+        }
+        OBJ->close();
+    }
+    FS.r_close(F);
+    return true;
+}
+
+struct bench_result
+{
+    xr_vector<float> frame_times;
+    u64 particles{};
+
+    // Final state of every instance, used to compare scalar and SIMD runs
+    xr_vector<u32> counts;
+    xr_vector<PAPI::Particle> state;
+};
+
+void run(const xr_vector<effect_def>& effects, u32 instances, u32 frames, bool simd, bench_result& result)
+{
+    using namespace PAPI;
+    IParticleManager* PM = ParticleManager();
+    simd_actions = simd;
+
+    struct instance
+    {
+        int effect;
+        int alist;
+    };
+    xr_vector<instance> playing;
+    playing.reserve(effects.size() * instances);
+
+    // Action lists are seeded by their slots, both runs get the same ones
+    for (const effect_def& def : effects)
+    {
+        for (u32 i = 0; i < instances; ++i)
+        {
+            instance& it = playing.emplace_back();
+            it.effect = PM->CreateEffect(1);
+            it.alist = PM->CreateActionList();
+
+            IReader F(const_cast<u8*>(def.actions.data()), def.actions.size());
+            PM->LoadActions(it.alist, F);
+            PM->SetMaxParticles(it.effect, def.max_particles);
+
+            Fmatrix xform;
+            xform.translate(float(playing.size()), 0.f, 0.f);
+            PM->Transform(it.alist, xform, Fvector().set(0.f, 0.f, 0.f));
+            PM->PlayEffect(it.effect, it.alist);
+        }
+    }
+
+    // Same step as PS::fDT_STEP
+    constexpr float dt = 33.f / 1000.f;
+
+    result.frame_times.reserve(frames);
+    CTimer timer;
+    for (u32 frame = 0; frame < frames; ++frame)
+    {
+        timer.Start();
+        for (const instance& it : playing)
+            PM->Update(it.effect, it.alist, dt);
+        result.frame_times.push_back(timer.GetElapsed_sec() * 1000.f);
+
+        for (const instance& it : playing)
+            result.particles += PM->GetParticlesCount(it.effect);
+    }
+
+    for (const instance& it : playing)
+    {
+        Particle* particles;
+        u32 count;
+        PM->GetParticles(it.effect, particles, count);
+        result.counts.push_back(count);
+        result.state.insert(result.state.end(), particles, particles + count);
+
+        PM->DestroyEffect(it.effect);
+        PM->DestroyActionList(it.alist);
+    }
+}
+
+float report(pcstr name, const bench_result& result)
+{
+    const bench::timings frame = bench::summarize(result.frame_times);
+    const float particles_per_sec = frame.total > 0.f ? float(result.particles) / (frame.total / 1000.f) : 0.f;
+    Msg("* %-7s avg %2.3fms, p50 %2.3fms, p99 %2.3fms, %2.2fM particles/s", name, frame.avg, frame.p50, frame.p99,
+        particles_per_sec / 1000000.f);
+    return frame.total;
+}
+
+// Returns index of the first instance whose particles differ, or -1
+int compare(const bench_result& a, const bench_result& b)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < a.counts.size(); ++i)
+    {
+        if (a.counts[i] != b.counts[i])
+            return int(i);
+        if (0 != memcmp(a.state.data() + offset, b.state.data() + offset, a.counts[i] * sizeof(PAPI::Particle)))
+            return int(i);
+        offset += a.counts[i];
+    }
+    return -1;
+}
+} // namespace
+
+int run_benchmark()
+{
+    const u32 frames = bench::int_param("-frames", 300);
+    const u32 instances = std::max(bench::int_param("-instances", 4), 1);
+
+    string_path file_name;
+    if (!bench::str_param("-file", file_name))
+        FS.update_path(file_name, "$game_data$", "particles.xr");
+
+    xr_vector<effect_def> effects;
+    if (!load_effects(file_name, effects) || effects.empty())
+        return 1;
+
+    Msg("* Particles benchmark: %u effects, %u instances of each, %u frames", u32(effects.size()), instances, frames);
+
+    bench_result scalar, simd;
+    run(effects, instances, frames, false, scalar);
+    run(effects, instances, frames, true, simd);
+
+    const float scalar_total = report("scalar:", scalar);
+    const float simd_total = report("simd:", simd);
+    if (simd_total > 0.f)
+        Msg("* speedup: %2.2fx", scalar_total / simd_total);
+
+    const int differs = compare(scalar, simd);
+    if (differs >= 0)
+        Msg("! SIMD results differ from scalar in effect '%s'", effects[differs / instances].name.c_str());
+    else
+        Msg("* SIMD results are bit-identical to scalar");
+
+    return differs >= 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) { return bench::run("xrParticlesBench", argc, argv, run_benchmark); }
@@ -0,0 +1,315 @@
+#include "pch.hpp"
+
+#include "xrEngine/device.h"
+#include "xrEngine/GameMtlLib.h"
+#include "xrCDB/xr_area.h"
+#include "xrPhysics/IPHWorld.h"
+#include "xrPhysics/PhysicsShell.h"
+#include "xrPhysics/PHCharacter.h"
+#include "xrPhysics/IPhysicsShellHolder.h"
+#include "xrPhysics/console_vars.h"
+#include "utils/bench_harness.h"
+
+// Headless physics benchmark.
+// Loads a level cform into CObjectSpace, drops rigid bodies, jointed shells
+// and actor capsules on it and steps the physics world without renderer.
+//
+// Usage:
+//   xrPhysicsBench [-cform <file> | -level <name>] [-frames N] [-bodies N]
+//                  [-ragdolls N] [-actors N] [-seed N] [-st]
+
+namespace
+{
+// Physics needs an owner object for callbacks, this one does nothing
+class bench_object final : public IPhysicsShellHolder
+{
+    Fmatrix m_xform;
+    CPhysicsShell* m_shell{};
+    u16 m_id;
+    string32 m_name;
+
+public:
+    bench_object(u16 id, const Fmatrix& xform) : m_xform(xform), m_id(id) { xr_sprintf(m_name, "bench_object_%u", id); }
+
+    Fmatrix& ObjectXFORM() override { return m_xform; }
+    Fvector& ObjectPosition() override { return m_xform.c; }
+    LPCSTR ObjectName() const override { return m_name; }
+    LPCSTR ObjectNameVisual() const override { return m_name; }
+    LPCSTR ObjectNameSect() const override { return m_name; }
+    bool ObjectGetDestroy() const override { return false; }
+    ICollisionHitCallback* ObjectGetCollisionHitCallback() override { return nullptr; }
+    u16 ObjectID() const override { return m_id; }
+    IGameObject* IObject() override { return nullptr; }
+    ICollisionForm* ObjectCollisionModel() override { return nullptr; }
+    IKinematics* ObjectKinematics() override { return nullptr; }
+    IDamageSource* ObjectCastIDamageSource() override { return nullptr; }
+    void ObjectProcessingDeactivate() override {}
+    void ObjectProcessingActivate() override {}
+    void ObjectSpatialMove() override {}
+    CPhysicsShell*& ObjectPPhysicsShell() override { return m_shell; }
+    void enable_notificate() override {}
+    bool has_parent_object() override { return false; }
+    void on_physics_disable() override {}
+    IPHCapture* PHCapture() override { return nullptr; }
+    bool IsInventoryItem() override { return false; }
+    bool IsActor() override { return false; }
+    bool IsStalker() override { return false; }
+    bool IsCollideWithBullets() override { return false; }
+    bool IsCollideWithActorCamera() override { return false; }
+    void HideAllWeapons(bool v) override {}
+    void MovementCollisionEnable(bool enable) override {}
+    CPHSoundPlayer* ObjectPhSoundPlayer() override { return nullptr; }
+    ICollisionDamageReceiver* ObjectPhCollisionDamageReceiver() override { return nullptr; }
+    void BonceDamagerCallback(float& damage_factor) override {}
+#ifdef DEBUG
+    std::string dump(EDumpType type) const override { return m_name; }
+#endif
+};
+
+struct bench_scene
+{
+    CRandom random;
+    Fbox bounds;
+    xr_vector<bench_object*> objects;
+    xr_vector<CPhysicsShell*> shells;
+    xr_vector<CPHCharacter*> characters;
+
+    Fvector spawn_position(CObjectSpace& os)
+    {
+        Fvector pos;
+        pos.x = random.randF(bounds.x1, bounds.x2);
+        pos.z = random.randF(bounds.z1, bounds.z2);
+        pos.y = bounds.y2;
+
+        collide::rq_result R;
+        const Fvector down = { 0.f, -1.f, 0.f };
+        if (os.RayPick(pos, down, bounds.y2 - bounds.y1, collide::rqtStatic, R, nullptr))
+            pos.y -= R.range;
+        pos.y += random.randF(0.5f, 3.f);
+        return pos;
+    }
+
+    bench_object* create_object(const Fvector& pos)
+    {
+        Fmatrix xform;
+        xform.setHPB(random.randF(PI_MUL_2), random.randF(PI_MUL_2), random.randF(PI_MUL_2));
+        xform.c.set(pos);
+        objects.push_back(xr_new<bench_object>(u16(objects.size()), xform));
+        return objects.back();
+    }
+
+    void activate(bench_object* object, CPhysicsShell* shell)
+    {
+        Fvector lin_vel, ang_vel;
+        lin_vel.random_dir(random).mul(random.randF(0.f, 5.f));
+        ang_vel.random_dir(random).mul(random.randF(0.f, 3.f));
+
+        shell->set_PhysicsRefObject(object);
+        shell->Activate(object->ObjectXFORM(), lin_vel, ang_vel, false);
+        object->ObjectPPhysicsShell() = shell;
+        shells.push_back(shell);
+    }
+
+    void spawn_body(CObjectSpace& os)
+    {
+        bench_object* object = create_object(spawn_position(os));
+
+        CPhysicsElement* E = P_create_Element();
+        Fobb obb;
+        obb.identity();
+        obb.m_halfsize.set(random.randF(0.1f, 0.6f), random.randF(0.1f, 0.6f), random.randF(0.1f, 0.6f));
+        E->add_Box(obb);
+
+        CPhysicsShell* shell = P_create_Shell();
+        shell->add_Element(E);
+        shell->setDensity(1000.f);
+        activate(object, shell);
+    }
+
+    // A chain of boxes jointed the same way as CPhysicObject builds free chains
+    void spawn_ragdoll(CObjectSpace& os, u32 links)
+    {
+        bench_object* object = create_object(spawn_position(os));
+        CPhysicsShell* shell = P_create_Shell();
+
+        CPhysicsElement* parent = nullptr;
+        for (u32 i = 0; i < links; ++i)
+        {
+            CPhysicsElement* E = P_create_Element();
+            E->mXFORM.identity();
+            E->mXFORM.c.set(0.f, 0.3f * i, 0.f);
+
+            Fobb obb;
+            obb.identity();
+            obb.m_halfsize.set(0.1f, 0.15f, 0.1f);
+            E->add_Box(obb);
+            E->setMass(10.f);
+            E->set_ParentElement(parent);
+            shell->add_Element(E);
+
+            if (parent)
+            {
+                CPhysicsJoint* J = P_create_Joint(CPhysicsJoint::full_control, parent, E);
+                J->SetAnchorVsSecondElement(0, 0, 0);
+                J->SetAxisDirVsSecondElement(1, 0, 0, 0);
+                J->SetAxisDirVsSecondElement(0, 1, 0, 2);
+                J->SetLimits(-M_PI / 2, M_PI / 2, 0);
+                J->SetLimits(-M_PI / 2, M_PI / 2, 1);
+                J->SetLimits(-M_PI / 2, M_PI / 2, 2);
+                shell->add_Joint(J);
+            }
+            parent = E;
+        }
+        activate(object, shell);
+    }
+
+    void spawn_actor(CObjectSpace& os, u16 material)
+    {
+        bench_object* object = create_object(spawn_position(os));
+
+        CPHCharacter* character = create_actor_character(true);
+        character->SetPhysicsRefObject(object);
+        character->SetMas(80.f);
+        dVector3 size = { 0.7f, 1.9f, 0.7f };
+        character->Create(size);
+        character->SetMaterial(material);
+        character->SetPosition(object->ObjectPosition());
+        character->SetMaximumVelocity(5.f);
+        characters.push_back(character);
+    }
+
+    // Walk actors in random directions so they keep pushing bodies around
+    void update_actors()
+    {
+        for (CPHCharacter* character : characters)
+        {
+            Fvector accel;
+            accel.random_dir(random);
+            accel.y = 0.f;
+            accel.normalize_safe().mul(10.f);
+            character->SetAcceleration(accel);
+            character->SetCamDir(accel);
+        }
+    }
+
+    void destroy()
+    {
+        for (CPHCharacter* character : characters)
+        {
+            character->Destroy();
+            xr_delete(character);
+        }
+        for (CPhysicsShell* shell : shells)
+        {
+            shell->Deactivate();
+            destroy_physics_shell(shell);
+        }
+        for (bench_object* object : objects)
+            xr_delete(object);
+        characters.clear();
+        shells.clear();
+        objects.clear();
+    }
+};
+
+} // namespace
+
+int run_benchmark()
+{
+    const u32 frames = bench::int_param("-frames", 3000);
+    const u32 bodies = bench::int_param("-bodies", 200);
+    const u32 ragdolls = bench::int_param("-ragdolls", 40);
+    const u32 actors = bench::int_param("-actors", 20);
+    const u32 seed = bench::int_param("-seed", 0);
+    const bool single_thread = bench::has_param("-st");
+
+    GMLib.Load();
+
+    CObjectSpace* os = nullptr;
+    string_path cform = "";
+    string_path level = "";
+    if (bench::str_param("-cform", cform))
+        os = file_create_object_space(cform);
+    else if (bench::str_param("-level", level))
+    {
+        strconcat(sizeof(cform), cform, level, DELIMITER "level.cform");
+        FS.update_path(cform, "$game_levels$", cform);
+        os = file_create_object_space(cform);
+    }
+    else
+        os = create_object_space();
+
+    create_physics_world(false, os, nullptr);
+    IPHWorld* world = physics_world();
+    ph_console::ph_mt_islands = !single_thread;
+
+    bench_scene scene;
+    scene.random.seed(s32(seed));
+    scene.bounds.set(os->GetBoundingVolume());
+    scene.bounds.shrink(1.f);
+
+    const u16 actor_material = GMLib.GetMaterialIdx("materials" DELIMITER "actor");
+    for (u32 i = 0; i < bodies; ++i)
+        scene.spawn_body(*os);
+    for (u32 i = 0; i < ragdolls; ++i)
+        scene.spawn_ragdoll(*os, 8);
+    for (u32 i = 0; i < actors; ++i)
+        scene.spawn_actor(*os, actor_material);
+
+    Msg("* Physics benchmark: %u frames, %u bodies, %u ragdolls, %u actors, %s", frames, bodies, ragdolls, actors,
+        single_thread ? "single thread" : "parallel");
+
+    xr_vector<float> frame_times, collision_times, solver_times;
+    frame_times.reserve(frames);
+    collision_times.reserve(frames);
+    solver_times.reserve(frames);
+    u64 contacts = 0, islands = 0, active_bodies = 0;
+    u32 max_contacts = 0;
+
+    // Fixed frame delta keeps the amount of physics steps per frame constant
+    constexpr float frame_delta = 1.f / 60.f;
+    CTimer timer;
+    for (u32 frame = 0; frame < frames; ++frame)
+    {
+        if (frame % 60 == 0)
+            scene.update_actors();
+
+        Device.fTimeDelta = frame_delta;
+        Device.fTimeGlobal += frame_delta;
+        Device.dwTimeGlobal = iFloor(Device.fTimeGlobal * 1000.f);
+        Device.dwFrame = frame;
+
+        timer.Start();
+        Device.seqFrame.Process();
+        frame_times.push_back(timer.GetElapsed_sec() * 1000.f);
+
+        const auto& stats = world->GetStats();
+        collision_times.push_back(stats.Collision.result);
+        solver_times.push_back(stats.Core.result);
+        contacts += stats.Contacts;
+        islands += stats.Islands;
+        active_bodies += stats.Bodies;
+        max_contacts = std::max(max_contacts, stats.Contacts);
+    }
+
+    const float frames_count = float(std::max(frames, 1u));
+    const bench::timings frame = bench::summarize(frame_times);
+    const bench::timings collision = bench::summarize(collision_times);
+    const bench::timings solver = bench::summarize(solver_times);
+
+    Msg("* frame:     avg %2.3fms, p50 %2.3fms, p90 %2.3fms, p99 %2.3fms, max %2.3fms", frame.avg, frame.p50,
+        frame.p90, frame.p99, frame.max);
+    Msg("* collider:  p50 %2.3fms, p99 %2.3fms", collision.p50, collision.p99);
+    Msg("* solver:    p50 %2.3fms, p99 %2.3fms", solver.p50, solver.p99);
+    Msg("* contacts:  %2.1f per frame, max %u", contacts / frames_count, max_contacts);
+    Msg("* islands:   %2.1f per frame, %2.1f active bodies per frame", islands / frames_count,
+        active_bodies / frames_count);
+
+    scene.destroy();
+    destroy_physics_world();
+    destroy_object_space(os);
+    GMLib.Unload();
+    return 0;
+}
+
+int main(int argc, char* argv[]) { return bench::run("xrPhysicsBench", argc, argv, run_benchmark); }
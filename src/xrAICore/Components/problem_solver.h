@@ -56,6 +56,38 @@ public:
     typedef typename OPERATOR_VECTOR::const_iterator const_iterator;
     typedef AssociativeVector<condition_type, condition_evaluator_ptr_type> EVALUATORS;
 
+    // Shared by all the solvers of the same type, reset by the one who shows them
+    struct SCacheStats
+    {
+        u32 solves; // world state or target changed
+        u32 hits; // solution taken from the plan cache
+        u32 searches;
+        u32 evaluations; // evaluator calls
+        u32 memoised; // evaluator calls avoided
+    };
+
+    enum
+    {
+        plan_cache_size = 4,
+    };
+
+private:
+    // Solution found for the target, valid while the evaluators return
+    // the same values for the properties the search looked at
+    struct SPlan
+    {
+        CState m_target;
+        CState m_state;
+        xr_vector<_operator_id_type> m_solution;
+        bool m_failed;
+    };
+
+    struct SEvaluation
+    {
+        u32 m_stamp;
+        value_type m_value;
+    };
+
 protected:
     OPERATOR_VECTOR m_operators;
     EVALUATORS m_evaluators;
@@ -68,6 +100,16 @@ protected:
     bool m_solution_changed;
     bool m_failed;
 
+private:
+    xr_vector<SPlan> m_plans; // most recently used first
+    mutable xr_vector<SEvaluation> m_evaluations; // parallel to m_evaluators
+    mutable u32 m_evaluation_stamp;
+
+    IC const value_type& evaluate(typename EVALUATORS::const_iterator I) const;
+    IC bool actual(const CState& state) const;
+    IC bool find_plan();
+    IC void store_plan();
+
 private:
     template <bool a>
     IC bool is_goal_reached_impl(std::enable_if_t<!a, const _index_type&> vertex_index) const
@@ -147,6 +189,7 @@ public:
     IC void solve();
     IC const xr_vector<_operator_id_type>& solution() const;
     virtual void clear();
+    IC static SCacheStats& cache_stats();
 };
 
 #include "xrAICore/Components/problem_solver_inline.h"
@@ -38,7 +38,7 @@ IC void CProblemSolverAbstract::clear()
 }
 
 TEMPLATE_SPECIALIZATION
-void CProblemSolverAbstract::init() {}
+void CProblemSolverAbstract::init() { m_evaluation_stamp = 0; }
 TEMPLATE_SPECIALIZATION
 void CProblemSolverAbstract::setup()
 {
@@ -46,6 +46,7 @@ void CProblemSolverAbstract::setup()
     m_current_state.clear();
     m_temp.clear();
     m_solution.clear();
+    m_plans.clear();
     m_applied = false;
     m_solution_changed = false;
     m_actuality = true;
@@ -58,8 +59,14 @@ IC bool CProblemSolverAbstract::actual() const
     if (!m_actuality)
         return (false);
 
-    typename xr_vector<_operator_condition>::const_iterator I = current_state().conditions().begin();
-    typename xr_vector<_operator_condition>::const_iterator E = current_state().conditions().end();
+    return (actual(current_state()));
+}
+
+TEMPLATE_SPECIALIZATION
+IC bool CProblemSolverAbstract::actual(const CState& state) const
+{
+    typename xr_vector<_operator_condition>::const_iterator I = state.conditions().begin();
+    typename xr_vector<_operator_condition>::const_iterator E = state.conditions().end();
     typename EVALUATORS::const_iterator i = evaluators().begin();
     typename EVALUATORS::const_iterator e = evaluators().end();
     for (; I != E; ++I)
@@ -68,12 +75,30 @@ IC bool CProblemSolverAbstract::actual() const
             i = std::lower_bound(i, e, (*I).condition(), evaluators().value_comp());
         VERIFY(i != e);
         VERIFY((*i).first == (*I).condition());
-        if ((*i).second->evaluate() != (*I).value())
+        if (evaluate(i) != (*I).value())
             return (false);
     }
     return (true);
 }
 
+TEMPLATE_SPECIALIZATION
+IC const typename CProblemSolverAbstract::value_type& CProblemSolverAbstract::evaluate(
+    typename EVALUATORS::const_iterator I) const
+{
+    // evaluators are called once per solve, actual() and the search share the results
+    SEvaluation& evaluation = m_evaluations[I - evaluators().begin()];
+    if (evaluation.m_stamp == m_evaluation_stamp)
+    {
+        ++cache_stats().memoised;
+        return (evaluation.m_value);
+    }
+
+    ++cache_stats().evaluations;
+    evaluation.m_stamp = m_evaluation_stamp;
+    evaluation.m_value = (*I).second->evaluate();
+    return (evaluation.m_value);
+}
+
 TEMPLATE_SPECIALIZATION
 IC void CProblemSolverAbstract::add_operator(const _operator_id_type& operator_id, _operator_ptr _op)
 {
@@ -84,6 +109,7 @@ IC void CProblemSolverAbstract::add_operator(const _operator_id_type& operator_i
     validate_properties(_op->effects());
 #endif
     m_actuality = false;
+    m_plans.clear();
     m_operators.emplace(I, operator_id, _op);
 }
 
@@ -116,6 +142,7 @@ IC void CProblemSolverAbstract::remove_operator(const _operator_id_type& operato
         (*I).m_operator = 0;
     }
     m_actuality = false;
+    m_plans.clear();
     m_operators.erase(I);
 }
 
@@ -150,6 +177,8 @@ IC void CProblemSolverAbstract::add_evaluator(const condition_type& condition_id
 {
     THROW(evaluators().end() == evaluators().find(condition_id));
     m_evaluators.insert(std::make_pair(condition_id, evaluator));
+    m_evaluations.resize(m_evaluators.size());
+    ++m_evaluation_stamp;
 }
 
 TEMPLATE_SPECIALIZATION
@@ -166,7 +195,15 @@ IC void CProblemSolverAbstract::remove_evaluator(const condition_type& condition
         (*I).second = 0;
     }
     m_evaluators.erase(I);
+    m_evaluations.resize(m_evaluators.size());
+    ++m_evaluation_stamp;
     m_actuality = false;
+
+    m_plans.erase(std::remove_if(m_plans.begin(), m_plans.end(),
+                      [&](const SPlan& plan) {
+                          return (plan.m_state.property(condition_id) || plan.m_target.property(condition_id));
+                      }),
+        m_plans.end());
 }
 
 TEMPLATE_SPECIALIZATION
@@ -188,8 +225,10 @@ TEMPLATE_SPECIALIZATION
 IC void CProblemSolverAbstract::evaluate_condition(typename xr_vector<_operator_condition>::const_iterator& I,
     typename xr_vector<_operator_condition>::const_iterator& E, const condition_type& condition_id) const
 {
+    typename EVALUATORS::const_iterator J = evaluators().find(condition_id);
+    THROW(evaluators().end() != J);
     size_t index = I - m_current_state.conditions().begin();
-    m_current_state.add_condition(I, _operator_condition(condition_id, evaluator(condition_id)->evaluate()));
+    m_current_state.add_condition(I, _operator_condition(condition_id, evaluate(J)));
     I = m_current_state.conditions().begin() + index;
     E = m_current_state.conditions().end();
 }
@@ -357,12 +396,22 @@ IC void CProblemSolverAbstract::solve()
 {
 #ifndef AI_COMPILER
     m_solution_changed = false;
+    ++m_evaluation_stamp;
 
     if (actual())
         return;
 
     m_actuality = true;
     m_solution_changed = true;
+    ++cache_stats().solves;
+
+    if (find_plan())
+    {
+        ++cache_stats().hits;
+        return;
+    }
+
+    ++cache_stats().searches;
     m_current_state.clear();
 
     // Call to ai() was replaced with GEnv.AISpace
@@ -371,9 +420,51 @@ IC void CProblemSolverAbstract::solve()
         reverse_search ? current_state() : target_state(), &m_solution,
         GraphEngineSpace::CSolverBaseParameters(
             GraphEngineSpace::_solver_dist_type(-1), GraphEngineSpace::_solver_condition_type(-1), 8000));
+
+    store_plan();
 #endif
 }
 
+TEMPLATE_SPECIALIZATION
+IC bool CProblemSolverAbstract::find_plan()
+{
+    for (auto I = m_plans.begin(), E = m_plans.end(); I != E; ++I)
+    {
+        if (!((*I).m_target == target_state()) || !actual((*I).m_state))
+            continue;
+
+        // the search would look at the same properties and get the same values
+        m_current_state = (*I).m_state;
+        m_solution = (*I).m_solution;
+        m_failed = (*I).m_failed;
+        std::rotate(m_plans.begin(), I, I + 1);
+        return (true);
+    }
+    return (false);
+}
+
+TEMPLATE_SPECIALIZATION
+IC void CProblemSolverAbstract::store_plan()
+{
+    // reuse the least recently used plan to keep its buffers
+    if (m_plans.size() < plan_cache_size)
+        m_plans.emplace_back();
+    std::rotate(m_plans.begin(), m_plans.end() - 1, m_plans.end());
+
+    SPlan& plan = m_plans.front();
+    plan.m_target = target_state();
+    plan.m_state = m_current_state;
+    plan.m_solution = m_solution;
+    plan.m_failed = m_failed;
+}
+
+TEMPLATE_SPECIALIZATION
+IC typename CProblemSolverAbstract::SCacheStats& CProblemSolverAbstract::cache_stats()
+{
+    static SCacheStats stats{};
+    return (stats);
+}
+
 TEMPLATE_SPECIALIZATION
 IC typename CProblemSolverAbstract::edge_value_type CProblemSolverAbstract::estimate_edge_weight(
     const _index_type& condition) const
@@ -5,6 +5,7 @@
 
 #include "xrCDB.h"
 #include "xrCore/Threading/Lock.hpp"
+#include "xrCore/Memory/MemoryRegion.h"
 
 namespace Opcode
 {
@@ -27,16 +28,36 @@ MODEL::MODEL() :
     tris_count = 0;
     verts = 0;
     verts_count = 0;
+    region = nullptr;
     status = S_INIT;
 }
+
+template <typename T>
+T* MODEL::data_alloc(size_t count) const
+{
+    if (region)
+        return static_cast<T*>(region->alloc(count * sizeof(T), alignof(T)));
+    return xr_alloc<T>(count);
+}
+
+// Region memory is released with the region itself
+template <typename T>
+void MODEL::data_free(T*& ptr) const
+{
+    if (region)
+        ptr = nullptr;
+    else
+        xr_free(ptr);
+}
+
 MODEL::~MODEL()
 {
     syncronize(); // maybe model still in building
     status = S_INIT;
     xr_delete(tree);
-    xr_free(tris);
+    data_free(tris);
     tris_count = 0;
-    xr_free(verts);
+    data_free(verts);
     verts_count = 0;
     delete pcs;
 }
@@ -102,14 +123,16 @@ void MODEL::build(Fvector* V, int Vcnt, TRI* T, int Tcnt, build_callback* bc, vo
 
 void MODEL::build_internal(Fvector* V, int Vcnt, TRI* T, int Tcnt, build_callback* bc, void* bcp)
 {
+    MemoryTagScope scope(MemoryTag::CDB);
+
     // verts
     verts_count = Vcnt;
-    verts = xr_alloc<Fvector>(verts_count);
+    verts = data_alloc<Fvector>(verts_count);
     CopyMemory(verts, V, verts_count * sizeof(Fvector));
 
     // tris
     tris_count = Tcnt;
-    tris = xr_alloc<TRI>(tris_count);
+    tris = data_alloc<TRI>(tris_count);
     CopyMemory(tris, T, tris_count * sizeof(TRI));
 
     // callback
@@ -123,8 +146,8 @@ void MODEL::build_internal(Fvector* V, int Vcnt, TRI* T, int Tcnt, build_callbac
     u32* temp_tris = xr_alloc<u32>(tris_count * 3);
     if (0 == temp_tris)
     {
-        xr_free(verts);
-        xr_free(tris);
+        data_free(verts);
+        data_free(tris);
         return;
     }
     u32* temp_ptr = temp_tris;
@@ -148,8 +171,8 @@ void MODEL::build_internal(Fvector* V, int Vcnt, TRI* T, int Tcnt, build_callbac
     tree = xr_new<OPCODE_Model>();
     if (!tree->Build(OPCC))
     {
-        xr_free(verts);
-        xr_free(tris);
+        data_free(verts);
+        data_free(tris);
         xr_free(temp_tris);
         return;
     };
@@ -212,18 +235,18 @@ bool MODEL::deserialize(pcstr fileName)
         return false;
     }
 
-    xr_free(verts);
-    xr_free(tris);
+    data_free(verts);
+    data_free(tris);
     xr_free(tree);
 
     verts_count = rstream->r_u32();
-    verts = xr_alloc<Fvector>(verts_count);
+    verts = data_alloc<Fvector>(verts_count);
     const u32 vertsSize = verts_count * sizeof(Fvector);
     CopyMemory(verts, rstream->pointer(), vertsSize);
     rstream->advance(vertsSize);
 
     tris_count = rstream->r_u32();
-    tris = xr_alloc<TRI>(tris_count);
+    tris = data_alloc<TRI>(tris_count);
     const u32 trisSize = tris_count * sizeof(TRI);
     CopyMemory(tris, rstream->pointer(), trisSize);
     rstream->advance(trisSize);
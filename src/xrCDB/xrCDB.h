@@ -26,6 +26,7 @@ class AABBNoLeafNode;
 template <class T> class _box3;
 using Fbox = _box3<float>;
 class Lock;
+class xrMemoryRegion;
 
 
 #pragma pack(push, 8)
@@ -74,6 +75,7 @@ private:
     Opcode::OPCODE_Model* tree;
     volatile u32 status; // 0=ready, 1=init, 2=building
     u32 version;
+    xrMemoryRegion* region; // verts and tris are allocated there, if set
 
     // tris
     TRI* tris;
@@ -103,11 +105,17 @@ public:
     u32 memory();
 
     void set_version(u32 value) { version = value; }
+    // Must be set before the model is built, the region must outlive the model
+    void set_region(xrMemoryRegion* value) { region = value; }
     bool serialize(pcstr fileName) const;
     bool deserialize(pcstr fileName);
 
 private:
     void syncronize_impl() const;
+    template <typename T>
+    T* data_alloc(size_t count) const;
+    template <typename T>
+    void data_free(T*& ptr) const;
 };
 
 // Collider result
@@ -17,6 +17,9 @@
 
 #define CFS_CompressMark (1ul << 31ul)
 #define CFS_HeaderChunkID (666)
+// Set in size_compressed of archive entries compressed in independent blocks, see CBlockStreamReader
+#define CFS_BlockCompressMark (1ul << 31ul)
+#define CFS_BlockSize (64 * 1024)
 
 XRCORE_API void VerifyPath(pcstr path);
 
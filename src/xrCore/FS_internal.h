@@ -12,6 +12,10 @@
 #include <share.h>
 #endif
 
+#include "xrCore/Threading/Lock.hpp"
+#include "xrCommon/xr_list.h"
+#include "xrCommon/xr_unordered_map.h"
+
 #if defined(XR_PLATFORM_FREEBSD)
 #define _sys_errlist sys_errlist
 #endif
@@ -26,9 +30,10 @@ private:
     FILE* hf;
 
 public:
-    CFileWriter(const char* name, bool exclusive)
+    CFileWriter(const char* name, bool exclusive, bool append = false)
     {
         R_ASSERT(name && name[0]);
+        VERIFY2(!exclusive || !append, "Exclusive writer always truncates the file");
         fName = name;
         VerifyPath(fName.c_str());
         pstr conv_fn = xr_strdup(name);
@@ -44,7 +49,7 @@ public:
         }
         else
         {
-            hf = fopen(conv_fn, "wb");
+            hf = fopen(conv_fn, append ? "ab" : "wb");
             if (hf == 0)
             {
                 string1024 error;
@@ -138,6 +143,68 @@ public:
     CCompressedReader(const char* name, const char* sign);
     ~CCompressedReader() override;
 };
+// Size-bounded LRU cache of decompressed archive files.
+// Readers are views into shared buffers, so repeated opens don't decompress anything.
+// Entries in use are never evicted, the cache may grow over its budget while they are referenced.
+class CDecompressedCache
+{
+public:
+    struct entry
+    {
+        u8* data;
+        size_t size;
+        u64 key;
+        u32 refs;
+        bool orphan; // purged while referenced, freed on last release
+    };
+
+    struct stats
+    {
+        u32 hits;
+        u32 misses;
+        size_t size;
+    };
+
+private:
+    using lru_list = xr_list<entry>;
+    lru_list m_lru; // most recently used first
+    xr_unordered_map<u64, lru_list::iterator> m_entries;
+    size_t m_size{};
+    size_t m_budget;
+    stats m_stats{};
+    mutable Lock m_lock;
+
+    void evict();
+
+public:
+    CDecompressedCache(size_t budget) : m_budget(budget) {}
+    ~CDecompressedCache();
+
+    static u64 make_key(size_t vfs, u32 ptr) { return (u64(vfs) << 32) | ptr; }
+    bool cacheable(size_t size) const { return size <= m_budget / 8; }
+
+    // Returns nullptr if the file isn't cached
+    IReader* open(u64 key);
+    // Takes ownership of the data allocated with xr_alloc
+    IReader* insert(u64 key, u8* data, size_t size);
+    void release(entry& e);
+    // Drops entries of the unloaded archive
+    void purge(size_t vfs);
+
+    stats get_stats() const;
+};
+
+class CCachedReader final : public IReader
+{
+    CDecompressedCache& cache;
+    CDecompressedCache::entry& cached;
+
+public:
+    CCachedReader(CDecompressedCache& _cache, CDecompressedCache::entry& _cached)
+        : IReader(_cached.data, _cached.size), cache(_cache), cached(_cached) {}
+    ~CCachedReader() override { cache.release(cached); }
+};
+
 class CVirtualFileReader final : public IReader
 {
 private:
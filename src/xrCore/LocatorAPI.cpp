@@ -17,7 +17,12 @@
 #include "FS_internal.h"
 #include "stream_reader.h"
 #include "file_stream_reader.h"
+#include "block_stream_reader.h"
 #include "xrCore/Threading/Lock.hpp"
+#include "xrCore/Threading/ScopeLock.hpp"
+#include "xrCore/Threading/TaskManager.hpp"
+#include "xrCore/Threading/ParallelFor.hpp"
+#include <thread>
 #include "Crypto/trivial_encryptor.h"
 
 #if defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
@@ -29,6 +34,7 @@
 constexpr size_t VFS_STANDARD_FILE = std::numeric_limits<size_t>::max();
 
 const u32 BIG_FILE_READER_WINDOW_SIZE = 1024 * 1024;
+const u32 DECOMPRESSED_CACHE_SIZE = 32 * 1024 * 1024;
 
 xr_unique_ptr<CLocatorAPI> xr_FS;
 
@@ -163,9 +169,19 @@ CLocatorAPI::CLocatorAPI() : bNoRecurse(true), m_auth_code(0),
 #ifdef CONFIG_PROFILE_LOCKS
     m_auth_lock(xr_new<Lock>(MUTEX_PROFILE_ID(CLocatorAPI::m_auth_lock)))
 #else
-    m_auth_lock(xr_new<Lock>())
+    m_auth_lock(xr_new<Lock>()),
 #endif // CONFIG_PROFILE_LOCKS
+    m_mmap_calls(0), m_bytes_decompressed(0)
 {
+    u32 cache_size = DECOMPRESSED_CACHE_SIZE;
+    if (strstr(Core.Params, "-fs_cache_size "))
+    {
+        u32 megabytes = 0;
+        sscanf(strstr(Core.Params, "-fs_cache_size ") + 15, "%u", &megabytes);
+        cache_size = megabytes * 1024 * 1024;
+    }
+    m_decompressed_cache = xr_new<CDecompressedCache>(cache_size);
+
     m_Flags.zero();
 #if defined(XR_PLATFORM_WINDOWS)
     // get page size
@@ -184,6 +200,7 @@ CLocatorAPI::~CLocatorAPI()
     VERIFY(0 == m_iLockRescan);
     _dump_open_files(1);
     delete m_auth_lock;
+    xr_delete(m_decompressed_cache);
 }
 
 const CLocatorAPI::file* CLocatorAPI::RegisterExternal(pcstr name)
@@ -449,6 +466,7 @@ void CLocatorAPI::LoadArchive(archive& A, pcstr entrypoint)
 
     // Read FileSystem
     A.open();
+    map_archive(A);
     IReader* hdr = open_chunk(A.hSrcFile, 1, A.path.c_str(), A.size, shouldDecrypt);
 
     R_ASSERT(hdr);
@@ -508,8 +526,46 @@ void CLocatorAPI::archive::open()
     R_ASSERT(size > 0);
 }
 
+void CLocatorAPI::map_archive(archive& A)
+{
+    // 32-bit address space can't take the whole gamedata
+    if (sizeof(void*) < 8 || A.data)
+        return;
+
+#if defined(XR_PLATFORM_WINDOWS)
+    A.data = (u8*)MapViewOfFile(A.hSrcMap, FILE_MAP_READ, 0, 0, 0);
+#elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+    A.data = (u8*)::mmap(nullptr, A.size, PROT_READ, MAP_SHARED, A.hSrcFile, 0);
+    if (A.data == MAP_FAILED)
+        A.data = nullptr;
+#endif
+    ++m_mmap_calls;
+
+    if (!A.data)
+    {
+        Msg("! Can't map archive [%s], falling back to mapping files on open", A.path.c_str());
+        return;
+    }
+#ifdef FS_DEBUG
+    register_file_mapping(A.data, A.size, A.path.c_str());
+#endif // DEBUG
+}
+
 void CLocatorAPI::archive::close()
 {
+    if (data)
+    {
+#ifdef FS_DEBUG
+        unregister_file_mapping(data, size);
+#endif // DEBUG
+#if defined(XR_PLATFORM_WINDOWS)
+        UnmapViewOfFile(data);
+#elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+        ::munmap(data, size);
+#endif
+        data = nullptr;
+    }
+
 #if defined(XR_PLATFORM_WINDOWS)
     CloseHandle(hSrcMap);
     hSrcMap = nullptr;
@@ -570,9 +626,22 @@ void CLocatorAPI::unload_archive(CLocatorAPI::archive& A)
             break;
         }
     }
+    m_decompressed_cache->purge(A.vfs_idx);
     A.close();
 }
 
+CLocatorAPI::archive_stats CLocatorAPI::get_archive_stats() const
+{
+    const CDecompressedCache::stats cache = m_decompressed_cache->get_stats();
+    archive_stats result;
+    result.cache_hits = cache.hits;
+    result.cache_misses = cache.misses;
+    result.bytes_decompressed = m_bytes_decompressed;
+    result.cache_size = cache.size;
+    result.mmap_calls = m_mmap_calls;
+    return result;
+}
+
 bool CLocatorAPI::load_all_unloaded_archives()
 {
     bool res = false;
@@ -1328,13 +1397,159 @@ template <typename T> void CLocatorAPI::file_from_cache(T*& R, pstr fname, const
     file_from_cache_impl(R, fname, desc);
 }
 
+CDecompressedCache::~CDecompressedCache()
+{
+    for (entry& e : m_lru)
+    {
+        VERIFY2(!e.refs, "Decompressed file is still opened");
+        xr_free(e.data);
+    }
+}
+
+void CDecompressedCache::evict()
+{
+    // Walk from the least recently used end, skipping opened files
+    for (auto it = m_lru.end(); it != m_lru.begin() && m_size > m_budget;)
+    {
+        --it;
+        if (it->refs)
+            continue;
+
+        m_size -= it->size;
+        m_entries.erase(it->key);
+        xr_free(it->data);
+        it = m_lru.erase(it);
+    }
+}
+
+IReader* CDecompressedCache::open(u64 key)
+{
+    ScopeLock lock(&m_lock);
+    const auto found = m_entries.find(key);
+    if (found == m_entries.end())
+    {
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    ++m_stats.hits;
+    m_lru.splice(m_lru.begin(), m_lru, found->second);
+    entry& e = *found->second;
+    ++e.refs;
+    return xr_new<CCachedReader>(*this, e);
+}
+
+IReader* CDecompressedCache::insert(u64 key, u8* data, size_t size)
+{
+    ScopeLock lock(&m_lock);
+    const auto found = m_entries.find(key);
+    if (found != m_entries.end())
+    {
+        // Another thread decompressed the same file meanwhile
+        xr_free(data);
+        entry& e = *found->second;
+        ++e.refs;
+        return xr_new<CCachedReader>(*this, e);
+    }
+
+    m_lru.push_front({ data, size, key, 1, false });
+    m_entries.emplace(key, m_lru.begin());
+    m_size += size;
+    evict();
+    return xr_new<CCachedReader>(*this, m_lru.front());
+}
+
+void CDecompressedCache::release(entry& e)
+{
+    ScopeLock lock(&m_lock);
+    VERIFY(e.refs);
+    if (--e.refs)
+        return;
+
+    if (e.orphan)
+    {
+        xr_free(e.data);
+        m_lru.remove_if([&e](const entry& it) { return &it == &e; });
+        return;
+    }
+    evict();
+}
+
+void CDecompressedCache::purge(size_t vfs)
+{
+    ScopeLock lock(&m_lock);
+    for (auto it = m_lru.begin(); it != m_lru.end();)
+    {
+        if (it->orphan || it->key >> 32 != vfs)
+        {
+            ++it;
+            continue;
+        }
+
+        m_entries.erase(it->key);
+        m_size -= it->size;
+        if (it->refs)
+        {
+            it->orphan = true;
+            ++it;
+            continue;
+        }
+        xr_free(it->data);
+        it = m_lru.erase(it);
+    }
+}
+
+CDecompressedCache::stats CDecompressedCache::get_stats() const
+{
+    ScopeLock lock(&m_lock);
+    stats result = m_stats;
+    result.size = m_size;
+    return result;
+}
+
 void CLocatorAPI::file_from_archive(IReader*& R, pcstr fname, const file& desc)
 {
     // Archived one
     archive& A = m_archives[desc.vfs];
+    const bool blocks = desc.size_compressed & CFS_BlockCompressMark;
+    const u32 size_stored = desc.size_compressed & ~CFS_BlockCompressMark;
+    const bool compressed = desc.size_real != desc.size_compressed;
+    const bool cacheable = compressed && m_decompressed_cache->cacheable(desc.size_real);
+    const u64 key = CDecompressedCache::make_key(desc.vfs, desc.ptr);
+    if (cacheable)
+    {
+        R = m_decompressed_cache->open(key);
+        if (R)
+            return;
+    }
+
+    const auto decompress = [&](const u8* src)
+    {
+        u8* dest = xr_alloc<u8>(desc.size_real);
+        if (blocks)
+            CBlockStreamReader::decompress(dest, desc.size_real, src);
+        else
+            rtc_decompress(dest, desc.size_real, src, size_stored);
+        m_bytes_decompressed += desc.size_real;
+        if (cacheable)
+            R = m_decompressed_cache->insert(key, dest, desc.size_real);
+        else
+            R = xr_new<CTempReader>(dest, desc.size_real, 0);
+    };
+
+    if (A.data)
+    {
+        // Archive is mapped for its lifetime, readers are views into it
+        if (compressed)
+            decompress(A.data + desc.ptr);
+        else
+            R = xr_new<IReader>(A.data + desc.ptr, desc.size_real);
+        return;
+    }
+
     size_t start = desc.ptr / dwAllocGranularity * dwAllocGranularity;
-    size_t end = (desc.ptr + desc.size_compressed) / dwAllocGranularity;
-    if ((desc.ptr + desc.size_compressed) % dwAllocGranularity)
+    size_t end = (desc.ptr + size_stored) / dwAllocGranularity;
+    if ((desc.ptr + size_stored) % dwAllocGranularity)
         end += 1;
     end *= dwAllocGranularity;
     if (end > A.size)
@@ -1347,6 +1562,7 @@ void CLocatorAPI::file_from_archive(IReader*& R, pcstr fname, const file& desc)
     u8* ptr = (u8*)::mmap(NULL, sz, PROT_READ, MAP_SHARED, A.hSrcFile, start);
     VERIFY3(ptr && ptr != MAP_FAILED, "cannot create file mapping on file", fname);
 #endif
+    ++m_mmap_calls;
 
     string1024 temp;
     xr_sprintf(temp, sizeof temp, "%s:%s", *A.path, fname);
@@ -1356,16 +1572,14 @@ void CLocatorAPI::file_from_archive(IReader*& R, pcstr fname, const file& desc)
 #endif // DEBUG
 
     size_t ptr_offs = desc.ptr - start;
-    if (desc.size_real == desc.size_compressed)
+    if (!compressed)
     {
         R = xr_new<CPackReader>(ptr, ptr + ptr_offs, desc.size_real);
         return;
     }
 
     // Compressed
-    u8* dest = xr_alloc<u8>(desc.size_real);
-    rtc_decompress(dest, desc.size_real, ptr + ptr_offs, desc.size_compressed);
-    R = xr_new<CTempReader>(dest, desc.size_real, 0);
+    decompress(ptr + ptr_offs);
 #if defined(XR_PLATFORM_WINDOWS)
     UnmapViewOfFile(ptr);
 #elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
@@ -1380,8 +1594,20 @@ void CLocatorAPI::file_from_archive(IReader*& R, pcstr fname, const file& desc)
 void CLocatorAPI::file_from_archive(CStreamReader*& R, pcstr fname, const file& desc)
 {
     archive& A = m_archives[desc.vfs];
+    if (desc.size_compressed & CFS_BlockCompressMark)
+    {
+        CBlockStreamReader* r = xr_new<CBlockStreamReader>();
+#if defined(XR_PLATFORM_WINDOWS)
+        r->construct(A.hSrcMap, A.data, desc.ptr, desc.size_real, A.size);
+#elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+        r->construct(A.hSrcFile, A.data, desc.ptr, desc.size_real, A.size);
+#endif
+        R = r;
+        return;
+    }
+
     R_ASSERT2(desc.size_compressed == desc.size_real,
-        make_string("cannot use stream reading for compressed data %s, do not compress data to be streamed", fname));
+        make_string("cannot use stream reading for compressed data %s, compress it in blocks to be streamed", fname));
 
     R = xr_new<CStreamReader>();
 #if defined(XR_PLATFORM_WINDOWS)
@@ -1521,14 +1747,39 @@ T* CLocatorAPI::r_open_impl(pcstr path, pcstr _fname)
     if (!check_for_file(path, _fname, fname, desc))
         return nullptr;
 
+    open_file(R, fname, sizeof fname, *desc, source_name);
+    on_file_opened(R, fname, source_name);
+    return (R);
+}
+
+template <typename T>
+void CLocatorAPI::open_file(T*& R, pstr fname, const size_t& fname_size, const file& desc, pcstr& source_name)
+{
     // OK, analyse
-    if (VFS_STANDARD_FILE == desc->vfs)
-        file_from_cache(R, fname, sizeof fname, *desc, source_name);
+    if (VFS_STANDARD_FILE == desc.vfs)
+        file_from_cache(R, fname, fname_size, desc, source_name);
     else
-        file_from_archive(R, fname, *desc);
+        file_from_archive(R, fname, desc);
 
-    R->set_age(desc->modif);
+    R->set_age(desc.modif);
+}
+
+namespace
+{
+void touch_pages(const u8* data, size_t size)
+{
+    u8 sum = 0;
+    for (size_t offset = 0; offset < size; offset += 4096)
+        sum ^= data[offset];
+    volatile u8 sink = sum;
+    UNUSED(sink);
+}
+} // namespace
 
+// Not thread-safe, asynchronously opened files get here when they are taken by the caller
+template <typename T>
+void CLocatorAPI::on_file_opened(T* R, pcstr fname, pcstr source_name)
+{
 #ifdef DEBUG
     if (R && m_Flags.is(flBuildCopy | flReady))
         copy_file_to_build(R, source_name);
@@ -1536,8 +1787,122 @@ T* CLocatorAPI::r_open_impl(pcstr path, pcstr _fname)
 
     if (m_Flags.test(flDumpFileActivity))
         _register_open_file(R, fname);
+}
 
-    return (R);
+xr_unique_ptr<CAsyncBatch> CLocatorAPI::r_open_async(pcstr initial, const xr_vector<pcstr>& names)
+{
+    auto batch = xr_make_unique<CAsyncBatch>(names.size());
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        CAsyncBatch::request& request = (*batch)[i];
+        request.m_source_name = request.m_name;
+        if (!check_for_file(initial, names[i], request.m_name, request.m_desc))
+        {
+            request.m_desc = nullptr;
+            request.m_done.store(true, std::memory_order_release);
+            continue;
+        }
+
+#if defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+        // Let the kernel start reading archive data before the tasks touch it
+        const file& desc = *request.m_desc;
+        if (VFS_STANDARD_FILE != desc.vfs && m_archives[desc.vfs].data)
+        {
+            const size_t start = desc.ptr / dwAllocGranularity * dwAllocGranularity;
+            const size_t end = desc.ptr + (desc.size_compressed & ~CFS_BlockCompressMark);
+            ::madvise(m_archives[desc.vfs].data + start, end - start, MADV_WILLNEED);
+        }
+#endif
+    }
+
+    if (TaskScheduler)
+        TaskScheduler->AddTask("CLocatorAPI::r_open_async", { batch.get(), &CAsyncBatch::process });
+    else
+        batch->open_all();
+    return batch;
+}
+
+CAsyncBatch::~CAsyncBatch()
+{
+    wait(m_done);
+    // These were never registered, so not r_close()
+    for (request& it : m_requests)
+        xr_delete(it.m_reader);
+}
+
+void CAsyncBatch::wait(const std::atomic_bool& done)
+{
+    while (!done.load(std::memory_order_acquire))
+    {
+        if (!TaskScheduler || !TaskScheduler->ExecuteOneTask())
+            std::this_thread::yield();
+    }
+}
+
+// Compressed files too big for the decompressed cache would be decompressed again by their loader,
+// so only their stored data is read ahead
+bool CLocatorAPI::read_ahead_stored(const file& desc)
+{
+    if (VFS_STANDARD_FILE == desc.vfs || desc.size_real == desc.size_compressed ||
+        m_decompressed_cache->cacheable(desc.size_real))
+    {
+        return false;
+    }
+
+    const archive& A = m_archives[desc.vfs];
+    if (A.data)
+        touch_pages(A.data + desc.ptr, desc.size_compressed & ~CFS_BlockCompressMark);
+    return true;
+}
+
+// Readers of these files share an entry of the decompressed cache
+bool CLocatorAPI::decompressed_cacheable(const file& desc) const
+{
+    return VFS_STANDARD_FILE != desc.vfs && desc.size_real != desc.size_compressed &&
+        m_decompressed_cache->cacheable(desc.size_real);
+}
+
+void CAsyncBatch::open_all()
+{
+    xr_parallel_for(TaskRange<size_t>(0, m_requests.size(), 1), [this](const TaskRange<size_t>& range)
+    {
+        for (size_t i = range.begin(); i != range.end(); ++i)
+        {
+            request& it = m_requests[i];
+            if (it.m_desc && !FS.read_ahead_stored(*it.m_desc))
+            {
+                IReader* R = nullptr;
+                FS.open_file(R, it.m_name, sizeof it.m_name, *it.m_desc, it.m_source_name);
+                if (FS.decompressed_cacheable(*it.m_desc))
+                {
+                    // The entry stays in the cache for get(), a reader kept until then
+                    // would pin it and let the batch go over the cache budget
+                    xr_delete(R);
+                }
+                else
+                {
+                    // Mapped files are read on page faults, take them here instead of the consumer
+                    touch_pages(static_cast<const u8*>(R->pointer()), R->length());
+                    it.m_reader = R;
+                }
+            }
+            it.m_done.store(true, std::memory_order_release);
+        }
+    });
+    m_done.store(true, std::memory_order_release);
+}
+
+IReader* CAsyncBatch::request::get()
+{
+    wait(m_done);
+    IReader* R = m_reader;
+    m_reader = nullptr;
+    if (!R && m_desc && !m_taken)
+        FS.open_file(R, m_name, sizeof m_name, *m_desc, m_source_name);
+    m_taken = true;
+    if (R)
+        FS.on_file_opened(R, m_name, m_source_name);
+    return R;
 }
 
 CStreamReader* CLocatorAPI::rs_open(pcstr path, pcstr _fname) { return r_open_impl<CStreamReader>(path, _fname); }
@@ -1590,6 +1955,22 @@ IWriter* CLocatorAPI::w_open_ex(pcstr path, pcstr _fname)
     return W;
 }
 
+IWriter* CLocatorAPI::w_open_append(pcstr path, pcstr _fname)
+{
+    string_path fname;
+    xr_strcpy(fname, _fname);
+    xr_fs_strlwr(fname); //,".$");
+
+    if (path && path[0])
+        update_path(fname, path, fname);
+    CFileWriter* W = xr_new<CFileWriter>(fname, false, true);
+#ifdef _EDITOR
+    if (!W->valid())
+        xr_delete(W);
+#endif
+    return W;
+}
+
 void CLocatorAPI::w_close(IWriter*& S)
 {
     if (S)
@@ -13,6 +13,7 @@
 #include "xrCommon/xr_smart_pointers.h"
 #include "xrCommon/predicates.h"
 #include "Common/Noncopyable.hpp"
+#include <atomic>
 
 #if defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
 #include <stdint.h>
@@ -52,6 +53,9 @@ struct _finddata32_t
 
 class CStreamReader;
 class Lock;
+class CDecompressedCache;
+class CAsyncBatch;
+class Task;
 
 enum class FSType
 {
@@ -80,6 +84,7 @@ public:
 class XRCORE_API CLocatorAPI : Noncopyable
 {
     friend class FS_Path;
+    friend class CAsyncBatch;
 
 public:
     // IMPORTNT: don't replace u32 with size_t for this struct
@@ -92,7 +97,7 @@ public:
         u32 crc; // contents CRC
         u32 ptr; // pointer inside vfs
         u32 size_real; //
-        u32 size_compressed; // if (size_real==size_compressed) - uncompressed
+        u32 size_compressed; // if (size_real==size_compressed) - uncompressed, may have CFS_BlockCompressMark
         u32 modif; // for editor
     };
 
@@ -108,6 +113,9 @@ public:
 #elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
         int hSrcFile = 0;
 #endif
+        // Whole archive is mapped while it's open on 64-bit platforms,
+        // otherwise each file is mapped separately on open
+        u8* data = nullptr;
         CInifile* header = nullptr;
         
         archive() = default;
@@ -153,6 +161,12 @@ private:
     Lock* m_auth_lock;
     u64 m_auth_code;
 
+    CDecompressedCache* m_decompressed_cache;
+    std::atomic<u32> m_mmap_calls;
+    std::atomic<u64> m_bytes_decompressed;
+
+    void map_archive(archive& A);
+
     const file* RegisterExternal(pcstr name);
     const file* Register(pcstr name, size_t vfs, u32 crc, u32 ptr, u32 size_real, u32 size_compressed, u32 modif);
     void ProcessArchive(pcstr path);
@@ -197,6 +211,12 @@ private:
 
     bool check_for_file(pcstr path, pcstr _fname, string_path& fname, const file*& desc);
 
+    template <typename T>
+    void open_file(T*& R, pstr fname, const size_t& fname_size, const file& desc, pcstr& source_name);
+    template <typename T>
+    void on_file_opened(T* R, pcstr fname, pcstr source_name);
+    bool read_ahead_stored(const file& desc);
+    bool decompressed_cacheable(const file& desc) const;
     template <typename T>
     T* r_open_impl(pcstr path, pcstr _fname);
 
@@ -213,6 +233,9 @@ public:
     CStreamReader* rs_open(pcstr initial, pcstr N);
     IReader* r_open(pcstr initial, pcstr N);
     IReader* r_open(pcstr N) { return r_open(nullptr, N); }
+    // Files are looked up right away, reading and decompression are done on the task scheduler.
+    // Use it to read files of the next loading stage while the current one is being processed.
+    xr_unique_ptr<CAsyncBatch> r_open_async(pcstr initial, const xr_vector<pcstr>& names);
     void r_close(IReader*& S);
     void r_close(CStreamReader*& fs);
 
@@ -220,6 +243,9 @@ public:
     IWriter* w_open(pcstr N) { return w_open(nullptr, N); }
     IWriter* w_open_ex(pcstr initial, pcstr N);
     IWriter* w_open_ex(pcstr N) { return w_open_ex(nullptr, N); }
+    // Writes to the end of the file, it's created if it doesn't exist
+    IWriter* w_open_append(pcstr initial, pcstr N);
+    IWriter* w_open_append(pcstr N) { return w_open_append(nullptr, N); }
     void w_close(IWriter*& S);
     // For registered files only
     const file* GetFileDesc(pcstr path);
@@ -260,6 +286,17 @@ public:
     bool load_all_unloaded_archives();
     void unload_archive(archive& A);
 
+    struct archive_stats
+    {
+        u32 cache_hits;
+        u32 cache_misses;
+        u64 bytes_decompressed;
+        size_t cache_size;
+        u32 mmap_calls;
+    };
+    // Counters since startup, callers compute rates
+    archive_stats get_archive_stats() const;
+
     void auth_generate(xr_vector<shared_str>& ignore, xr_vector<shared_str>& important);
     u64 auth_get();
     void auth_runtime(void*);
@@ -271,5 +308,51 @@ public:
     void unlock_rescan();
 };
 
+// Files opened by CLocatorAPI::r_open_async
+class XRCORE_API CAsyncBatch : Noncopyable
+{
+    friend class CLocatorAPI;
+
+public:
+    class XRCORE_API request : Noncopyable
+    {
+        friend class CAsyncBatch;
+        friend class CLocatorAPI;
+
+        string_path m_name;
+        pcstr m_source_name;
+        const CLocatorAPI::file* m_desc{};
+        IReader* m_reader{};
+        std::atomic_bool m_done{};
+        bool m_taken{};
+
+    public:
+        pcstr name() const { return m_name; }
+        bool found() const { return m_desc != nullptr; }
+        bool ready() const { return m_done.load(std::memory_order_acquire); }
+        // Waits for the file, the reader is passed to the caller and has to be closed with FS.r_close().
+        // Files which were only read ahead or left in the decompressed cache are opened here.
+        // Returns nullptr if the file doesn't exist or the reader is already taken.
+        IReader* get();
+    };
+
+private:
+    xr_vector<request> m_requests;
+    std::atomic_bool m_done{};
+
+    static void wait(const std::atomic_bool& done);
+    void open_all();
+    void process(Task&, void*) { open_all(); }
+
+public:
+    CAsyncBatch(size_t count) : m_requests(count) {}
+    // Waits for the remaining files and closes readers nobody took
+    ~CAsyncBatch();
+
+    size_t size() const { return m_requests.size(); }
+    request& operator[](size_t i) { return m_requests[i]; }
+    bool ready() const { return m_done.load(std::memory_order_acquire); }
+};
+
 extern XRCORE_API xr_unique_ptr<CLocatorAPI> xr_FS;
 #define FS (*xr_FS)
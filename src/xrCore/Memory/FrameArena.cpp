@@ -0,0 +1,155 @@
+#include "stdafx.h"
+#include "FrameArena.h"
+
+namespace
+{
+constexpr size_t ARENA_CHUNK_SIZE = 64 * 1024;
+
+#ifdef DEBUG
+// Each block is prefixed with the frame it was allocated in
+constexpr size_t ARENA_HEADER_SIZE = 16;
+constexpr u32 ARENA_HEADER_MAGIC = 0xF4A3E000;
+constexpr u8 ARENA_POISON = 0xDD;
+#endif
+
+std::atomic<u32> s_frame{};
+std::atomic<u32> s_allocations{};
+std::atomic_size_t s_bytes{};
+
+class FrameBuffer
+{
+    struct Chunk
+    {
+        u8* data;
+        size_t size;
+    };
+
+    xr_vector<Chunk> m_chunks;
+    size_t m_used{}; // in the last chunk
+    size_t m_capacity{};
+
+    void add_chunk(size_t size)
+    {
+        Chunk& chunk = m_chunks.emplace_back();
+        chunk.data = static_cast<u8*>(Memory.mem_alloc(size));
+        chunk.size = size;
+        m_used = 0;
+        m_capacity += size;
+    }
+
+public:
+    FrameBuffer() = default;
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    ~FrameBuffer()
+    {
+        for (Chunk& chunk : m_chunks)
+            Memory.mem_free(chunk.data);
+    }
+
+    void* alloc(size_t size, size_t alignment)
+    {
+        if (!m_chunks.empty())
+        {
+            const Chunk& chunk = m_chunks.back();
+            const size_t offset = (reinterpret_cast<size_t>(chunk.data) + m_used + alignment - 1) & ~(alignment - 1);
+            const size_t start = offset - reinterpret_cast<size_t>(chunk.data);
+            if (start + size <= chunk.size)
+            {
+                m_used = start + size;
+                return chunk.data + start;
+            }
+        }
+
+        // Out of space, next chunk is at least twice as big
+        add_chunk(std::max(size + alignment, m_chunks.empty() ? ARENA_CHUNK_SIZE : m_chunks.back().size * 2));
+        return alloc(size, alignment);
+    }
+
+    void rewind()
+    {
+#ifdef DEBUG
+        for (size_t i = 0; i < m_chunks.size(); ++i)
+        {
+            const Chunk& chunk = m_chunks[i];
+            memset(chunk.data, ARENA_POISON, i + 1 == m_chunks.size() ? m_used : chunk.size);
+        }
+#endif
+        m_used = 0;
+        if (m_chunks.size() < 2)
+            return;
+
+        // Merge chunks, so the next frames fit into a single one
+        for (Chunk& chunk : m_chunks)
+            Memory.mem_free(chunk.data);
+        m_chunks.clear();
+
+        const size_t capacity = m_capacity;
+        m_capacity = 0;
+        add_chunk(capacity);
+    }
+};
+
+class ThreadArena
+{
+    FrameBuffer m_buffers[2];
+    u32 m_current{};
+    u32 m_frame{};
+
+public:
+    void* alloc(size_t size, size_t alignment)
+    {
+        const u32 frame = s_frame.load(std::memory_order_relaxed);
+        if (m_frame != frame)
+        {
+            // Other buffer holds blocks of frame N - 2 or older
+            m_current ^= 1;
+            m_buffers[m_current].rewind();
+            m_frame = frame;
+        }
+
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_bytes.fetch_add(size, std::memory_order_relaxed);
+        return m_buffers[m_current].alloc(size, alignment);
+    }
+} static thread_local s_tl_arena;
+} // namespace
+
+u32 xrFrameArena::stat_allocations = 0;
+size_t xrFrameArena::stat_bytes = 0;
+
+void* xrFrameArena::alloc(size_t size, size_t alignment)
+{
+#ifdef DEBUG
+    VERIFY2(alignment <= ARENA_HEADER_SIZE, "Frame arena doesn't support this alignment");
+    u8* block = static_cast<u8*>(s_tl_arena.alloc(size + ARENA_HEADER_SIZE, ARENA_HEADER_SIZE));
+    u32* header = reinterpret_cast<u32*>(block);
+    header[0] = ARENA_HEADER_MAGIC;
+    header[1] = s_frame.load(std::memory_order_relaxed);
+    return block + ARENA_HEADER_SIZE;
+#else
+    return s_tl_arena.alloc(size, alignment);
+#endif
+}
+
+void xrFrameArena::free(void* ptr)
+{
+#ifdef DEBUG
+    if (!ptr)
+        return;
+
+    const u32* header = reinterpret_cast<const u32*>(static_cast<u8*>(ptr) - ARENA_HEADER_SIZE);
+    R_ASSERT2(header[0] == ARENA_HEADER_MAGIC, "Frame arena block is corrupted or was used after its frame");
+    R_ASSERT2(s_frame.load(std::memory_order_relaxed) - header[1] <= 1, "Frame arena block is used after its frame");
+#else
+    UNUSED(ptr);
+#endif
+}
+
+void xrFrameArena::FrameEnd()
+{
+    stat_allocations = s_allocations.exchange(0, std::memory_order_relaxed);
+    stat_bytes = s_bytes.exchange(0, std::memory_order_relaxed);
+    s_frame.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "xrCore/xrMemory.h"
+#include "xrCommon/xr_vector.h"
+
+// Linear allocator for temporaries which live no longer than the frame they were created in.
+// Every thread has its own pair of buffers, the buffer of the previous frame is kept intact,
+// so memory allocated in frame N is valid until the end of frame N + 1.
+// Deallocation is a no-op, buffers are rewound as a whole when the thread allocates in the next frame.
+// Debug builds poison rewound memory and check frame of each block on deallocation.
+class XRCORE_API xrFrameArena
+{
+public:
+    static void* alloc(size_t size, size_t alignment);
+    static void free(void* ptr);
+
+    // Called by the device at the end of each frame
+    static void FrameEnd();
+
+    // Statistics of the previous frame, each allocation is a heap call avoided
+    static u32 stat_allocations;
+    static size_t stat_bytes;
+};
+
+template <typename T>
+class frame_alloc
+{
+public:
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using value_type = T;
+
+    template <class Other>
+    struct rebind
+    {
+        using other = frame_alloc<Other>;
+    };
+
+    frame_alloc() = default;
+    frame_alloc(const frame_alloc<T>&) = default;
+
+    template <class Other>
+    frame_alloc(const frame_alloc<Other>&)
+    {
+    }
+
+    template <class Other>
+    frame_alloc& operator=(const frame_alloc<Other>&)
+    {
+        return *this;
+    }
+
+    static pointer allocate(const size_type n, const void* /*p*/ = nullptr)
+    {
+        return static_cast<pointer>(xrFrameArena::alloc(n * sizeof(T), alignof(T)));
+    }
+
+    static void deallocate(pointer p, const size_type /*n*/) { xrFrameArena::free(p); }
+
+    static constexpr size_type max_size()
+    {
+        constexpr auto count = std::numeric_limits<size_type>::max() / sizeof(T);
+        return count > 0 ? count : 1;
+    }
+};
+
+template <class T, class Other>
+bool operator==(const frame_alloc<T>&, const frame_alloc<Other>&)
+{
+    return true;
+}
+
+template <class T, class Other>
+bool operator!=(const frame_alloc<T>&, const frame_alloc<Other>&)
+{
+    return false;
+}
+
+// Don't keep these in members, contents are dropped one frame after the frame they were filled in
+template <typename T>
+using xr_frame_vector = xr_vector<T, frame_alloc<T>>;
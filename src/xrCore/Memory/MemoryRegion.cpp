@@ -0,0 +1,63 @@
+#include "stdafx.h"
+#include "MemoryRegion.h"
+#include "xrCore/Threading/ScopeLock.hpp"
+
+namespace
+{
+constexpr size_t REGION_CHUNK_SIZE = 256 * 1024;
+
+#ifdef DEBUG
+constexpr u8 REGION_POISON = 0xDD;
+#endif
+} // namespace
+
+void xrMemoryRegion::add_chunk(size_t size)
+{
+    Chunk& chunk = m_chunks.emplace_back();
+    chunk.data = static_cast<u8*>(Memory.mem_alloc(size));
+    chunk.size = size;
+    m_used = 0;
+    m_reserved += size;
+}
+
+void* xrMemoryRegion::alloc(size_t size, size_t alignment)
+{
+    ScopeLock lock(&m_lock);
+    if (m_chunks.empty())
+        add_chunk(std::max(size + alignment, REGION_CHUNK_SIZE));
+
+    const Chunk* chunk = &m_chunks.back();
+    size_t start = ((reinterpret_cast<size_t>(chunk->data) + m_used + alignment - 1) & ~(alignment - 1)) -
+        reinterpret_cast<size_t>(chunk->data);
+    if (start + size > chunk->size)
+    {
+        // Chunks are never reallocated, the tail of the previous one is lost
+        add_chunk(std::max(size + alignment, REGION_CHUNK_SIZE));
+        chunk = &m_chunks.back();
+        start = ((reinterpret_cast<size_t>(chunk->data) + alignment - 1) & ~(alignment - 1)) -
+            reinterpret_cast<size_t>(chunk->data);
+    }
+
+    m_used = start + size;
+    m_allocated += size;
+    ++m_allocations;
+    return chunk->data + start;
+}
+
+void xrMemoryRegion::release()
+{
+    ScopeLock lock(&m_lock);
+    for (Chunk& chunk : m_chunks)
+    {
+#ifdef DEBUG
+        memset(chunk.data, REGION_POISON, chunk.size);
+#endif
+        Memory.mem_free(chunk.data);
+    }
+    m_chunks.clear();
+    m_chunks.shrink_to_fit();
+    m_used = 0;
+    m_reserved = 0;
+    m_allocated = 0;
+    m_allocations = 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "xrCore/xrMemory.h"
+#include "xrCore/Threading/Lock.hpp"
+#include "xrCommon/xr_vector.h"
+
+// Bump allocator for objects which share the lifetime of their owner, e.g. a game level.
+// Blocks can't be freed one by one, release() returns all chunks to the heap at once,
+// so a level unload leaves no fragmentation behind regardless of how many objects were created.
+// Allocation is thread-safe, subsystems may load in parallel.
+// Debug builds poison released memory.
+class XRCORE_API xrMemoryRegion
+{
+    struct Chunk
+    {
+        u8* data;
+        size_t size;
+    };
+
+    xr_vector<Chunk> m_chunks;
+    size_t m_used{}; // in the last chunk
+    size_t m_reserved{};
+    size_t m_allocated{};
+    u32 m_allocations{};
+    Lock m_lock;
+
+    void add_chunk(size_t size);
+
+public:
+    xrMemoryRegion() = default;
+    xrMemoryRegion(const xrMemoryRegion&) = delete;
+    xrMemoryRegion& operator=(const xrMemoryRegion&) = delete;
+    ~xrMemoryRegion() { release(); }
+
+    void* alloc(size_t size, size_t alignment);
+    void release();
+
+    size_t reserved() const { return m_reserved; }
+    size_t allocated() const { return m_allocated; }
+    u32 allocations() const { return m_allocations; }
+};
+
+template <typename T, typename... Args>
+T* region_new(xrMemoryRegion& region, Args&&... args)
+{
+    return new (region.alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+}
+
+// Only destroys the object, memory is returned by xrMemoryRegion::release()
+template <class T>
+void region_delete(T*& ptr)
+{
+    if (ptr)
+    {
+        ptr->~T();
+        ptr = nullptr;
+    }
+}
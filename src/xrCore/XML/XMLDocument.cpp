@@ -1,17 +1,339 @@
 #include "stdafx.h"
 
 #include "XMLDocument.hpp"
+#include "xrCore/Threading/Lock.hpp"
+#include "xrCore/Threading/ScopeLock.hpp"
 
 pcstr UI_PATH = UI_PATH_DEFAULT;
 pcstr UI_PATH_WITH_DELIMITER = UI_PATH_DEFAULT_WITH_DELIMITER;
 
+namespace
+{
+constexpr u32 XML_BINARY_VERSION = 1;
+constexpr pcstr XML_BINARY_ROOT = "$app_data_root$";
+// Documents which no XMLDocument uses are kept up to this number, the least recently used go first
+constexpr size_t XML_CACHE_UNUSED_LIMIT = 64;
+
+// File which took part in the document, the main one or included
+struct XMLSource
+{
+    shared_str path;
+    shared_str name;
+};
+
+class XMLDocumentCache
+{
+    struct entry
+    {
+        std::shared_ptr<XML_DOC> doc;
+        u64 last_use;
+    };
+
+    xr_map<shared_str, entry> m_documents;
+    u64 m_uses{};
+    Lock m_lock;
+
+    static bool unused(const entry& e) { return e.doc.use_count() == 1; }
+
+    // Documents in use cost nothing extra, so only the unused ones are limited
+    void trim()
+    {
+        size_t count = 0;
+        for (const auto& it : m_documents)
+            count += unused(it.second);
+
+        for (; count > XML_CACHE_UNUSED_LIMIT; --count)
+        {
+            auto oldest = m_documents.end();
+            for (auto it = m_documents.begin(); it != m_documents.end(); ++it)
+            {
+                if (unused(it->second) && (oldest == m_documents.end() || it->second.last_use < oldest->second.last_use))
+                    oldest = it;
+            }
+            m_documents.erase(oldest);
+        }
+    }
+
+public:
+    std::shared_ptr<XML_DOC> find(const shared_str& key)
+    {
+        ScopeLock lock(&m_lock);
+        const auto it = m_documents.find(key);
+        if (it == m_documents.end())
+            return nullptr;
+        it->second.last_use = ++m_uses;
+        return it->second.doc;
+    }
+
+    // Returns the document which was inserted first if another thread has parsed the same file
+    std::shared_ptr<XML_DOC> insert(const shared_str& key, const std::shared_ptr<XML_DOC>& doc)
+    {
+        ScopeLock lock(&m_lock);
+        entry& e = m_documents.emplace(key, entry{ doc, 0 }).first->second;
+        e.last_use = ++m_uses;
+        std::shared_ptr<XML_DOC> result = e.doc;
+        trim();
+        return result;
+    }
+
+    void clear()
+    {
+        ScopeLock lock(&m_lock);
+        for (auto it = m_documents.begin(); it != m_documents.end();)
+        {
+            if (unused(it->second))
+                it = m_documents.erase(it);
+            else
+                ++it;
+        }
+    }
+} s_cache;
+
+bool use_binary_cache()
+{
+    static const bool use = strstr(Core.Params, "-xml_bin_cache") != nullptr;
+    return use;
+}
+
+void binary_file_name(string_path& fn, const shared_str& key)
+{
+    xr_sprintf(fn, "xml_cache" DELIMITER "%08x.bin", crc32(key.c_str(), key.size()));
+}
+
+void save_node(IWriter& W, const TiXmlNode& node)
+{
+    W.w_u8(u8(node.Type()));
+    switch (node.Type())
+    {
+    case TiXmlNode::ELEMENT:
+    {
+        W.w_stringZ(node.Value());
+        const TiXmlAttribute* attrib = node.ToElement()->FirstAttribute();
+        u32 count = 0;
+        for (const TiXmlAttribute* it = attrib; it; it = it->Next())
+            ++count;
+        W.w_u32(count);
+        for (; attrib; attrib = attrib->Next())
+        {
+            W.w_stringZ(attrib->Name());
+            W.w_stringZ(attrib->Value());
+        }
+        break;
+    }
+    case TiXmlNode::TEXT:
+        W.w_stringZ(node.Value());
+        W.w_u8(node.ToText()->CDATA() ? 1 : 0);
+        break;
+    case TiXmlNode::DECLARATION:
+    {
+        const TiXmlDeclaration* decl = node.ToDeclaration();
+        W.w_stringZ(decl->Version());
+        W.w_stringZ(decl->Encoding());
+        W.w_stringZ(decl->Standalone());
+        break;
+    }
+    default: W.w_stringZ(node.Value());
+    }
+
+    u32 children = 0;
+    for (const TiXmlNode* child = node.FirstChild(); child; child = child->NextSibling())
+        ++children;
+    W.w_u32(children);
+    for (const TiXmlNode* child = node.FirstChild(); child; child = child->NextSibling())
+        save_node(W, *child);
+}
+
+// The binary file may be truncated or damaged, every read checks the data left
+bool read_u8(IReader& F, u8& value)
+{
+    if (F.elapsed() < intptr_t(sizeof(u8)))
+        return false;
+    value = F.r_u8();
+    return true;
+}
+
+bool read_u32(IReader& F, u32& value)
+{
+    if (F.elapsed() < intptr_t(sizeof(u32)))
+        return false;
+    value = F.r_u32();
+    return true;
+}
+
+template <typename T>
+bool read_string(IReader& F, T& value)
+{
+    if (F.elapsed() <= 0 || !memchr(F.pointer(), 0, F.elapsed()))
+        return false;
+    F.r_stringZ(value);
+    return true;
+}
+
+bool load_node(IReader& F, TiXmlNode& parent)
+{
+    u8 type;
+    xr_string value;
+    if (!read_u8(F, type) || !read_string(F, value))
+        return false;
+
+    TiXmlNode* node;
+    switch (type)
+    {
+    case TiXmlNode::ELEMENT:
+    {
+        TiXmlElement* element = xr_new<TiXmlElement>(value.c_str());
+        parent.LinkEndChild(element);
+        u32 count;
+        if (!read_u32(F, count))
+            return false;
+        xr_string name;
+        for (; count; --count)
+        {
+            if (!read_string(F, name) || !read_string(F, value))
+                return false;
+            element->SetAttribute(name.c_str(), value.c_str());
+        }
+        node = element;
+        break;
+    }
+    case TiXmlNode::TEXT:
+    {
+        TiXmlText* text = xr_new<TiXmlText>(value);
+        parent.LinkEndChild(text);
+        u8 cdata;
+        if (!read_u8(F, cdata))
+            return false;
+        text->SetCDATA(cdata != 0);
+        node = text;
+        break;
+    }
+    case TiXmlNode::COMMENT:
+        node = xr_new<TiXmlComment>(value.c_str());
+        parent.LinkEndChild(node);
+        break;
+    case TiXmlNode::DECLARATION:
+    {
+        xr_string encoding, standalone;
+        if (!read_string(F, encoding) || !read_string(F, standalone))
+            return false;
+        node = xr_new<TiXmlDeclaration>(value, encoding, standalone);
+        parent.LinkEndChild(node);
+        break;
+    }
+    case TiXmlNode::UNKNOWN:
+        node = xr_new<TiXmlUnknown>();
+        node->SetValue(value);
+        parent.LinkEndChild(node);
+        break;
+    default: return false;
+    }
+
+    u32 children;
+    if (!read_u32(F, children))
+        return false;
+    for (; children; --children)
+    {
+        if (!load_node(F, *node))
+            return false;
+    }
+    return true;
+}
+
+bool load_binary(const shared_str& key, XML_DOC& doc)
+{
+    string_path fn;
+    binary_file_name(fn, key);
+    if (!FS.exist(XML_BINARY_ROOT, fn))
+        return false;
+
+    IReader* F = FS.r_open(XML_BINARY_ROOT, fn);
+    if (!F)
+        return false;
+
+    u32 version;
+    shared_str stored_key;
+    u32 count;
+    bool valid = read_u32(*F, version) && version == XML_BINARY_VERSION && read_string(*F, stored_key) &&
+        stored_key == key && read_u32(*F, count);
+
+    // Sources are checked by age, the binary is rebuilt if any of them has changed
+    for (; valid && count; --count)
+    {
+        xr_string path, name;
+        string_path full_name;
+        u32 age;
+        valid = read_string(*F, path) && read_string(*F, name) && read_u32(*F, age) &&
+            FS.exist(full_name, path.c_str(), name.c_str()) && FS.get_file_age(full_name) == age;
+    }
+
+    u32 children;
+    valid = valid && read_u32(*F, children);
+    for (; valid && children; --children)
+        valid = load_node(*F, doc);
+    FS.r_close(F);
+
+    if (!valid)
+        doc.Clear();
+    return valid;
+}
+
+void save_binary(const shared_str& key, const xr_vector<XMLSource>& sources, const XML_DOC& doc)
+{
+    // Written under a temporary name, so a broken save never replaces the binary
+    static std::atomic<u32> temp_counter{};
+    string_path fn, temp_fn;
+    binary_file_name(fn, key);
+    xr_sprintf(temp_fn, "%s.%u.tmp", fn, temp_counter.fetch_add(1, std::memory_order_relaxed));
+    IWriter* W = FS.w_open(XML_BINARY_ROOT, temp_fn);
+    if (!W)
+        return;
+    if (!W->valid())
+    {
+        FS.w_close(W);
+        return;
+    }
+
+    W->w_u32(XML_BINARY_VERSION);
+    W->w_stringZ(key);
+    W->w_u32(u32(sources.size()));
+    for (const XMLSource& source : sources)
+    {
+        string_path full_name;
+        FS.update_path(full_name, source.path.c_str(), source.name.c_str());
+        W->w_stringZ(source.path);
+        W->w_stringZ(source.name);
+        W->w_u32(FS.get_file_age(full_name));
+    }
+
+    u32 children = 0;
+    for (const TiXmlNode* child = doc.FirstChild(); child; child = child->NextSibling())
+        ++children;
+    W->w_u32(children);
+    for (const TiXmlNode* child = doc.FirstChild(); child; child = child->NextSibling())
+        save_node(*W, *child);
+    FS.w_close(W);
+
+    string_path temp_name, name;
+    FS.update_path(temp_name, XML_BINARY_ROOT, temp_fn);
+    FS.update_path(name, XML_BINARY_ROOT, fn);
+    FS.file_rename(temp_name, name, true);
+}
+} // namespace
+
 XMLDocument::XMLDocument() : m_xml_file_name(), m_root(nullptr), m_pLocalRoot(nullptr) {}
 
 XMLDocument::~XMLDocument() { ClearInternal(); }
 
-void XMLDocument::ClearInternal() { m_Doc.Clear(); }
+void XMLDocument::ClearInternal()
+{
+    m_Doc = nullptr;
+    m_root = nullptr;
+    m_pLocalRoot = nullptr;
+}
 
-void ParseFile(pcstr path, CMemoryWriter& W, IReader* F, XMLDocument* xml)
+void XMLDocument::ClearCache() { s_cache.clear(); }
+
+void ParseFile(pcstr path, CMemoryWriter& W, IReader* F, XMLDocument* xml, xr_vector<XMLSource>* sources = nullptr)
 {
     string4096 str;
 
@@ -25,6 +347,8 @@ void ParseFile(pcstr path, CMemoryWriter& W, IReader* F, XMLDocument* xml)
             string_path buff;
             strconcat(buff, uiPathDelim, fn.c_str());
             file = FS.r_open(path, buff);
+            if (file && sources)
+                sources->push_back({ path, buff });
         }
     };
 
@@ -43,11 +367,15 @@ void ParseFile(pcstr path, CMemoryWriter& W, IReader* F, XMLDocument* xml)
                 tryOpenFile(I, inc_name, UI_PATH_DEFAULT_WITH_DELIMITER, UI_PATH_DEFAULT, UI_PATH_DEFAULT_WITH_DELIMITER);
 
                 if (!I)
+                {
                     I = FS.r_open(path, inc_name);
+                    if (I && sources)
+                        sources->push_back({ path, inc_name });
+                }
 
                 if (!I)
                     FATAL_F("XML file[%s] parsing failed. Can't find include file: [%s]", path, inc_name);
-                ParseFile(path, W, I, xml);
+                ParseFile(path, W, I, xml, sources);
                 FS.r_close(I);
             }
         }
@@ -83,38 +411,72 @@ bool XMLDocument::Load(pcstr path_alias, pcstr path, pcstr path2, pcstr xml_file
 // Load and parse xml file
 bool XMLDocument::Load(pcstr path, pcstr xml_filename, bool fatal)
 {
-    IReader* F = FS.r_open(path, xml_filename);
-    if (!F)
+    string1024 key_str;
+    xr_sprintf(key_str, "%s|%s|%s|%s", path, xml_filename, UI_PATH, cache_variant());
+    const shared_str key = key_str;
+    xr_strcpy(m_xml_file_name, xml_filename);
+
+    std::shared_ptr<XML_DOC> doc = s_cache.find(key);
+    if (!doc)
     {
-        R_ASSERT3(!fatal, "Can't find specified xml file", xml_filename);
-        return false;
-    }
+        doc = std::make_shared<XML_DOC>();
+        if (!use_binary_cache() || !load_binary(key, *doc))
+        {
+            IReader* F = FS.r_open(path, xml_filename);
+            if (!F)
+            {
+                R_ASSERT3(!fatal, "Can't find specified xml file", xml_filename);
+                return false;
+            }
 
-    xr_strcpy(m_xml_file_name, xml_filename);
+            xr_vector<XMLSource> sources;
+            sources.push_back({ path, xml_filename });
 
-    CMemoryWriter W;
-    ParseFile(path, W, F, this);
-    W.w_stringZ("");
-    FS.r_close(F);
+            CMemoryWriter W;
+            ParseFile(path, W, F, this, &sources);
+            W.w_stringZ("");
+            FS.r_close(F);
 
-    return Set(reinterpret_cast<pcstr>(W.pointer()), fatal);
+            if (!ParseText(*doc, reinterpret_cast<pcstr>(W.pointer()), fatal))
+                return false;
+
+            // Documents with skipped errors are parsed every time to show the error
+            if (use_binary_cache() && !doc->Error())
+                save_binary(key, sources, *doc);
+        }
+        if (!doc->Error())
+            doc = s_cache.insert(key, doc);
+    }
+
+    m_Doc = std::move(doc);
+    m_root = m_Doc->FirstChildElement();
+    return true;
 }
 
 bool XMLDocument::Set(pcstr text, bool fatal)
 {
     R_ASSERT(text != nullptr);
-    m_Doc.Parse(&m_Doc, text);
+    auto doc = std::make_shared<XML_DOC>();
+    if (!ParseText(*doc, text, fatal))
+        return false;
 
-    if (m_Doc.Error())
+    m_Doc = std::move(doc);
+    m_root = m_Doc->FirstChildElement();
+
+    return true;
+}
+
+bool XMLDocument::ParseText(XML_DOC& doc, pcstr text, bool fatal) const
+{
+    doc.Parse(&doc, text);
+
+    if (doc.Error())
     {
-        const bool canSkipError = IgnoringMissingEndTagError() && m_Doc.ErrorId() == TiXmlBase::TIXML_ERROR_READING_END_TAG;
-        R_ASSERT3(!fatal || canSkipError, m_Doc.ErrorDesc(), m_xml_file_name);
+        const bool canSkipError = IgnoringMissingEndTagError() && doc.ErrorId() == TiXmlBase::TIXML_ERROR_READING_END_TAG;
+        R_ASSERT3(!fatal || canSkipError, doc.ErrorDesc(), m_xml_file_name);
         if (!canSkipError)
             return false;
     }
-
-    m_root = m_Doc.FirstChildElement();
-
     return true;
 }
 
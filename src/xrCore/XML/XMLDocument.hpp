@@ -4,6 +4,8 @@
 
 #include "tinyxml.h"
 
+#include <memory>
+
 #include "xrCommon/xr_vector.h"
 #include "xrCore/xrstring.h"
 
@@ -18,6 +20,10 @@ using XML_NODE = TiXmlNode*;
 using CONST_XML_NODE = const TiXmlNode*;
 using XML_DOC  = TiXmlDocument;
 
+// Documents loaded from files are parsed once and shared between all XMLDocument instances,
+// so nodes of a loaded document must be treated as read-only.
+// Set() and ClearInternal() don't touch the shared document, they replace or drop the reference to it.
+// With -xml_bin_cache the parsed documents are also stored in $app_data_root$ in binary form.
 class XRCORE_API XMLDocument : public Noncopyable
 {
 
@@ -27,6 +33,9 @@ public:
     virtual ~XMLDocument();
     void ClearInternal();
 
+    // Drops documents which are not referenced by XMLDocument instances
+    static void ClearCache();
+
     bool Load(pcstr path_alias, pcstr xml_filename, bool fatal = true);
     bool Load(pcstr path_alias, pcstr path, pcstr xml_filename, bool fatal = true);
     bool Load(pcstr path_alias, pcstr path, pcstr path2, pcstr xml_filename, bool fatal = true);
@@ -95,9 +104,13 @@ protected:
 
 public:
     virtual shared_str correct_file_name(pcstr path, pcstr fn) { return fn; }
+    // Part of the cache key, has to change whenever correct_file_name() starts giving different results
+    virtual pcstr cache_variant() const { return ""; }
 
 private:
-    XML_DOC m_Doc;
+    bool ParseText(XML_DOC& doc, pcstr text, bool fatal) const;
+
+    std::shared_ptr<XML_DOC> m_Doc;
 };
 
 #endif // xrXMLParserH
@@ -309,6 +309,18 @@ int TiXmlElement::QueryDoubleAttribute(const char* name, double* dval) const
     return node->QueryDoubleValue(dval);
 }
 
+void TiXmlElement::SetAttribute(const char* name, const char* _value)
+{
+    TiXmlAttribute* node = attributeSet.Find(name);
+    if (node)
+    {
+        node->SetValue(_value);
+        return;
+    }
+
+    attributeSet.Add(xr_new<TiXmlAttribute>(name, _value));
+}
+
 bool TiXmlElement::Accept(TiXmlVisitor* visitor) const
 {
     if (visitor->VisitEnter(*this, attributeSet.First()))
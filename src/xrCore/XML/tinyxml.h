@@ -973,6 +973,10 @@ public:
     int QueryIntAttribute(const char* name, int* _value) const;
     /// QueryDoubleAttribute examines the attribute - see QueryIntAttribute().
     int QueryDoubleAttribute(const char* name, double* _value) const;
+    /** Sets an attribute of name to a given value. The attribute
+        will be created if it does not exist, or changed if it does.
+    */
+    void SetAttribute(const char* name, const char* _value);
     /// QueryFloatAttribute examines the attribute - see QueryIntAttribute().
     int QueryFloatAttribute(const char* name, float* _value) const
     {
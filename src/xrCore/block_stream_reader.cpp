@@ -0,0 +1,247 @@
+#include "stdafx.h"
+#include "block_stream_reader.h"
+#include "xrCore/Threading/TaskManager.hpp"
+#include "xrCore/Threading/ParallelFor.hpp"
+#if defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+constexpr u32 NO_BLOCK = u32(-1);
+
+struct block_header
+{
+    u32 block_size;
+    u32 block_count;
+};
+
+void decompress_stored(u8* dest, size_t dest_size, const u8* src, size_t src_size)
+{
+    // Blocks which don't compress are stored as is
+    if (src_size == dest_size)
+        CopyMemory(dest, src, dest_size);
+    else
+        rtc_decompress(dest, dest_size, src, src_size);
+}
+} // namespace
+
+#if defined(XR_PLATFORM_WINDOWS)
+void CBlockStreamReader::construct(const HANDLE& file_mapping_handle, const u8* archive_data,
+    const size_t& start_offset, const size_t& file_size, const size_t& archive_size)
+#elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+void CBlockStreamReader::construct(int file_mapping_handle, const u8* archive_data,
+    const size_t& start_offset, const size_t& file_size, const size_t& archive_size)
+#endif
+{
+    m_file_mapping_handle = file_mapping_handle;
+    m_archive_data = archive_data;
+    m_entry_offset = start_offset;
+    m_entry_size = file_size;
+    m_start_offset = start_offset;
+    m_file_size = file_size;
+    m_archive_size = archive_size;
+    m_view_start = 0;
+    m_bytes_read = 0;
+
+    u8* view;
+    size_t view_size;
+    const auto header = reinterpret_cast<const block_header*>(map_stored(0, sizeof(block_header), view, view_size));
+    m_block_size = header->block_size;
+    const u32 block_count = header->block_count;
+    unmap_stored(view, view_size);
+    R_ASSERT2(m_block_size && block_count == (file_size + m_block_size - 1) / m_block_size,
+        "Corrupted block compressed file");
+
+    m_offsets.resize(block_count + 1);
+    const u8* offsets = map_stored(sizeof(block_header), m_offsets.size() * sizeof(u32), view, view_size);
+    CopyMemory(m_offsets.data(), offsets, m_offsets.size() * sizeof(u32));
+    unmap_stored(view, view_size);
+
+    init_buffers();
+    map(0);
+}
+
+void CBlockStreamReader::construct(const CBlockStreamReader& parent, const size_t& view_start, const size_t& view_size)
+{
+    m_file_mapping_handle = parent.m_file_mapping_handle;
+    m_archive_data = parent.m_archive_data;
+    m_entry_offset = parent.m_entry_offset;
+    m_entry_size = parent.m_entry_size;
+    m_start_offset = parent.m_start_offset;
+    m_file_size = view_size;
+    m_archive_size = parent.m_archive_size;
+    m_block_size = parent.m_block_size;
+    m_offsets = parent.m_offsets;
+    m_view_start = view_start;
+    m_bytes_read = 0;
+    VERIFY(m_view_start + m_file_size <= m_entry_size);
+
+    init_buffers();
+    map(0);
+}
+
+void CBlockStreamReader::init_buffers()
+{
+    m_window_size = m_block_size;
+    for (u32 i = 0; i < 2; ++i)
+    {
+        m_buffers[i] = xr_alloc<u8>(m_block_size);
+        m_buffer_blocks[i] = NO_BLOCK;
+    }
+    m_current = 0;
+    m_prefetch_task = nullptr;
+}
+
+void CBlockStreamReader::destroy()
+{
+    if (m_prefetch_task)
+        TaskScheduler->Wait(*m_prefetch_task);
+    m_prefetch_task = nullptr;
+
+    for (u8*& buffer : m_buffers)
+        xr_free(buffer);
+}
+
+const u8* CBlockStreamReader::map_stored(size_t offset, size_t size, u8*& view, size_t& view_size) const
+{
+    const size_t start = m_entry_offset + offset;
+    if (m_archive_data)
+    {
+        view = nullptr;
+        view_size = 0;
+        return m_archive_data + start;
+    }
+
+    const size_t granularity = FS.dwAllocGranularity;
+    const size_t view_start = start / granularity * granularity;
+    view_size = std::min(start + size, m_archive_size) - view_start;
+#if defined(XR_PLATFORM_WINDOWS)
+    view = static_cast<u8*>(MapViewOfFile(m_file_mapping_handle, FILE_MAP_READ, 0, view_start, view_size));
+    R_ASSERT(view);
+#elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+    view = static_cast<u8*>(::mmap(nullptr, view_size, PROT_READ, MAP_SHARED, m_file_mapping_handle, view_start));
+    R_ASSERT(view && view != MAP_FAILED);
+#endif
+    return view + (start - view_start);
+}
+
+void CBlockStreamReader::unmap_stored(u8* view, size_t view_size) const
+{
+    if (!view)
+        return;
+#if defined(XR_PLATFORM_WINDOWS)
+    UnmapViewOfFile(view);
+#elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+    ::munmap(view, view_size);
+#endif
+}
+
+size_t CBlockStreamReader::block_length(u32 block) const
+{
+    return std::min(size_t(m_block_size), m_entry_size - size_t(block) * m_block_size);
+}
+
+void CBlockStreamReader::decompress_block(u32 block, u8* dest) const
+{
+    const size_t stored_size = m_offsets[block + 1] - m_offsets[block];
+    u8* view;
+    size_t view_size;
+    const u8* src = map_stored(m_offsets[block], stored_size, view, view_size);
+    decompress_stored(dest, block_length(block), src, stored_size);
+    unmap_stored(view, view_size);
+}
+
+void CBlockStreamReader::prefetch(Task&, void* data)
+{
+    const u32 buffer = *static_cast<u32*>(data);
+    decompress_block(m_buffer_blocks[buffer], m_buffers[buffer]);
+}
+
+u8* CBlockStreamReader::acquire(u32 block)
+{
+    if (m_prefetch_task)
+    {
+        TaskScheduler->Wait(*m_prefetch_task);
+        m_prefetch_task = nullptr;
+    }
+
+    if (m_buffer_blocks[m_current] != block)
+    {
+        // Read ahead block is either the one we need or useless, the window moved elsewhere
+        m_current ^= 1;
+        if (m_buffer_blocks[m_current] != block)
+        {
+            m_buffer_blocks[m_current] = block;
+            m_bytes_read += m_offsets[block + 1] - m_offsets[block];
+            decompress_block(block, m_buffers[m_current]);
+        }
+    }
+
+    // Start decompressing the next block, if the view needs it
+    const u32 next = block + 1;
+    u32 ahead = m_current ^ 1;
+    if (size_t(next) * m_block_size < m_view_start + m_file_size && m_buffer_blocks[ahead] != next)
+    {
+        m_buffer_blocks[ahead] = next;
+        m_bytes_read += m_offsets[next + 1] - m_offsets[next];
+        if (TaskScheduler)
+        {
+            m_prefetch_task = &TaskScheduler->AddTask(
+                "CBlockStreamReader::prefetch", { this, &CBlockStreamReader::prefetch }, sizeof(ahead), &ahead);
+        }
+        else
+            decompress_block(next, m_buffers[ahead]);
+    }
+
+    return m_buffers[m_current];
+}
+
+void CBlockStreamReader::map(const size_t& new_offset)
+{
+    VERIFY(new_offset <= m_file_size);
+    m_current_offset_from_start = new_offset;
+
+    // End of the view maps the last block with an empty window
+    const size_t position = m_view_start + new_offset;
+    const u32 block = u32(std::min(position / m_block_size, m_offsets.size() - 2));
+    const size_t block_start = size_t(block) * m_block_size;
+    const size_t block_end = std::min(block_start + block_length(block), m_view_start + m_file_size);
+
+    m_current_map_view_of_file = acquire(block);
+    m_start_pointer = m_current_map_view_of_file + (position - block_start);
+    m_current_pointer = m_start_pointer;
+    m_current_window_size = block_end - position;
+}
+
+CStreamReader* CBlockStreamReader::open_chunk(const size_t& chunk_id)
+{
+    bool compressed;
+    const auto size = find_chunk(chunk_id, &compressed);
+    if (!size)
+        return nullptr;
+
+    R_ASSERT2(!compressed, "cannot use CStreamReader on compressed chunks");
+    CBlockStreamReader* result = xr_new<CBlockStreamReader>();
+    result->construct(*this, m_view_start + tell(), size);
+    return result;
+}
+
+void CBlockStreamReader::decompress(u8* dest, size_t dest_size, const u8* entry)
+{
+    const auto header = reinterpret_cast<const block_header*>(entry);
+    const u32* offsets = reinterpret_cast<const u32*>(header + 1);
+    const size_t block_size = header->block_size;
+    R_ASSERT2(block_size && header->block_count == (dest_size + block_size - 1) / block_size,
+        "Corrupted block compressed file");
+
+    xr_parallel_for(TaskRange<u32>(0, header->block_count, 4), [&](const TaskRange<u32>& range)
+    {
+        for (u32 i = range.begin(); i != range.end(); ++i)
+        {
+            const size_t start = size_t(i) * block_size;
+            decompress_stored(dest + start, std::min(block_size, dest_size - start), entry + offsets[i],
+                offsets[i + 1] - offsets[i]);
+        }
+    });
+}
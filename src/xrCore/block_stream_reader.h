@@ -0,0 +1,65 @@
+#ifndef BLOCK_STREAM_READER_H
+#define BLOCK_STREAM_READER_H
+
+#include "stream_reader.h"
+
+class Task;
+
+// Stream reader of archive entries compressed in independent blocks (CFS_BlockCompressMark).
+// Entry layout:
+//   u32 block_size - uncompressed size of each block, the last one may be shorter
+//   u32 block_count
+//   u32 offsets[block_count + 1] - from the entry start, block i takes [offsets[i], offsets[i + 1])
+//   blocks - LZO compressed, or stored as is if they don't compress
+// The window is a single decompressed block, the next one is decompressed in the background while it's read.
+class XRCORE_API CBlockStreamReader : public CStreamReader
+{
+    using inherited = CStreamReader;
+
+    const u8* m_archive_data; // whole archive mapping, null if files are mapped on demand
+    size_t m_entry_offset;
+    size_t m_entry_size; // decompressed
+    u32 m_block_size;
+    xr_vector<u32> m_offsets;
+    size_t m_view_start; // in the decompressed file, not zero for chunks
+
+    u8* m_buffers[2];
+    u32 m_buffer_blocks[2];
+    u32 m_current; // buffer of the window, the other one is read ahead
+    const Task* m_prefetch_task;
+    size_t m_bytes_read; // from the archive
+
+    void init_buffers();
+    const u8* map_stored(size_t offset, size_t size, u8*& view, size_t& view_size) const;
+    void unmap_stored(u8* view, size_t view_size) const;
+    size_t block_length(u32 block) const;
+    void decompress_block(u32 block, u8* dest) const;
+    u8* acquire(u32 block);
+    void prefetch(Task&, void* data);
+
+protected:
+    void map(const size_t& new_offset) override;
+    void unmap() override {}
+
+public:
+    CBlockStreamReader() = default;
+
+#if defined(XR_PLATFORM_WINDOWS)
+    void construct(const HANDLE& file_mapping_handle, const u8* archive_data, const size_t& start_offset,
+        const size_t& file_size, const size_t& archive_size);
+#elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
+    void construct(int file_mapping_handle, const u8* archive_data, const size_t& start_offset,
+        const size_t& file_size, const size_t& archive_size);
+#endif
+    // View of the part of the parent's file
+    void construct(const CBlockStreamReader& parent, const size_t& view_start, const size_t& view_size);
+    void destroy() override;
+
+    CStreamReader* open_chunk(const size_t& chunk_id) override;
+    size_t bytes_read() const { return m_bytes_read; }
+
+    // Decompresses the whole entry at once, blocks are processed in parallel
+    static void decompress(u8* dest, size_t dest_size, const u8* entry);
+};
+
+#endif // BLOCK_STREAM_READER_H
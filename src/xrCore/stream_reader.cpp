@@ -1,9 +1,94 @@
 #include "stdafx.h"
 #include "stream_reader.h"
 #include "xrCore/_std_extensions.h"
+#include "xrCommon/xr_deque.h"
+#include "xrCore/Threading/Event.hpp"
+#include "xrCore/Threading/Lock.hpp"
+#include "xrCore/Threading/ScopeLock.hpp"
+#include "xrCore/Threading/ThreadUtil.h"
 #ifdef XR_PLATFORM_LINUX
 #include <sys/mman.h>
 #endif
+#include <thread>
+
+namespace
+{
+enum : u32
+{
+    AHEAD_IDLE,
+    AHEAD_QUEUED,
+    AHEAD_BUSY, // being mapped by the prefetch thread
+    AHEAD_READY,
+    AHEAD_CANCELLED, // consumer doesn't need the window which is being mapped
+};
+
+bool read_ahead_enabled()
+{
+    static const bool enabled = !strstr(Core.Params, "-fs_no_read_ahead");
+    return enabled;
+}
+} // namespace
+
+class CStreamReader::prefetcher
+{
+    xr_deque<CStreamReader*> m_queue;
+    Lock m_lock;
+    Event m_event;
+
+    static void thread_entry(void* self) { static_cast<prefetcher*>(self)->run(); }
+
+    void run()
+    {
+        for (;;)
+        {
+            m_event.Wait();
+            for (;;)
+            {
+                CStreamReader* reader;
+                {
+                    ScopeLock lock(&m_lock);
+                    if (m_queue.empty())
+                        break;
+                    reader = m_queue.front();
+                    m_queue.pop_front();
+
+                    // Under the lock, so remove() knows whether the reader is still touched
+                    u32 state = AHEAD_QUEUED;
+                    if (!reader->m_ahead_state.compare_exchange_strong(state, AHEAD_BUSY, std::memory_order_acquire))
+                        continue;
+                }
+                reader->read_ahead();
+            }
+        }
+    }
+
+public:
+    prefetcher() { Threading::SpawnThread(thread_entry, "X-Ray Stream Prefetch", 0, this); }
+
+    void push(CStreamReader* reader)
+    {
+        {
+            ScopeLock lock(&m_lock);
+            m_queue.push_back(reader);
+        }
+        m_event.Set();
+    }
+
+    void remove(CStreamReader* reader)
+    {
+        ScopeLock lock(&m_lock);
+        m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), reader), m_queue.end());
+        u32 state = AHEAD_QUEUED;
+        reader->m_ahead_state.compare_exchange_strong(state, AHEAD_IDLE, std::memory_order_acq_rel);
+    }
+
+    // Lives until the process exits, the thread never stops
+    static prefetcher& get()
+    {
+        static prefetcher* instance = xr_new<prefetcher>();
+        return *instance;
+    }
+};
 
 #if defined(XR_PLATFORM_WINDOWS)
 void CStreamReader::construct(const HANDLE& file_mapping_handle, const size_t& start_offset, const size_t& file_size,
@@ -31,14 +116,27 @@ void CStreamReader::construct(int file_mapping_handle, const size_t& start_offse
 }
 #endif
 
-void CStreamReader::destroy() { unmap(); }
-void CStreamReader::map(const size_t& new_offset)
+void CStreamReader::destroy()
 {
-    VERIFY(new_offset <= m_file_size);
-    m_current_offset_from_start = new_offset;
+    cancel_ahead();
+    unmap();
+}
+
+void CStreamReader::unmap()
+{
+    window w;
+    w.view = m_current_map_view_of_file;
+    w.view_size = m_current_view_size;
+    unmap_window(w);
+}
+
+CStreamReader::window CStreamReader::map_window(const size_t& offset) const
+{
+    window w;
+    w.offset = offset;
 
     const size_t granularity = FS.dwAllocGranularity;
-    size_t start_offset = m_start_offset + new_offset;
+    size_t start_offset = m_start_offset + offset;
     const size_t pure_start_offset = start_offset;
     start_offset = (start_offset / granularity) * granularity;
 
@@ -52,20 +150,132 @@ void CStreamReader::map(const size_t& new_offset)
     if (end_offset > m_archive_size)
         end_offset = m_archive_size;
 
-    m_current_window_size = end_offset - start_offset;
+    w.view_size = end_offset - start_offset;
 #if defined(XR_PLATFORM_WINDOWS)
-    m_current_map_view_of_file =
-        static_cast<u8*>(MapViewOfFile(m_file_mapping_handle, FILE_MAP_READ, 0, start_offset, m_current_window_size));
-#elif defined(XR_PLATFORM_LINUX)
-    m_current_map_view_of_file =
-        static_cast<u8*>(::mmap(NULL, m_current_window_size, PROT_READ, MAP_SHARED, m_file_mapping_handle, start_offset));
+    w.view = static_cast<u8*>(MapViewOfFile(m_file_mapping_handle, FILE_MAP_READ, 0, start_offset, w.view_size));
+    R_ASSERT(w.view);
+#else
+    w.view = static_cast<u8*>(::mmap(NULL, w.view_size, PROT_READ, MAP_SHARED, m_file_mapping_handle, start_offset));
+    R_ASSERT(w.view && w.view != MAP_FAILED);
 #endif
-    m_current_pointer = m_current_map_view_of_file;
 
     const size_t difference = pure_start_offset - start_offset;
-    m_current_window_size -= difference;
-    m_current_pointer += difference;
+    w.start = w.view + difference;
+    w.size = w.view_size - difference;
+    return w;
+}
+
+void CStreamReader::unmap_window(const window& w)
+{
+#if defined(XR_PLATFORM_WINDOWS)
+    UnmapViewOfFile(w.view);
+#else
+    ::munmap(w.view, w.view_size);
+#endif
+}
+
+void CStreamReader::map(const size_t& new_offset)
+{
+    VERIFY(new_offset <= m_file_size);
+    CTimer timer;
+    timer.Start();
+
+    const bool sequential = m_stats.windows && new_offset == m_current_offset_from_start + m_current_window_size;
+    m_sequential = sequential ? m_sequential + 1 : 0;
+
+    window w;
+    if (take_ahead(new_offset, w))
+        ++m_stats.read_ahead;
+    else
+        w = map_window(new_offset);
+
+    m_current_offset_from_start = new_offset;
+    m_current_map_view_of_file = w.view;
+    m_current_view_size = w.view_size;
+    m_current_window_size = w.size;
+    m_current_pointer = w.start;
     m_start_pointer = m_current_pointer;
+
+    const size_t next = new_offset + m_current_window_size;
+    if (m_sequential && next < m_file_size && read_ahead_enabled())
+        request_ahead(next);
+
+    ++m_stats.windows;
+    m_stats.stall_ms += timer.GetElapsed_sec() * 1000.f;
+}
+
+bool CStreamReader::take_ahead(const size_t& offset, window& w)
+{
+    u32 state = m_ahead_state.load(std::memory_order_acquire);
+    for (;;)
+    {
+        switch (state)
+        {
+        case AHEAD_QUEUED:
+        case AHEAD_BUSY:
+        {
+            // Don't wait for the prefetch thread, the caller maps the window itself
+            const u32 cancelled = state == AHEAD_QUEUED ? AHEAD_IDLE : AHEAD_CANCELLED;
+            if (m_ahead_state.compare_exchange_weak(state, cancelled, std::memory_order_acq_rel, std::memory_order_acquire))
+                return false;
+            break; // state has changed, look again
+        }
+        case AHEAD_READY:
+            w = m_ahead;
+            m_ahead_state.store(AHEAD_IDLE, std::memory_order_relaxed);
+            if (w.offset == offset)
+                return true;
+            unmap_window(w);
+            return false;
+        default: return false;
+        }
+    }
+}
+
+void CStreamReader::request_ahead(const size_t& offset)
+{
+    // Cancelled window is still being mapped, skip this one
+    if (m_ahead_state.load(std::memory_order_acquire) != AHEAD_IDLE)
+        return;
+
+    m_ahead_offset = offset;
+    m_ahead_used = true;
+    m_ahead_state.store(AHEAD_QUEUED, std::memory_order_release);
+    prefetcher::get().push(this);
+}
+
+void CStreamReader::cancel_ahead()
+{
+    if (!m_ahead_used)
+        return;
+
+    prefetcher::get().remove(this);
+    window w;
+    take_ahead(size_t(-1), w);
+    while (m_ahead_state.load(std::memory_order_acquire) != AHEAD_IDLE)
+        std::this_thread::yield();
+    m_ahead_used = false;
+}
+
+// Prefetch thread
+void CStreamReader::read_ahead()
+{
+    const window w = map_window(m_ahead_offset);
+
+    // Page faults are taken here instead of the consumer
+    u8 sum = 0;
+    for (size_t i = 0; i < w.size; i += 4096)
+        sum ^= w.start[i];
+    volatile u8 sink = sum;
+    UNUSED(sink);
+
+    m_ahead = w;
+    u32 state = AHEAD_BUSY;
+    if (!m_ahead_state.compare_exchange_strong(state, AHEAD_READY, std::memory_order_release))
+    {
+        unmap_window(w);
+        m_ahead_state.store(AHEAD_IDLE, std::memory_order_release);
+    }
 }
 
 void CStreamReader::advance(const int& offset)
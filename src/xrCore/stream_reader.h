@@ -1,9 +1,11 @@
 #ifndef STREAM_READER_H
 #define STREAM_READER_H
 
+#include <atomic>
+
 class XRCORE_API CStreamReader : public IReaderBase<CStreamReader>, Noncopyable
 {
-private:
+protected:
 #if defined(XR_PLATFORM_WINDOWS)
     HANDLE m_file_mapping_handle;
 #elif defined(XR_PLATFORM_LINUX) || defined(XR_PLATFORM_FREEBSD)
@@ -14,16 +16,55 @@ private:
     size_t m_archive_size;
     size_t m_window_size;
 
-private:
+protected:
     size_t m_current_offset_from_start;
     size_t m_current_window_size;
+    size_t m_current_view_size; // whole mapping, starts before the window to meet the granularity
     u8* m_current_map_view_of_file;
     u8* m_start_pointer;
     u8* m_current_pointer;
 
+public:
+    struct stats
+    {
+        u32 windows; // switched to
+        u32 read_ahead; // of them were ready before the consumer needed them
+        float stall_ms; // spent by the consumer in switching windows
+    };
+
 private:
-    void map(const size_t& new_offset);
-    IC void unmap();
+    // Read ahead: once the consumer crosses windows sequentially, the next window is mapped
+    // and paged in by the prefetch thread. The consumer takes it with atomics only,
+    // if it isn't ready yet the consumer maps the window itself.
+    class prefetcher;
+
+    struct window
+    {
+        u8* view;
+        size_t view_size;
+        size_t offset; // from the file start
+        u8* start;
+        size_t size; // from start to the end of the view
+    };
+
+    window m_ahead;
+    size_t m_ahead_offset;
+    std::atomic<u32> m_ahead_state{};
+    bool m_ahead_used{}; // the reader may be in the prefetch queue
+    u32 m_sequential{}; // windows switched sequentially in a row
+    stats m_stats{};
+
+    window map_window(const size_t& offset) const;
+    static void unmap_window(const window& w);
+    bool take_ahead(const size_t& offset, window& w);
+    void request_ahead(const size_t& offset);
+    void cancel_ahead();
+    void read_ahead();
+
+protected:
+    // Window is a view of the file data starting at new_offset
+    virtual void map(const size_t& new_offset);
+    virtual void unmap();
     IC void remap(const size_t& new_offset);
 
 public:
@@ -53,8 +94,9 @@ public:
 public:
     void advance(const int& offset);
     void r(void* buffer, size_t buffer_size) override;
-    CStreamReader* open_chunk(const size_t& chunk_id);
+    virtual CStreamReader* open_chunk(const size_t& chunk_id);
     u32 find_chunk(u32 ID, bool* bCompressed = nullptr);
+    const stats& get_stats() const { return m_stats; }
     //. CStreamReader*open_chunk_iterator(const u32 &chunk_id, CStreamReader *previous = 0); // 0 means first
 
 public:
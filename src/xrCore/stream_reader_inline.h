@@ -10,11 +10,6 @@ IC const HANDLE& CStreamReader::file_mapping_handle() const { return (m_file_map
 IC const int& CStreamReader::file_mapping_handle() const { return (m_file_mapping_handle); }
 #endif
 
-#if defined(XR_PLATFORM_WINDOWS)
-IC void CStreamReader::unmap() { UnmapViewOfFile(m_current_map_view_of_file); }
-#else
-IC void CStreamReader::unmap() { ::munmap(const_cast<u8*>(m_current_map_view_of_file), m_current_window_size); }
-#endif
 IC void CStreamReader::remap(const size_t& new_offset)
 {
     unmap();
@@ -18,10 +18,10 @@
 
 #if defined(USE_MIMALLOC)
 #include "mimalloc.h"
-#define xr_internal_malloc(size, alignment) mi_malloc_aligned(size, alignment);
-#define xr_internal_malloc_nothrow(size, alignment) mi_malloc_aligned(size, alignment);
-#define xr_internal_realloc(ptr, size, alignment) mi_realloc_aligned(ptr, size, alignment);
-#define xr_internal_free(ptr, alignment) mi_free_aligned(ptr, alignment);
+#define xr_internal_malloc(size, alignment) mi_malloc_aligned(size, alignment)
+#define xr_internal_malloc_nothrow(size, alignment) mi_malloc_aligned(size, alignment)
+#define xr_internal_realloc(ptr, size, alignment) mi_realloc_aligned(ptr, size, alignment)
+#define xr_internal_free(ptr, alignment) mi_free_aligned(ptr, alignment)
 #elif defined(USE_XR_ALIGNED_MALLOC)
 #include "Memory/xrMemory_align.h"
 #define xr_internal_malloc(size, alignment) xr_aligned_malloc(size, alignment)
@@ -47,6 +47,220 @@ constexpr size_t xr_reserved_tail = 0;
 
 constexpr size_t DEFAULT_ALIGNMENT = 16;
 
+thread_local MemoryTag s_tl_tag = MemoryTag::Default;
+
+namespace
+{
+// Counters are cheap enough to be always on: every thread counts into its own ones,
+// which are folded into the shared counters once in a while.
+// Live blocks are counted only with MEMORY_TAGS, a free doesn't know its tag otherwise.
+struct alignas(64) TagCounters
+{
+    std::atomic_size_t allocated_bytes{};
+    std::atomic_size_t allocated_count{};
+#if defined(USE_MEMORY_TAGS)
+    std::atomic_size_t bytes{};
+    std::atomic_size_t count{};
+#endif
+};
+
+TagCounters s_tag_counters[size_t(MemoryTag::Count)];
+
+constexpr u32 TAG_COUNTERS_FOLD_PERIOD = 256; // allocations and frees of the thread
+
+struct ThreadTagCounters
+{
+    struct Counters
+    {
+        size_t allocated_bytes;
+        size_t allocated_count;
+#if defined(USE_MEMORY_TAGS)
+        size_t bytes; // wraps around on frees, folding restores it
+        size_t count;
+#endif
+    };
+
+    Counters tags[size_t(MemoryTag::Count)];
+    u32 pending;
+
+    ~ThreadTagCounters() { fold(); }
+
+    void fold()
+    {
+        for (size_t i = 0; i < size_t(MemoryTag::Count); ++i)
+        {
+            Counters& local = tags[i];
+            TagCounters& shared = s_tag_counters[i];
+            shared.allocated_bytes.fetch_add(local.allocated_bytes, std::memory_order_relaxed);
+            shared.allocated_count.fetch_add(local.allocated_count, std::memory_order_relaxed);
+#if defined(USE_MEMORY_TAGS)
+            shared.bytes.fetch_add(local.bytes, std::memory_order_relaxed);
+            shared.count.fetch_add(local.count, std::memory_order_relaxed);
+#endif
+            local = {};
+        }
+        pending = 0;
+    }
+
+    void account(MemoryTag tag, size_t size, bool allocated)
+    {
+        Counters& local = tags[size_t(tag)];
+        if (allocated)
+        {
+            local.allocated_bytes += size;
+            ++local.allocated_count;
+#if defined(USE_MEMORY_TAGS)
+            local.bytes += size;
+            ++local.count;
+#endif
+        }
+#if defined(USE_MEMORY_TAGS)
+        else
+        {
+            local.bytes -= size;
+            --local.count;
+        }
+#endif
+        if (++pending >= TAG_COUNTERS_FOLD_PERIOD)
+            fold();
+    }
+};
+
+thread_local ThreadTagCounters s_tl_counters{};
+
+void account(MemoryTag tag, size_t size, bool allocated) { s_tl_counters.account(tag, size, allocated); }
+} // namespace
+
+#if defined(USE_MEMORY_TAGS)
+#if defined(XR_PLATFORM_LINUX)
+#include <execinfo.h>
+#endif
+
+#include "Threading/ScopeLock.hpp"
+#include "xrCommon/xr_unordered_map.h"
+
+namespace
+{
+constexpr u32 HEADER_MAGIC = 0x4D454D54; // 'MEMT'
+
+// Every block is prefixed with its size and tag, so frees are accounted too.
+// It costs an alignment step per block, so it's a diagnostic build only.
+struct MemoryHeader
+{
+    size_t size;
+    u16 offset; // from the start of the block returned by the allocator
+    MemoryTag tag;
+    bool sampled;
+    u32 magic; // catches blocks which weren't allocated here
+};
+
+static_assert(sizeof(MemoryHeader) <= DEFAULT_ALIGNMENT, "Header must not change alignment of the blocks");
+
+constexpr u32 SAMPLE_MAX_FRAMES = 24;
+
+struct SampleRecord
+{
+    size_t size;
+    MemoryTag tag;
+    u32 frames_count;
+    void* frames[SAMPLE_MAX_FRAMES];
+};
+
+using SampleMap = xr_unordered_map<void*, SampleRecord>;
+
+std::atomic<u32> s_sample_rate{};
+std::atomic<u32> s_sample_counter{};
+// Created on the first start and never destroyed, sampled blocks may be freed on shutdown
+SampleMap* s_samples = nullptr;
+Lock* s_samples_lock = nullptr;
+// Allocations of the sampler itself are not sampled
+thread_local bool s_tl_sampling = false;
+
+size_t block_offset(size_t alignment) { return std::max(alignment, DEFAULT_ALIGNMENT); }
+
+MemoryHeader* header_of(void* ptr)
+{
+    MemoryHeader* header = reinterpret_cast<MemoryHeader*>(static_cast<u8*>(ptr) - sizeof(MemoryHeader));
+    // Freeing it at the header offset would corrupt the heap, better to stop here
+    R_ASSERT2(header->magic == HEADER_MAGIC, "Block wasn't allocated by xrMemory or is already freed");
+    return header;
+}
+
+void sample_add(void* ptr, MemoryHeader* header)
+{
+    if (s_tl_sampling)
+        return;
+
+    const u32 rate = s_sample_rate.load(std::memory_order_relaxed);
+    if (!rate || s_sample_counter.fetch_add(1, std::memory_order_relaxed) % rate)
+        return;
+
+    s_tl_sampling = true;
+    SampleRecord record;
+    record.size = header->size;
+    record.tag = header->tag;
+#if defined(XR_PLATFORM_WINDOWS)
+    record.frames_count = CaptureStackBackTrace(2, SAMPLE_MAX_FRAMES, record.frames, nullptr);
+#elif defined(XR_PLATFORM_LINUX)
+    record.frames_count = u32(backtrace(record.frames, SAMPLE_MAX_FRAMES));
+#else
+    record.frames_count = 0;
+#endif
+    {
+        ScopeLock lock(s_samples_lock);
+        if (s_samples)
+        {
+            s_samples->insert_or_assign(ptr, record);
+            header->sampled = true;
+        }
+    }
+    s_tl_sampling = false;
+}
+
+void sample_remove(void* ptr)
+{
+    const bool sampling = s_tl_sampling;
+    s_tl_sampling = true;
+    {
+        ScopeLock lock(s_samples_lock);
+        if (s_samples)
+            s_samples->erase(ptr);
+    }
+    s_tl_sampling = sampling;
+}
+
+void* on_allocated(void* block, size_t size, size_t offset, MemoryTag tag)
+{
+    if (!block)
+        return nullptr;
+
+    u8* ptr = static_cast<u8*>(block) + offset;
+    MemoryHeader* header = reinterpret_cast<MemoryHeader*>(ptr - sizeof(MemoryHeader));
+    header->size = size;
+    header->offset = u16(offset);
+    header->tag = tag;
+    header->sampled = false;
+    header->magic = HEADER_MAGIC;
+
+    account(tag, size, true);
+    sample_add(ptr, header);
+    return ptr;
+}
+
+// Returns the block to be passed to the allocator
+void* on_free(void* ptr)
+{
+    MemoryHeader* header = header_of(ptr);
+    account(header->tag, header->size, false);
+
+    if (header->sampled)
+        sample_remove(ptr);
+    header->magic = 0;
+    return static_cast<u8*>(ptr) - header->offset;
+}
+} // namespace
+#endif // USE_MEMORY_TAGS
+
 xrMemory Memory;
 // Also used in src\xrCore\xrDebug.cpp to prevent use of g_pStringContainer before it initialized
 bool shared_str_initialized = false;
@@ -146,56 +360,272 @@ void xrMemory::mem_compact()
 
 void* xrMemory::mem_alloc(size_t size)
 {
-    stat_calls++;
-    return xr_internal_malloc(size, DEFAULT_ALIGNMENT);
+    return mem_alloc(size, DEFAULT_ALIGNMENT);
 }
 
 void* xrMemory::mem_alloc(size_t size, size_t alignment)
 {
     stat_calls++;
+#if defined(USE_MEMORY_TAGS)
+    const size_t offset = block_offset(alignment);
+    return on_allocated(xr_internal_malloc(size + offset, offset), size, offset, s_tl_tag);
+#else
+    account(s_tl_tag, size, true);
     return xr_internal_malloc(size, alignment);
+#endif
 }
 
 void* xrMemory::mem_alloc(size_t size, const std::nothrow_t&) noexcept
 {
-    stat_calls++;
-    return xr_internal_malloc_nothrow(size, DEFAULT_ALIGNMENT);
+    return mem_alloc(size, DEFAULT_ALIGNMENT, std::nothrow);
 }
 
 void* xrMemory::mem_alloc(size_t size, size_t alignment, const std::nothrow_t&) noexcept
 {
     stat_calls++;
+#if defined(USE_MEMORY_TAGS)
+    const size_t offset = block_offset(alignment);
+    return on_allocated(xr_internal_malloc_nothrow(size + offset, offset), size, offset, s_tl_tag);
+#else
+    account(s_tl_tag, size, true);
     return xr_internal_malloc_nothrow(size, alignment);
+#endif
 }
 
 void* xrMemory::mem_realloc(void* ptr, size_t size)
 {
-    stat_calls++;
-    return xr_internal_realloc(ptr, size, DEFAULT_ALIGNMENT);
+    return mem_realloc(ptr, size, DEFAULT_ALIGNMENT);
 }
 
 void* xrMemory::mem_realloc(void* ptr, size_t size, size_t alignment)
 {
+#if defined(USE_MEMORY_TAGS)
+    if (!ptr)
+        return mem_alloc(size, alignment);
+
+    stat_calls++;
+    // Block keeps its tag and data offset
+    MemoryHeader* header = header_of(ptr);
+    const MemoryTag tag = header->tag;
+    const size_t old_size = header->size;
+    const size_t offset = header->offset;
+    VERIFY(offset == block_offset(alignment));
+    if (header->sampled)
+    {
+        sample_remove(ptr);
+        header->sampled = false;
+    }
+
+    void* new_block = xr_internal_realloc(static_cast<u8*>(ptr) - offset, size + offset, offset);
+    // On failure the old block stays alive and accounted
+    if (!new_block)
+        return nullptr;
+
+    account(tag, old_size, false);
+    return on_allocated(new_block, size, offset, tag);
+#else
     stat_calls++;
+    account(s_tl_tag, size, true);
     return xr_internal_realloc(ptr, size, alignment);
+#endif
 }
 
 void xrMemory::mem_free(void* ptr)
 {
-    stat_calls++;
-    xr_internal_free(ptr, DEFAULT_ALIGNMENT);
+    mem_free(ptr, DEFAULT_ALIGNMENT);
 }
 
 void xrMemory::mem_free(void* ptr, size_t alignment)
 {
     stat_calls++;
+#if defined(USE_MEMORY_TAGS)
+    if (!ptr)
+        return;
+    xr_internal_free(on_free(ptr), block_offset(alignment));
+#else
     xr_internal_free(ptr, alignment);
+#endif
+}
+
+MemoryTag xrMemory::tag_set(MemoryTag tag)
+{
+    const MemoryTag previous = s_tl_tag;
+    s_tl_tag = tag;
+    return previous;
+}
+
+pcstr xrMemory::tag_name(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::Default: return "default";
+    case MemoryTag::ALife: return "alife";
+    case MemoryTag::Scripts: return "scripts";
+    case MemoryTag::Textures: return "textures";
+    case MemoryTag::Models: return "models";
+    case MemoryTag::Sounds: return "sounds";
+    case MemoryTag::CDB: return "cdb";
+    case MemoryTag::Strings: return "strings";
+    case MemoryTag::Physics: return "physics";
+    default: return "unknown";
+    }
+}
+
+void xrMemory::tag_stats(MemoryTag tag, size_t& bytes, size_t& count) const
+{
+#if defined(USE_MEMORY_TAGS)
+    const TagCounters& counters = s_tag_counters[size_t(tag)];
+    bytes = counters.bytes.load(std::memory_order_relaxed);
+    count = counters.count.load(std::memory_order_relaxed);
+#else
+    bytes = count = 0;
+#endif
+}
+
+void xrMemory::tag_allocated(MemoryTag tag, size_t& bytes, size_t& count) const
+{
+    const TagCounters& counters = s_tag_counters[size_t(tag)];
+    bytes = counters.allocated_bytes.load(std::memory_order_relaxed);
+    count = counters.allocated_count.load(std::memory_order_relaxed);
+}
+
+void xrMemory::tag_dump() const
+{
+    // Counters of this thread are folded right away, others lag a bit behind
+    s_tl_counters.fold();
+
+    size_t total_bytes = 0, total_count = 0, total_allocated_bytes = 0, total_allocated_count = 0;
+    for (size_t i = 0; i < size_t(MemoryTag::Count); ++i)
+    {
+        size_t bytes, count, allocated_bytes, allocated_count;
+        tag_stats(MemoryTag(i), bytes, count);
+        tag_allocated(MemoryTag(i), allocated_bytes, allocated_count);
+        total_bytes += bytes;
+        total_count += count;
+        total_allocated_bytes += allocated_bytes;
+        total_allocated_count += allocated_count;
+#if defined(USE_MEMORY_TAGS)
+        Msg("* [ memory ]: %-10s %10zu K in %zu blocks, %zu K allocated in %zu calls", tag_name(MemoryTag(i)),
+            bytes / 1024, count, allocated_bytes / 1024, allocated_count);
+#else
+        Msg("* [ memory ]: %-10s %zu K allocated in %zu calls", tag_name(MemoryTag(i)), allocated_bytes / 1024,
+            allocated_count);
+#endif
+    }
+#if defined(USE_MEMORY_TAGS)
+    Msg("* [ memory ]: %-10s %10zu K in %zu blocks, %zu K allocated in %zu calls", "total", total_bytes / 1024,
+        total_count, total_allocated_bytes / 1024, total_allocated_count);
+#else
+    Msg("* [ memory ]: %-10s %zu K allocated in %zu calls", "total", total_allocated_bytes / 1024,
+        total_allocated_count);
+    Msg("* [ memory ]: live blocks are accounted only in builds with memory tags (MEMORY_TAGS)");
+#endif
+}
+
+#if defined(USE_MEMORY_TAGS)
+void xrMemory::sample_start(u32 rate)
+{
+    const bool sampling = s_tl_sampling;
+    s_tl_sampling = true;
+    if (!s_samples_lock)
+        s_samples_lock = xr_new<Lock>();
+    {
+        ScopeLock lock(s_samples_lock);
+        if (rate)
+        {
+            if (!s_samples)
+                s_samples = xr_new<SampleMap>();
+            // Blocks sampled before are left marked, their removal is just a failed lookup
+            s_samples->clear();
+        }
+        s_sample_counter.store(0, std::memory_order_relaxed);
+        s_sample_rate.store(rate, std::memory_order_relaxed);
+    }
+    s_tl_sampling = sampling;
+}
+
+void xrMemory::sample_dump(u32 max_stacks) const
+{
+    struct StackStats
+    {
+        const SampleRecord* record;
+        size_t bytes;
+        u32 count;
+    };
+
+    const bool sampling = s_tl_sampling;
+    s_tl_sampling = true;
+
+    // Copy, so logging isn't done under the lock taken by allocations
+    xr_vector<SampleRecord> records;
+    if (s_samples_lock)
+    {
+        ScopeLock lock(s_samples_lock);
+        if (s_samples)
+        {
+            records.reserve(s_samples->size());
+            for (const auto& it : *s_samples)
+                records.push_back(it.second);
+        }
+    }
+
+    // Group by callstack
+    std::sort(records.begin(), records.end(), [](const SampleRecord& a, const SampleRecord& b)
+    {
+        if (a.frames_count != b.frames_count)
+            return a.frames_count < b.frames_count;
+        return memcmp(a.frames, b.frames, a.frames_count * sizeof(void*)) < 0;
+    });
+
+    xr_vector<StackStats> stacks;
+    for (const SampleRecord& record : records)
+    {
+        if (stacks.empty() || stacks.back().record->frames_count != record.frames_count ||
+            memcmp(stacks.back().record->frames, record.frames, record.frames_count * sizeof(void*)))
+        {
+            stacks.push_back({ &record, 0, 0 });
+        }
+        stacks.back().bytes += record.size;
+        ++stacks.back().count;
+    }
+    std::sort(stacks.begin(), stacks.end(), [](const StackStats& a, const StackStats& b) { return a.bytes > b.bytes; });
+
+    const u32 rate = std::max(s_sample_rate.load(std::memory_order_relaxed), 1u);
+    Msg("* [ memory ]: %zu live samples, 1 of %u allocations, %zu callstacks", records.size(), rate, stacks.size());
+    for (size_t i = 0; i < std::min(stacks.size(), size_t(max_stacks)); ++i)
+    {
+        const StackStats& stack = stacks[i];
+        Msg("- ~%zu K in %u samples [%s]", stack.bytes * rate / 1024, stack.count, tag_name(stack.record->tag));
+#if defined(XR_PLATFORM_LINUX)
+        char** symbols = backtrace_symbols(stack.record->frames, int(stack.record->frames_count));
+        for (u32 f = 0; symbols && f < stack.record->frames_count; ++f)
+            Msg("    %s", symbols[f]);
+        free(symbols);
+#else
+        for (u32 f = 0; f < stack.record->frames_count; ++f)
+            Msg("    %p", stack.record->frames[f]);
+#endif
+    }
+
+    s_tl_sampling = sampling;
+}
+#else
+void xrMemory::sample_start(u32 rate)
+{
+    if (rate)
+        Msg("! Allocation sampling needs memory tags, which are disabled in this build (MEMORY_TAGS)");
+}
+
+void xrMemory::sample_dump(u32 max_stacks) const
+{
+    Msg("! Allocation sampling needs memory tags, which are disabled in this build (MEMORY_TAGS)");
 }
+#endif // USE_MEMORY_TAGS
 
 // xr_strdup
 XRCORE_API pstr xr_strdup(pcstr string)
 {
-#ifdef USE_MIMALLOC
+#if defined(USE_MIMALLOC) && !defined(USE_MEMORY_TAGS)
     return mi_strdup(string);
 #else
     VERIFY(string);
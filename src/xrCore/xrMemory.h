@@ -4,6 +4,25 @@
 
 #include <new>
 
+// Subsystem which owns an allocation.
+// Current tag is thread-local and set with MemoryTagScope,
+// the block keeps its tag until it's freed.
+// Allocations are always counted per tag, live blocks only when built with MEMORY_TAGS.
+enum class MemoryTag : u8
+{
+    Default,
+    ALife,
+    Scripts,
+    Textures,
+    Models,
+    Sounds,
+    CDB,
+    Strings,
+    Physics,
+
+    Count
+};
+
 class XRCORE_API xrMemory
 {
 public:
@@ -17,6 +36,18 @@ public:
     size_t mem_usage();
     void   mem_compact();
 
+    // Allocation accounting
+    MemoryTag tag_set(MemoryTag tag); // returns previous tag of the thread
+    static pcstr tag_name(MemoryTag tag);
+    void tag_stats(MemoryTag tag, size_t& bytes, size_t& count) const; // live blocks
+    void tag_allocated(MemoryTag tag, size_t& bytes, size_t& count) const; // all allocations so far
+    void tag_dump() const;
+
+    // Every rate-th allocation remembers its callstack until it's freed, 0 stops sampling.
+    // Start before a level load and dump after it to find what stays alive.
+    void sample_start(u32 rate);
+    void sample_dump(u32 max_stacks) const;
+
     void* mem_alloc(size_t size);
     void* mem_alloc(size_t size, size_t alignment);
     void* mem_alloc(size_t size, const std::nothrow_t&) noexcept;
@@ -77,6 +108,18 @@ inline void operator delete(void* ptr, size_t, std::align_val_t alignment) noexc
     Memory.mem_free(ptr, static_cast<size_t>(alignment));
 }
 
+class MemoryTagScope
+{
+    MemoryTag m_previous;
+
+public:
+    MemoryTagScope(MemoryTag tag) : m_previous(Memory.tag_set(tag)) {}
+    ~MemoryTagScope() { Memory.tag_set(m_previous); }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+};
+
 template <typename T, typename... Args>
 inline T* xr_new(Args&&... args)
 {
@@ -84,6 +127,14 @@ inline T* xr_new(Args&&... args)
     return new (ptr) T(std::forward<Args>(args)...);
 }
 
+// Object and everything allocated by its constructor is accounted to the tag
+template <typename T, typename... Args>
+inline T* xr_new_tagged(MemoryTag tag, Args&&... args)
+{
+    MemoryTagScope scope(tag);
+    return xr_new<T>(std::forward<Args>(args)...);
+}
+
 template <class T>
 inline void xr_delete(T*& ptr) noexcept
 {
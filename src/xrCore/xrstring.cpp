@@ -181,6 +181,7 @@ str_value* str_container::dock(pcstr value)
 #endif // DEBUG
         )
     {
+        MemoryTagScope scope(MemoryTag::Strings);
         result = (str_value*)xr_malloc(sizeof(str_value) + s_len_with_zero);
 
 #ifdef DEBUG
@@ -325,7 +326,7 @@ str_value* str_container::dock(str_c value)
     if (0 == result || is_leaked_string)
     {
         // Insert string
-
+        MemoryTagScope scope(MemoryTag::Strings);
         result = (str_value*)xr_malloc(sizeof(str_value) + s_len_with_zero
 #ifdef DEBUG_MEMORY_NAME
             ,
@@ -5,11 +5,135 @@
 #include "xr_collide_form.h"
 #include "IGame_Level.h"
 #include "xrCDB/Intersect.hpp"
+#include "xrCore/Threading/ParallelFor.hpp"
 
 namespace Feel
 {
+VisionService g_vision_service;
+
+void VisionService::queue(Vision* observer, IGameObject* object, const Fvector& start, const Fvector& dir,
+    float range, float vis_threshold, float priority)
+{
+    Request& request = m_requests.emplace_back();
+    request.observer = observer;
+    request.object = object;
+    request.start = start;
+    request.dir = dir;
+    request.range = range;
+    request.vis_threshold = vis_threshold;
+    request.priority = priority;
+
+    // Rays with similar ends and threshold give the same result
+    Fvector end;
+    end.mad(start, dir, range);
+    const float values[] = { start.x, start.y, start.z, end.x, end.y, end.z };
+    u64 key = 14695981039346656037ull;
+    for (const float value : values)
+        key = (key ^ u64(s64(iFloor(value / lr_granularity)))) * 1099511628211ull;
+    request.key = (key ^ u64(iFloor(vis_threshold * 1000.f))) * 1099511628211ull;
+
+    ++m_queued;
+}
+
+void VisionService::cancel(Vision* observer, IGameObject* object)
+{
+    const auto it = std::remove_if(m_requests.begin(), m_requests.end(), [&](const Request& request)
+    {
+        return request.observer == observer && (!object || request.object == object);
+    });
+    m_requests.erase(it, m_requests.end());
+}
+
+void VisionService::flush()
+{
+    stats = {};
+    stats.queued = m_queued;
+    m_queued = 0;
+    if (m_requests.empty())
+        return;
+
+    CTimer timer;
+    timer.Start();
+
+    // The rest waits for the next frame
+    size_t count = m_requests.size();
+    if (count > size_t(max_rays_per_frame))
+    {
+        count = size_t(max_rays_per_frame);
+        std::nth_element(m_requests.begin(), m_requests.begin() + count, m_requests.end(),
+            [](const Request& a, const Request& b) { return a.priority > b.priority; });
+    }
+
+    std::sort(m_requests.begin(), m_requests.begin() + count,
+        [](const Request& a, const Request& b) { return a.key < b.key; });
+    m_unique.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i == 0 || m_requests[i].key != m_requests[i - 1].key)
+            m_unique.push_back(u32(i));
+    }
+
+    // Static geometry only, it is safe to query from the workers
+    const auto callback = [](collide::rq_result& result, LPVOID params)
+    {
+        Request& request = *static_cast<Request*>(params);
+        const float vis = request.observer->feel_vision_mtl_transp(result.O, result.element);
+        request.vis *= vis;
+        if (fis_zero(vis))
+        {
+            const CDB::TRI* T = g_pGameLevel->ObjectSpace.GetStaticTris() + result.element;
+            const Fvector* V = g_pGameLevel->ObjectSpace.GetStaticVerts();
+            request.tri[0].set(V[T->verts[0]]);
+            request.tri[1].set(V[T->verts[1]]);
+            request.tri[2].set(V[T->verts[2]]);
+            request.opaque = true;
+        }
+        return request.vis > request.vis_threshold;
+    };
+
+    xr_parallel_for(TaskRange<size_t>(0, m_unique.size(), 16), [&](const TaskRange<size_t>& range)
+    {
+        collide::rq_results RQR;
+        for (size_t i = range.begin(); i != range.end(); ++i)
+        {
+            Request& request = m_requests[m_unique[i]];
+            request.vis = 1.f;
+            request.opaque = false;
+            const collide::ray_defs RD(request.start, request.dir, request.range, CDB::OPT_CULL, collide::rqtStatic);
+            request.result = g_pGameLevel->ObjectSpace.RayQuery(RQR, RD, callback, &request, nullptr, nullptr);
+        }
+    });
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Request& request = m_requests[i];
+        if (i != 0 && request.key == m_requests[i - 1].key)
+        {
+            const Request& traced = m_requests[i - 1];
+            request.vis = traced.vis;
+            request.result = traced.result;
+            request.opaque = traced.opaque;
+            std::copy(std::begin(traced.tri), std::end(traced.tri), std::begin(request.tri));
+        }
+        request.observer->o_traced(request);
+    }
+    m_requests.erase(m_requests.begin(), m_requests.begin() + count);
+
+    stats.traced = u32(m_unique.size());
+    stats.shared = u32(count - m_unique.size());
+    stats.deferred = u32(m_requests.size());
+    stats.flush_ms = timer.GetElapsed_sec() * 1000.f;
+}
+
+void VisionService::clear()
+{
+    m_requests.clear();
+    m_queued = 0;
+    stats = {};
+}
+
 Vision::Vision(IGameObject const* owner) : pure_relcase(&Vision::feel_vision_relcase), m_owner(owner) {}
-Vision::~Vision() {}
+Vision::~Vision() { g_vision_service.cancel(this); }
 struct SFeelParam
 {
     Vision* parent;
@@ -51,6 +175,7 @@ void Vision::o_new(IGameObject* O)
 }
 void Vision::o_delete(IGameObject* O)
 {
+    g_vision_service.cancel(this, O);
     xr_vector<feel_visible_Item>::iterator I = feel_visible.begin(), TE = feel_visible.end();
     for (; I != TE; ++I)
         if (I->O == O)
@@ -62,6 +187,7 @@ void Vision::o_delete(IGameObject* O)
 
 void Vision::feel_vision_clear()
 {
+    g_vision_service.cancel(this);
     seen.clear();
     query.clear();
     diff.clear();
@@ -70,6 +196,7 @@ void Vision::feel_vision_clear()
 
 void Vision::feel_vision_relcase(IGameObject* object)
 {
+    g_vision_service.cancel(this, object);
     xr_vector<IGameObject*>::iterator Io;
     Io = std::find(seen.begin(), seen.end(), object);
     if (Io != seen.end())
@@ -116,7 +243,7 @@ void Vision::feel_vision_query(Fmatrix& mFull, Fvector& P)
     }
 }
 
-void Vision::feel_vision_update(IGameObject* parent, Fvector& P, float dt, float vis_threshold)
+void Vision::feel_vision_update(IGameObject* parent, Fvector& P, float dt, float vis_threshold, bool batched)
 {
     // B-A = objects, that become visible
     if (!seen.empty())
@@ -147,9 +274,28 @@ void Vision::feel_vision_update(IGameObject* parent, Fvector& P, float dt, float
 
     // Copy results and perform traces
     query = seen;
-    o_trace(P, dt, vis_threshold);
+    o_trace(P, dt, vis_threshold, batched);
+}
+
+void Vision::o_traced(const VisionService::Request& request)
+{
+    for (feel_visible_Item& I : feel_visible)
+    {
+        if (I.O != request.object)
+            continue;
+
+        I.trace_queued = false;
+        I.trace_valid = true;
+        I.trace_time = Device.dwTimeGlobal;
+        I.Cache_vis = request.vis;
+        I.Cache.set(request.start, request.dir, request.range, request.result);
+        if (request.opaque)
+            std::copy(std::begin(request.tri), std::end(request.tri), std::begin(I.Cache.verts));
+        return;
+    }
 }
-void Vision::o_trace(Fvector& P, float dt, float vis_threshold)
+
+void Vision::o_trace(Fvector& P, float dt, float vis_threshold, bool batched)
 {
     RQR.r_clear();
     xr_vector<feel_visible_Item>::iterator I = feel_visible.begin(), E = feel_visible.end();
@@ -202,6 +348,25 @@ void Vision::o_trace(Fvector& P, float dt, float vis_threshold)
                     feel_params.vis = 0.f;
                     // Log("cache 1");
                 }
+                else if (batched)
+                {
+                    // Static geometry is traced by the service, meanwhile the last result is used.
+                    // Far pairs are traced less often
+                    if (!I->trace_queued &&
+                        (!I->trace_valid || Device.dwTimeGlobal - I->trace_time >= u32(f * batched_trace_interval)))
+                    {
+                        float importance = 1.f;
+                        if (I->O == g_pGameLevel->CurrentViewEntity())
+                            importance *= 4.f;
+                        if (!I->trace_valid || (I->fuzzy > -.5f && I->fuzzy < 1.f))
+                            importance *= 2.f;
+                        g_vision_service.queue(this, I->O, P, D, f, vis_threshold, importance / (f + 1.f));
+                        I->trace_queued = true;
+                    }
+                    if (!I->trace_valid)
+                        continue;
+                    feel_params.vis = I->Cache_vis;
+                }
                 else
                 {
                     // cache outdated. real query.
@@ -221,6 +386,13 @@ void Vision::o_trace(Fvector& P, float dt, float vis_threshold)
                     // Log("query");
                 }
             }
+            // Batched cache holds static geometry only
+            if (batched && feel_params.vis > vis_threshold)
+            {
+                RD.tgt = collide::rq_target(collide::rqtObject | collide::rqtObstacle);
+                g_pGameLevel->ObjectSpace.RayQuery(RQR, RD, feel_vision_callback, &feel_params, NULL, NULL);
+            }
+
             // Log("Vis",feel_params.vis);
             r_spatial.clear();
             g_SpatialSpace->q_ray(r_spatial, 0, STYPE_VISIBLEFORAI, P, D, f);
@@ -14,10 +14,68 @@ const float fuzzy_update_vis = 1000.f; // speed of fuzzy-logic desisions
 const float fuzzy_update_novis = 1000.f; // speed of fuzzy-logic desisions
 const float fuzzy_guaranteed = 0.001f; // distance which is supposed 100% visible
 const float lr_granularity = 0.1f; // assume similar positions
+const float batched_trace_interval = 5.f; // ms per meter of distance between batched traces of the same pair
+
+class Vision;
+
+// Traces the vision rays of all observers at once.
+// Observers queue rays against static geometry which miss their ray caches,
+// the queue is traced in parallel once per frame and the results land in the observers' caches.
+// Until then observers use the last known result, dynamic objects are still checked by the observers.
+// Rays are shared between observers if they are similar, the queue is cut by priority
+// (closer and less certain pairs go first), the rest waits for the next frame.
+class ENGINE_API VisionService
+{
+    friend class Vision;
+
+    struct Request
+    {
+        Vision* observer;
+        IGameObject* object;
+        Fvector start;
+        Fvector dir;
+        float range;
+        float vis_threshold;
+        float priority;
+        u64 key;
+        // result
+        float vis;
+        bool result;
+        bool opaque; // hit opaque static triangle
+        Fvector tri[3];
+    };
+
+    xr_vector<Request> m_requests;
+    xr_vector<u32> m_unique;
+
+    u32 m_queued{};
+
+public:
+    int max_rays_per_frame = 512;
+
+    struct Stats
+    {
+        u32 queued;
+        u32 traced;
+        u32 shared; // took the result of a similar ray
+        u32 deferred; // left for the next frame
+        float flush_ms;
+    } stats{};
+
+    void queue(Vision* observer, IGameObject* object, const Fvector& start, const Fvector& dir, float range,
+        float vis_threshold, float priority);
+    void cancel(Vision* observer, IGameObject* object = nullptr);
+    // Called once per frame on the main thread
+    void flush();
+    void clear();
+};
+
+extern ENGINE_API VisionService g_vision_service;
 
 class ENGINE_API Vision : private pure_relcase
 {
     friend class pure_relcase;
+    friend class VisionService;
 
 private:
     xr_vector<IGameObject*> seen;
@@ -29,7 +87,8 @@ private:
 
     void o_new(IGameObject* E);
     void o_delete(IGameObject* E);
-    void o_trace(Fvector& P, float dt, float vis_threshold);
+    void o_trace(Fvector& P, float dt, float vis_threshold, bool batched);
+    void o_traced(const VisionService::Request& request);
 
 public:
     Vision(IGameObject const* owner);
@@ -44,14 +103,18 @@ public:
         IGameObject* O;
         float fuzzy; // note range: (-1[no]..1[yes])
         float Cache_vis;
+        u32 trace_time; // when the last batched trace result arrived
         u16 bone_id;
+        bool trace_queued;
+        bool trace_valid; // Cache_vis holds the result of a batched trace
     };
     xr_vector<feel_visible_Item> feel_visible;
 
 public:
     void feel_vision_clear();
     void feel_vision_query(Fmatrix& mFull, Fvector& P);
-    void feel_vision_update(IGameObject* parent, Fvector& P, float dt, float vis_threshold);
+    // Batched update takes visibility through static geometry from g_vision_service
+    void feel_vision_update(IGameObject* parent, Fvector& P, float dt, float vis_threshold, bool batched = false);
     void __stdcall feel_vision_relcase(IGameObject* object);
     void feel_vision_get(xr_vector<IGameObject*>& R)
     {
@@ -11,6 +11,7 @@
 #include "CameraManager.h"
 #include "xr_object.h"
 #include "Feel_Sound.h"
+#include "Feel_Vision.h"
 #include "xrServerEntities/smart_cast.h"
 
 ENGINE_API IGame_Level* g_pGameLevel = NULL;
@@ -41,6 +42,7 @@ IGame_Level::~IGame_Level()
     // Unregister
     Device.seqRender.Remove(this);
     Device.seqFrame.Remove(this);
+    Feel::g_vision_service.clear();
     CCameraManager::ResetPP();
     ///////////////////////////////////////////
     GEnv.Sound->set_geometry_occ(nullptr);
@@ -54,6 +56,7 @@ IGame_Level::~IGame_Level()
         GEnv.Render->ResourcesGetMemoryUsage(m_base, c_base, m_lmaps, c_lmaps);
 
     Msg("* [ D3D ]: textures[%d K]", (m_base + m_lmaps) / 1024);
+    Msg("* [ Level ]: region[%d K, %d objects]", u32(m_region.reserved() / 1024), m_region.allocations());
 }
 
 void IGame_Level::net_Stop()
@@ -95,6 +98,13 @@ bool IGame_Level::Load(u32 dwNum)
     IReader* LL_Stream = FS.r_open("$level$", "level");
     IReader& fs = *LL_Stream;
 
+    // Read the files of the next stages while cform is being built,
+    // they are opened again by their loaders and come from the OS and decompressed caches
+    const xr_vector<pcstr> level_files = { "level.geom", "level.geomx", "level.details", "level.hom", "level.som",
+        "level.ai", "level.gct", "level.ps_static", "level.snd_static", "level.snd_env", "level.fog_vol",
+        "level.env_mod" };
+    const auto prefetch = FS.r_open_async("$level$", level_files);
+
     // Header
     hdrLEVEL H;
     fs.r_chunk_safe(fsL_HEADER, &H, sizeof(H));
@@ -103,6 +113,8 @@ bool IGame_Level::Load(u32 dwNum)
     // CForms
     g_pGamePersistent->SetLoadStageTitle("st_loading_cform");
     g_pGamePersistent->LoadTitle();
+    // Collision geometry is the biggest part of the level, it is freed at once with the level
+    ObjectSpace.GetStaticModel()->set_region(&m_region);
     ObjectSpace.Load(build_callback);
     // GEnv.Sound->set_geometry_occ ( &Static );
     GEnv.Sound->set_geometry_occ(ObjectSpace.GetStaticModel());
@@ -180,6 +192,7 @@ void IGame_Level::OnFrame()
     VERIFY(bReady);
     Objects.Update(false);
     g_hud->OnFrame();
+    Feel::g_vision_service.flush();
 
     // Ambience
     if (Sounds_Random.size() && (Device.dwTimeGlobal > Sounds_Random_dwNextTime))
@@ -7,6 +7,7 @@
 #include "xrCDB/xr_area.h"
 #include "xrSound/Sound.h"
 #include "xrCore/FixedVector.h"
+#include "xrCore/Memory/MemoryRegion.h"
 #include "EngineAPI.h"
 #include "EventAPI.h"
 #include "pure.h"
@@ -58,6 +59,9 @@ class ENGINE_API IGame_Level : public FactoryObjectBase,
                                public pureFrame,
                                public IEventReceiver
 {
+    // Declared first to outlive everything else in the level
+    xrMemoryRegion m_region;
+
     bool m_world_rendered;
 
 protected:
@@ -78,6 +82,8 @@ public:
     CObjectList Objects;
     CObjectSpace ObjectSpace;
     CCameraManager& Cameras() { return *m_pCameras; };
+    // Level-scoped subsystems put their objects here, memory is released at once with the level
+    xrMemoryRegion& Region() { return m_region; }
     bool bReady;
 
     CInifile* pLevel;
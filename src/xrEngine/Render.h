@@ -221,6 +221,8 @@ public:
         u32 StaticWMCount; // ...number of static wallmark
         u32 DynamicWMCount; // ...number of dynamic wallmark
         u32 WMTriCount; // ...number of wallmark tri
+        CStatTimer Particles; // ...particle effects update
+        u32 ParticlesCount; // ...number of updated particles
         CStatTimer HUD; // ...hud rendering
         CStatTimer Glows; // ...glows vis-testing,sorting,render
         CStatTimer Lights; // ...d-lights building/rendering
@@ -247,6 +249,8 @@ public:
             StaticWMCount = 0;
             DynamicWMCount = 0;
             WMTriCount = 0;
+            Particles.FrameStart();
+            ParticlesCount = 0;
             HUD.FrameStart();
             Glows.FrameStart();
             Lights.FrameStart();
@@ -270,6 +274,7 @@ public:
             DetailRender.FrameEnd();
             DetailCache.FrameEnd();
             Wallmarks.FrameEnd();
+            Particles.FrameEnd();
             HUD.FrameEnd();
             Glows.FrameEnd();
             Lights.FrameEnd();
@@ -14,6 +14,7 @@
 #include "xrPhysics/IPHWorld.h"
 #include "PerformanceAlert.hpp"
 #include "xrCore/Threading/TaskManager.hpp"
+#include "xrCore/Memory/FrameArena.h"
 
 int g_ErrorLineCount = 15;
 Flags32 g_stats_flags = {0};
@@ -124,6 +125,34 @@ static void DumpTaskManagerStatistics(IGameFont& font, IPerformanceAlert* alert)
     finishedPrev = finished;
 }
 
+static void DumpFileSystemStatistics(IGameFont& font)
+{
+    using archive_stats = CLocatorAPI::archive_stats;
+    static archive_stats statsPrev{};
+    static u32 timePrev{};
+    static float hits{}, misses{}, decompressed{}, mmaps{}; // per second
+
+    const archive_stats stats = FS.get_archive_stats();
+    const u32 elapsed = Device.dwTimeContinual - timePrev;
+    if (elapsed >= 1000)
+    {
+        const float seconds = float(elapsed) / 1000.f;
+        hits = float(stats.cache_hits - statsPrev.cache_hits) / seconds;
+        misses = float(stats.cache_misses - statsPrev.cache_misses) / seconds;
+        decompressed = float(stats.bytes_decompressed - statsPrev.bytes_decompressed) / seconds;
+        mmaps = float(stats.mmap_calls - statsPrev.mmap_calls) / seconds;
+        statsPrev = stats;
+        timePrev = Device.dwTimeContinual;
+    }
+
+    font.OutNext("File system:");
+    font.OutNext("- cache:      %2.2fMb, %u hits, %u misses", float(stats.cache_size) / (1024.f * 1024.f),
+        stats.cache_hits, stats.cache_misses);
+    font.OutNext("- per second: %.0f hits, %.0f misses", hits, misses);
+    font.OutNext("- decompress: %2.2fMb/s", decompressed / (1024.f * 1024.f));
+    font.OutNext("- mmap:       %.0f/s", mmaps);
+}
+
 static void DumpSpatialStatistics(IGameFont& font, IPerformanceAlert* alert, ISpatial_DB& db, float engineTotal)
 {
 #ifdef DEBUG
@@ -178,10 +207,13 @@ void CStats::Show()
 #endif
         Device.DumpStatistics(font, alertPtr);
         font.OutNext("Memory:       %2.2f", fMem_calls);
+        font.OutNext("Frame arena:  %d, %2.2fKb", xrFrameArena::stat_allocations,
+            float(xrFrameArena::stat_bytes) / 1024.f);
         if (g_pGameLevel)
             g_pGameLevel->DumpStatistics(font, alertPtr);
         Engine.Sheduler.DumpStatistics(font, alertPtr);
         DumpTaskManagerStatistics(font, alertPtr);
+        DumpFileSystemStatistics(font);
         if (g_pGamePersistent)
         {
             g_pGamePersistent->DumpStatistics(font, alertPtr);
@@ -21,6 +21,7 @@
 #include "Render.h"
 
 #include "xrCore/FS_impl.h"
+#include "xrCore/Memory/FrameArena.h"
 #include "xrCore/Threading/TaskManager.hpp"
 
 #include "Include/editor/ide.hpp"
@@ -292,6 +293,7 @@ void CRenderDevice::ProcessFrame()
         Sleep(updateDelta - frameTime);
 
     TaskScheduler->Wait(processSeqParallel);
+    xrFrameArena::FrameEnd();
 
     if (!b_is_Active)
         Sleep(1);
@@ -16,6 +16,8 @@
 #include "xr_object.h"
 #include "xr_object_list.h"
 
+#include "xrCore/block_stream_reader.h"
+
 xr_vector<xr_token> VidQualityToken;
 
 extern xr_vector<xr_token> vid_monitor_token;
@@ -97,6 +99,94 @@ public:
     virtual void Execute(pcstr args) { g_pStringContainer->dump(); }
 };
 //-----------------------------------------------------------------------
+class CCC_MemTags : public IConsole_Command
+{
+public:
+    CCC_MemTags(pcstr N) : IConsole_Command(N) { bEmptyArgsHandled = true; };
+    virtual void Execute(pcstr args) { Memory.tag_dump(); }
+};
+class CCC_MemSample : public IConsole_Command
+{
+public:
+    CCC_MemSample(pcstr N) : IConsole_Command(N){};
+    virtual void Execute(pcstr args)
+    {
+        u32 rate = 0;
+        sscanf(args, "%u", &rate);
+        Memory.sample_start(rate);
+        if (rate)
+            Msg("Sampling callstacks of 1 of %u allocations", rate);
+        else
+            Msg("Allocation sampling stopped");
+    }
+    virtual void Info(TInfo& I) { xr_strcpy(I, "sample rate, 0 to stop"); }
+};
+class CCC_MemSampleDump : public IConsole_Command
+{
+public:
+    CCC_MemSampleDump(pcstr N) : IConsole_Command(N) { bEmptyArgsHandled = true; };
+    virtual void Execute(pcstr args)
+    {
+        u32 count = 20;
+        sscanf(args, "%u", &count);
+        Memory.sample_dump(count);
+    }
+    virtual void Info(TInfo& I) { xr_strcpy(I, "number of callstacks to dump"); }
+};
+//-----------------------------------------------------------------------
+class CCC_FSStreamBench : public IConsole_Command
+{
+public:
+    CCC_FSStreamBench(pcstr N) : IConsole_Command(N){};
+    virtual void Execute(pcstr args)
+    {
+        string_path file_name;
+        const CLocatorAPI::file* desc = nullptr;
+        if (!FS.exist(file_name, "$game_data$", args) || !(desc = FS.GetFileDesc(file_name)))
+        {
+            Msg("! Can't find file [%s]", args);
+            return;
+        }
+
+        const bool blocks = desc->size_compressed & CFS_BlockCompressMark;
+        const u32 stored = desc->size_compressed & ~CFS_BlockCompressMark;
+        const float size_mb = float(desc->size_real) / (1024.f * 1024.f);
+        Msg("Benchmarking [%s]: %s, %u Kb, %u Kb stored", file_name,
+            blocks ? "blocks" : desc->size_real == stored ? "stored" : "compressed", desc->size_real / 1024,
+            stored / 1024);
+
+        CTimer timer;
+        // Small sequential reads, the way sound decoders stream
+        if (blocks || desc->size_real == stored)
+        {
+            u8 buffer[16 * 1024];
+            timer.Start();
+            CStreamReader* S = FS.rs_open(nullptr, file_name);
+            while (S->elapsed() > 0)
+                S->r(buffer, std::min<size_t>(sizeof(buffer), S->elapsed()));
+            const float time = timer.GetElapsed_sec();
+            const size_t bytes_read = blocks ? static_cast<CBlockStreamReader*>(S)->bytes_read() : S->length();
+            const CStreamReader::stats stats = S->get_stats();
+            FS.r_close(S);
+            Msg("- stream: %.3fs, %.1f Mb/s, %u Kb read from archive", time, size_mb / time, u32(bytes_read / 1024));
+            if (!blocks)
+            {
+                Msg("- stall:  %.3fms in %u windows, %u read ahead", stats.stall_ms, stats.windows,
+                    stats.read_ahead);
+            }
+        }
+        else
+            Msg("- stream: not supported");
+
+        timer.Start();
+        IReader* R = FS.r_open(file_name);
+        const float time = timer.GetElapsed_sec();
+        FS.r_close(R);
+        Msg("- whole:  %.3fs, %.1f Mb/s, %u Kb read from archive", time, size_mb / time, stored / 1024);
+    }
+    virtual void Info(TInfo& I) { xr_strcpy(I, "file name in $game_data$"); }
+};
+//-----------------------------------------------------------------------
 class CCC_E_Dump : public IConsole_Command
 {
 public:
@@ -742,6 +832,11 @@ void CCC_Register()
     CMD1(CCC_SaveCFG, "cfg_save");
     CMD1(CCC_LoadCFG, "cfg_load");
 
+    CMD1(CCC_MemTags, "mem_tags");
+    CMD1(CCC_MemSample, "mem_sample");
+    CMD1(CCC_MemSampleDump, "mem_sample_dump");
+    CMD1(CCC_FSStreamBench, "fs_stream_bench");
+
 #ifdef DEBUG
     CMD3(CCC_Mask, "mt_particles", &psDeviceFlags, mtParticles);
 
@@ -280,6 +280,8 @@ public:
     virtual void net_MigrateInactive(NET_Packet& packet) = 0;
     virtual void net_MigrateActive(NET_Packet& packet) = 0;
     virtual void net_Relcase(IGameObject* obj) = 0; // destroy all links to another objects
+    // Only objects which need net_Relcase receive it, others should use CObjectHandle
+    virtual bool net_NeedRelcase() const = 0;
     virtual void save(NET_Packet& packet) = 0;
     virtual void load(IReader& reader) = 0;
     virtual void OnEvent(NET_Packet& packet, u16 type) = 0;
@@ -42,6 +42,7 @@ CObjectList::CObjectList() : m_owner_thread_id(Threading::GetCurrThreadId())
 {
     statsFrame = u32(-1);
     ZeroMemory(map_NETID, 0xffff * sizeof(IGameObject*));
+    ZeroMemory(map_generation, 0xffff * sizeof(u32));
 }
 
 CObjectList::~CObjectList()
@@ -291,15 +292,18 @@ void CObjectList::Update(bool bForce)
     // Destroy
     if (!destroy_queue.empty())
     {
+        // Handles of the destroyed objects are not resolved anymore
+        for (auto& dit : destroy_queue)
+        {
+            if (dit->ID() < 0xffff && map_NETID[dit->ID()] == dit)
+                map_generation[dit->ID()] = 0;
+        }
+
         // Info
-        for (Objects::iterator oit = objects_active.begin(); oit != objects_active.end(); ++oit)
+        // Handlers may subscribe other objects, so the list is iterated by index
+        for (size_t oit = 0; oit < objects_relcase.size(); ++oit)
             for (int it = destroy_queue.size() - 1; it >= 0; it--)
-            {
-                (*oit)->net_Relcase(destroy_queue[it]);
-            }
-        for (Objects::iterator oit = objects_sleeping.begin(); oit != objects_sleeping.end(); ++oit)
-            for (int it = destroy_queue.size() - 1; it >= 0; it--)
-                (*oit)->net_Relcase(destroy_queue[it]);
+                objects_relcase[oit]->net_Relcase(destroy_queue[it]);
 
         for (int it = destroy_queue.size() - 1; it >= 0; it--)
             GEnv.Sound->object_relcase(destroy_queue[it]);
@@ -310,12 +314,12 @@ void CObjectList::Update(bool bForce)
         {
             VERIFY(*(*it).m_ID == (it - m_relcase_callbacks.begin()));
             for (auto& dit : destroy_queue)
-            {
                 (*it).m_Callback(dit);
-                g_hud->net_Relcase(dit);
-            }
         }
 
+        for (auto& dit : destroy_queue)
+            g_hud->net_Relcase(dit);
+
         // Destroy
         for (int it = destroy_queue.size() - 1; it >= 0; it--)
         {
@@ -338,16 +342,39 @@ void CObjectList::net_Register(IGameObject* O)
     R_ASSERT(O);
     R_ASSERT(O->ID() < 0xffff);
 
+    if (map_NETID[O->ID()] != O)
+    {
+        // Generations are unique across levels, so old handles never match a new object
+        static u32 last_generation = 0;
+        if (0 == ++last_generation)
+            ++last_generation;
+        map_generation[O->ID()] = last_generation;
+    }
+
     map_NETID[O->ID()] = O;
     //. map_NETID.insert(std::make_pair(O->ID(),O));
     // Msg ("-------------------------------- Register: %s",O->cName());
+
+    if (O->net_NeedRelcase())
+        relcase_subscribe(O);
 }
 
 void CObjectList::net_Unregister(IGameObject* O)
 {
+    Objects::iterator I = std::find(objects_relcase.begin(), objects_relcase.end(), O);
+    if (I != objects_relcase.end())
+    {
+        *I = objects_relcase.back();
+        objects_relcase.pop_back();
+    }
+
     // R_ASSERT (O->ID() < 0xffff);
     if (O->ID() < 0xffff) // demo_spectator can have 0xffff
+    {
+        if (map_NETID[O->ID()] == O)
+            map_generation[O->ID()] = 0;
         map_NETID[O->ID()] = NULL;
+    }
     /*
      xr_map<u32,IGameObject*>::iterator it = map_NETID.find(O->ID());
      if ((it!=map_NETID.end()) && (it->second == O)) {
@@ -566,6 +593,23 @@ void CObjectList::relcase_unregister(int* ID)
     m_relcase_callbacks.pop_back();
 }
 
+void CObjectList::relcase_subscribe(IGameObject* O)
+{
+    if (std::find(objects_relcase.begin(), objects_relcase.end(), O) == objects_relcase.end())
+        objects_relcase.push_back(O);
+}
+
+CObjectHandle CObjectList::get_handle(const IGameObject* O) const
+{
+    CObjectHandle handle;
+    if (O && net_Find(O->ID()) == O)
+    {
+        handle.m_id = O->ID();
+        handle.m_generation = map_generation[handle.m_id];
+    }
+    return handle;
+}
+
 void CObjectList::dump_list(Objects& v, pcstr reason)
 {
 #ifdef DEBUG
@@ -8,6 +8,28 @@ extern ENGINE_API BOOL debug_destroy;
 class IGameObject;
 class NET_Packet;
 
+// Weak reference to a game object, it can be held instead of IGameObject* to not depend on net_Relcase.
+// CObjectList::net_Find resolves it in O(1), the result is nullptr once the object is destroyed,
+// even if its ID is already taken by another object.
+class CObjectHandle
+{
+    friend class CObjectList;
+
+    u32 m_generation;
+    u16 m_id;
+
+public:
+    CObjectHandle() : m_generation(0), m_id(u16(-1)) {}
+    IC u16 id() const { return m_id; }
+    IC bool empty() const { return m_generation == 0; }
+    IC void reset() { *this = CObjectHandle(); }
+    IC bool operator==(const CObjectHandle& other) const
+    {
+        return m_id == other.m_id && m_generation == other.m_generation;
+    }
+    IC bool operator!=(const CObjectHandle& other) const { return !(*this == other); }
+};
+
 class ENGINE_API CObjectList
 {
 public:
@@ -34,10 +56,14 @@ public:
 
 private:
     IGameObject* map_NETID[0xffff];
+    // Generation of the object registered with the ID, 0 if there is no object or it's being destroyed
+    u32 map_generation[0xffff];
     typedef xr_vector<IGameObject*> Objects;
     Objects destroy_queue;
     Objects objects_active;
     Objects objects_sleeping;
+    // Objects which receive net_Relcase, see IGameObject::net_NeedRelcase
+    Objects objects_relcase;
     /**
      * @brief m_primary_crows   - list of items of the primary thread
      * @brief m_secondary_crows - list of items of the secondary thread
@@ -61,6 +87,8 @@ public:
 
     void relcase_register(RELCASE_CALLBACK, int*);
     void relcase_unregister(int*);
+    // Object receives net_Relcase until it's unregistered
+    void relcase_subscribe(IGameObject* O);
 
 public:
     const ObjectUpdateStatistics& GetStats()
@@ -103,6 +131,16 @@ public:
         return (map_NETID[ID]);
     }
 
+    ICF IGameObject* net_Find(const CObjectHandle& handle) const
+    {
+        if (handle.m_id == u16(-1) || handle.m_generation != map_generation[handle.m_id])
+            return (0);
+
+        return (map_NETID[handle.m_id]);
+    }
+
+    CObjectHandle get_handle(const IGameObject* O) const;
+
     void o_crow(IGameObject* O);
     void o_remove(Objects& v, IGameObject* O);
     void o_activate(IGameObject* O);
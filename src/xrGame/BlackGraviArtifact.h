@@ -36,6 +36,7 @@ public:
 
 protected:
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
     virtual void UpdateCLChild();
 
     //гравитационный удар по всем объектам в зоне досягаемости
@@ -586,6 +586,7 @@ public:
     virtual bool net_Relevant() { return getLocal(); }; // relevant for export to server
     virtual bool UsedAI_Locations();
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
     // Input
     void OnAxisMove(float x, float y, float scale, bool invert);
     virtual void OnMouseMove(int x, int y);
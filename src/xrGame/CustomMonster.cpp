@@ -659,7 +659,8 @@ void CCustomMonster::eye_pp_s2()
     u32 dwTime = Level().timeServer();
     u32 dwDT = dwTime - eye_pp_timestamp;
     eye_pp_timestamp = dwTime;
-    feel_vision_update(this, eye_matrix.c, float(dwDT) / 1000.f, memory().visual().transparency_threshold());
+    feel_vision_update(this, eye_matrix.c, float(dwDT) / 1000.f, memory().visual().transparency_threshold(),
+        !!g_mt_config.test(mtAiVision));
     Level().AIStats.VisRayTests.End();
 }
 
@@ -63,6 +63,7 @@ public:
 
     float effective_radius(float nearest_shape_radius);
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
     virtual void OnEvent(NET_Packet& P, u16 type);
 
     float GetMaxPower() { return m_fMaxPower; }
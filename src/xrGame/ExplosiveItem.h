@@ -24,6 +24,7 @@ public:
     virtual void net_Export(NET_Packet& P) { CInventoryItemObject::net_Export(P); }
     virtual void net_Import(NET_Packet& P) { CInventoryItemObject::net_Import(P); }
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
     virtual CGameObject* cast_game_object() { return this; }
     virtual CExplosive* cast_explosive() { return this; }
     virtual IDamageSource* cast_IDamageSource() { return CExplosive::cast_IDamageSource(); }
@@ -34,6 +34,7 @@ public:
     virtual bool net_Spawn(CSE_Abstract* DC);
     virtual void net_Destroy();
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
     virtual void OnH_A_Independent();
     virtual void OnH_B_Independent(bool just_before_destroy);
     virtual void UpdateCL();
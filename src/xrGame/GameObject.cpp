@@ -516,6 +516,8 @@ bool CGameObject::net_Spawn(CSE_Abstract* DC)
     setReady(TRUE);
     if (!demo_spectator)
         g_pGameLevel->Objects.net_Register(this);
+    else if (net_NeedRelcase())
+        g_pGameLevel->Objects.relcase_subscribe(this);
 
     m_server_flags.one();
     if (O)
@@ -1269,6 +1271,9 @@ void CGameObject::net_Relcase(IGameObject* O)
         scriptBinder.net_Relcase(O);
 }
 
+// Script binder subscribes the object when it's bound later, see CScriptBinder::set_object
+bool CGameObject::net_NeedRelcase() const { return !GEnv.isDedicatedServer && scriptBinder.object(); }
+
 CGameObject::CScriptCallbackExVoid& CGameObject::callback(GameObject::ECallbackType type) const
 {
     return ((*m_callbacks)[type]);
@@ -233,10 +233,7 @@ void CHUDManager::OnConnected()
 
 void CHUDManager::net_Relcase(IGameObject* obj)
 {
-    HitMarker.net_Relcase(obj);
-
-    VERIFY(m_pHUDTarget);
-    m_pHUDTarget->net_Relcase(obj);
+    // Hit marks and the picked object are held by handles
 #ifdef DEBUG
     DBG_PH_NetRelcase(obj);
 #endif
@@ -106,9 +106,23 @@ void CHUDTarget::CursorOnFrame()
 
         if (Level().ObjectSpace.RayQuery(RQR, RD, pick_trace_callback, &PP, NULL, Level().CurrentEntity()))
             clamp(PP.RQ.range, NEAR_LIM, PP.RQ.range);
+
+        m_target = Level().Objects.get_handle(PP.RQ.O);
     }
 }
 
+void CHUDTarget::ValidateTarget()
+{
+    if (PP.RQ.O && !Level().Objects.net_Find(m_target))
+        PP.RQ.O = NULL;
+}
+
+collide::rq_result& CHUDTarget::GetRQ()
+{
+    ValidateTarget();
+    return PP.RQ;
+}
+
 extern ENGINE_API bool g_bRendering;
 void CHUDTarget::Render()
 {
@@ -118,6 +132,7 @@ void CHUDTarget::Render()
         return;
 
     VERIFY(g_bRendering);
+    ValidateTarget();
 
     IGameObject* O = Level().CurrentEntity();
     if (0 == O)
@@ -297,10 +312,3 @@ void CHUDTarget::Render()
     }
 }
 
-void CHUDTarget::net_Relcase(IGameObject* O)
-{
-    if (PP.RQ.O == O)
-        PP.RQ.O = NULL;
-
-    RQR.r_clear();
-}
@@ -2,6 +2,7 @@
 
 #include "HUDCrosshair.h"
 #include "xrCDB/xr_collide_defs.h"
+#include "xrEngine/xr_object_list.h"
 
 class CHUDManager;
 class CLAItem;
@@ -25,6 +26,10 @@ private:
 
 private:
     collide::rq_results RQR;
+    // Picked object, PP.RQ.O is reset when it's destroyed
+    CObjectHandle m_target;
+
+    void ValidateTarget();
 
 public:
     CHUDTarget();
@@ -32,9 +37,8 @@ public:
     void CursorOnFrame();
     void Render();
     void Load();
-    collide::rq_result& GetRQ() { return PP.RQ; };
+    collide::rq_result& GetRQ();
     float GetRQVis() { return PP.power; };
     CHUDCrosshair& GetHUDCrosshair() { return HUDCrosshair; }
     void ShowCrosshair(bool b);
-    void net_Relcase(IGameObject* O);
 };
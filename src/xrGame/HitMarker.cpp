@@ -7,6 +7,7 @@
 #include "xrUICore/Static/UIStaticItem.h"
 
 #include "Grenade.h"
+#include "Level.h"
 
 #include "Include/xrRender/UIRender.h"
 #include "Include/xrRender/UIShader.h"
@@ -85,7 +86,7 @@ bool CHitMarker::AddGrenade_ForMark(CGrenade* grn)
 {
     if (!grn)
         return false;
-    u16 new_id = grn->ID();
+    const CObjectHandle new_grenade = Level().Objects.get_handle(grn);
 
     GRENADEMARKS::iterator it_b = m_GrenadeMarks.begin();
     GRENADEMARKS::iterator it_e = m_GrenadeMarks.end();
@@ -94,7 +95,7 @@ bool CHitMarker::AddGrenade_ForMark(CGrenade* grn)
     {
         if ((*it_b)->removed_grenade)
             continue;
-        if ((*it_b)->p_grenade->ID() == new_id)
+        if ((*it_b)->grenade == new_grenade)
             return false;
     }
 
@@ -113,8 +114,8 @@ void CHitMarker::Update_GrenadeView(Fvector& pos_actor)
         if ((*it_b)->removed_grenade)
             continue;
 
-        CGrenade* grn = (*it_b)->p_grenade;
-        if (grn->IsExploding())
+        CGrenade* grn = (*it_b)->GetGrenade();
+        if (!grn || grn->IsExploding())
         {
             (*it_b)->removed_grenade = true;
             continue;
@@ -131,26 +132,6 @@ void CHitMarker::Update_GrenadeView(Fvector& pos_actor)
     }
 }
 
-void CHitMarker::net_Relcase(IGameObject* obj)
-{
-    u16 remove_id = obj->ID();
-
-    GRENADEMARKS::iterator it_b = m_GrenadeMarks.begin();
-    GRENADEMARKS::iterator it_e = m_GrenadeMarks.end();
-
-    for (; it_b != it_e; ++it_b)
-    {
-        if ((*it_b)->removed_grenade)
-            continue;
-
-        if ((*it_b)->p_grenade->ID() == remove_id)
-        {
-            (*it_b)->removed_grenade = true;
-            // break;
-        }
-    } // for
-}
-
 //==========================================================================================
 
 SHitMark::SHitMark(const ui_shader& sh, const Fvector& dir)
@@ -179,7 +160,7 @@ void SHitMark::Draw(float cam_dir)
 
 SGrenadeMark::SGrenadeMark(const ui_shader& sh, CGrenade* grn)
 {
-    p_grenade = grn;
+    grenade = Level().Objects.get_handle(grn);
     removed_grenade = false;
     m_LastTime = Device.fTimeGlobal;
     m_LightAnim = LALib.FindItem("hud_hit_mark");
@@ -201,6 +182,7 @@ void SGrenadeMark::Update(float angle)
 }
 
 bool SGrenadeMark::IsActive() const { return (2.0f * (Device.fTimeGlobal - m_LastTime) < m_LightAnim->Length_sec()); }
+CGrenade* SGrenadeMark::GetGrenade() const { return smart_cast<CGrenade*>(Level().Objects.net_Find(grenade)); }
 void SGrenadeMark::Draw(float cam_dir)
 {
     int frame;
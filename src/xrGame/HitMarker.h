@@ -6,6 +6,7 @@
 #include "xrUICore/ui_defs.h"
 #include "Common/Noncopyable.hpp"
 #include "xrCommon/xr_deque.h"
+#include "xrEngine/xr_object_list.h"
 
 class IUIShader;
 class CUIStaticItem;
@@ -28,7 +29,7 @@ struct SHitMark
 
 struct SGrenadeMark
 {
-    CGrenade* p_grenade;
+    CObjectHandle grenade;
     bool removed_grenade;
 
     CUIStaticItem* m_UIStaticItem;
@@ -40,6 +41,7 @@ struct SGrenadeMark
     ~SGrenadeMark();
 
     bool IsActive() const;
+    CGrenade* GetGrenade() const;
     void Draw(float cam_dir);
     void Update(float angle);
 };
@@ -67,8 +69,6 @@ public:
 
     void InitShader(LPCSTR tex_name);
     void InitShader_Grenade(LPCSTR tex_name);
-
-    void net_Relcase(IGameObject* obj);
 };
 
 #endif // __XR_HITMARKER_H__
@@ -3,6 +3,7 @@
 #include "xrEngine/FDemoPlay.h"
 #include "xrEngine/Environment.h"
 #include "xrEngine/IGame_Persistent.h"
+#include "xrEngine/Feel_Vision.h"
 #include "ParticlesObject.h"
 #include "Level.h"
 #include "HUDManager.h"
@@ -29,6 +30,8 @@
 #include "ClimableObject.h"
 #include "xrAICore/Navigation/level_graph.h"
 #include "mt_config.h"
+#include "action_planner.h"
+#include "object_handler_planner.h"
 #include "PHCommander.h"
 #include "map_manager.h"
 #include "xrEngine/CameraManager.h"
@@ -780,6 +783,18 @@ void CLevel::DumpStatistics(IGameFont& font, IPerformanceAlert* alert)
     font.OutNext("AI vision:    %2.2fms, %d", AIStats.Vis.result, AIStats.Vis.count);
     font.OutNext("- query:      %2.2fms", AIStats.VisQuery.result);
     font.OutNext("- rayCast:    %2.2fms", AIStats.VisRayTests.result);
+    const Feel::VisionService::Stats& vision = Feel::g_vision_service.stats;
+    font.OutNext("- batch:      %2.2fms, %d rays, %d shared, %d deferred", vision.flush_ms, vision.traced,
+        vision.shared, vision.deferred);
+    const auto dumpPlanners = [&](pcstr name, auto& planners) {
+        font.OutNext("- %-11s %2.1f%% cached (%d solves, %d searches), %d evals, %d memoised", name,
+            planners.solves ? 100.f * float(planners.hits) / float(planners.solves) : 0.f, planners.solves,
+            planners.searches, planners.evaluations, planners.memoised);
+        planners = {};
+    };
+    font.OutNext("AI planners:");
+    dumpPlanners("script:", CScriptActionPlanner::cache_stats());
+    dumpPlanners("objects:", CObjectHandlerPlanner::cache_stats());
     AIStats.FrameStart();
 }
 
@@ -60,6 +60,7 @@ protected:
 
     //для сети
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
 
 protected:
     //время нахождения в текущем состоянии
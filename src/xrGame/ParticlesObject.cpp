@@ -10,6 +10,43 @@
 
 const Fvector zero_vel = {0.f, 0.f, 0.f};
 
+// Standalone effects are updated by render in a batch after the game update,
+// so spatial of their objects is updated after the batch too
+class CParticlesSpatialUpdater : public pureFrame
+{
+    xr_vector<CParticlesObject*> m_objects;
+
+public:
+    void Add(CParticlesObject* object)
+    {
+        if (m_objects.empty())
+            Device.seqFrame.Add(this, REG_PRIORITY_LOW - 1);
+        m_objects.push_back(object);
+    }
+
+    void Remove(CParticlesObject* object)
+    {
+        const auto it = std::find(m_objects.begin(), m_objects.end(), object);
+        VERIFY(it != m_objects.end());
+        m_objects.erase(it);
+        if (m_objects.empty())
+            Device.seqFrame.Remove(this);
+    }
+
+    void OnFrame() override
+    {
+        for (CParticlesObject* object : m_objects)
+        {
+            object->m_bSpatialPending = false;
+            object->UpdateSpatial();
+        }
+        m_objects.clear();
+        Device.seqFrame.Remove(this);
+    }
+};
+
+static CParticlesSpatialUpdater ParticlesSpatialUpdater;
+
 CParticlesObject::CParticlesObject(LPCSTR p_name, BOOL bAutoRemove, bool destroy_on_game_load)
     : inherited(destroy_on_game_load)
 {
@@ -18,6 +55,7 @@ CParticlesObject::CParticlesObject(LPCSTR p_name, BOOL bAutoRemove, bool destroy
 
 void CParticlesObject::Init(LPCSTR p_name, IRender_Sector* S, BOOL bAutoRemove)
 {
+    m_bSpatialPending = false;
     m_bLooped = false;
     m_bStopping = false;
     m_bAutoRemove = bAutoRemove;
@@ -71,6 +109,8 @@ void CParticlesObject::Init(LPCSTR p_name, IRender_Sector* S, BOOL bAutoRemove)
 CParticlesObject::~CParticlesObject()
 {
     VERIFY(0 == mt_dt);
+    if (m_bSpatialPending)
+        ParticlesSpatialUpdater.Remove(this);
 
     //	we do not need this since CPS_Instance does it
     //	shedule_unregister		();
@@ -112,6 +152,14 @@ void CParticlesObject::UpdateSpatial()
     }
 }
 
+void CParticlesObject::UpdateSpatialDeferred()
+{
+    if (GEnv.isDedicatedServer || m_bSpatialPending)
+        return;
+    m_bSpatialPending = true;
+    ParticlesSpatialUpdater.Add(this);
+}
+
 const shared_str CParticlesObject::Name()
 {
     if (GEnv.isDedicatedServer)
@@ -196,7 +244,7 @@ void CParticlesObject::shedule_Update(u32 _dt)
         }
         dwLastTime = Device.dwTimeGlobal;
     }
-    UpdateSpatial();
+    UpdateSpatialDeferred();
 }
 
 void CParticlesObject::PerformAllTheWork(u32 _dt)
@@ -212,6 +260,7 @@ void CParticlesObject::PerformAllTheWork(u32 _dt)
         VERIFY(V);
         V->OnFrame(dt);
         dwLastTime = Device.dwTimeGlobal;
+        UpdateSpatialDeferred();
     }
     UpdateSpatial();
 }
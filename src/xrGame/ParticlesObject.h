@@ -9,8 +9,13 @@ class CParticlesObject : public CPS_Instance
     using inherited = CPS_Instance;
 
     u32 dwLastTime;
+    bool m_bSpatialPending;
     void Init(LPCSTR p_name, IRender_Sector* S, BOOL bAutoRemove);
     void UpdateSpatial();
+    // Render may update the effect later in the frame, bounds are taken after that
+    void UpdateSpatialDeferred();
+
+    friend class CParticlesSpatialUpdater;
 
 protected:
     bool m_bLooped; //флаг, что система зациклена
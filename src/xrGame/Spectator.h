@@ -72,6 +72,7 @@ public:
     virtual CGameObject* cast_game_object() { return this; }
     virtual IInputReceiver* cast_input_receiver() { return this; }
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
     void GetSpectatorString(string1024& pStr);
 
     virtual void On_SetEntity();
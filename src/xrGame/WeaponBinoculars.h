@@ -37,6 +37,7 @@ public:
     virtual bool use_crosshair() const { return false; }
     virtual bool GetBriefInfo(II_BriefInfo& info);
     virtual void net_Relcase(IGameObject* object);
+    virtual bool net_NeedRelcase() const { return true; }
 
 protected:
     CBinocularsVision* m_binoc_vision;
@@ -179,6 +179,8 @@ void CAI_Space::load(LPCSTR level_name)
 
 void CAI_Space::unload(bool reload)
 {
+    // Static covers are allocated in the region of the level being destroyed
+    m_cover_manager->clear();
     if (GEnv.isDedicatedServer)
         return;
     GEnv.ScriptEngine->unload();
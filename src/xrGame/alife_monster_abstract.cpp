@@ -181,6 +181,14 @@ ALife::EMeetActionType CSE_ALifeMonsterAbstract::tfGetActionType(
     **/
 }
 
+void CSE_ALifeMonsterAbstract::prepare_update(CGraphEngine& engine)
+{
+    if (!bfActive())
+        return;
+
+    brain().movement().prepare_update(engine);
+}
+
 bool CSE_ALifeMonsterAbstract::bfActive()
 {
     CSE_ALifeGroupAbstract* l_tpALifeGroupAbstract = smart_cast<CSE_ALifeGroupAbstract*>(this);
@@ -108,13 +108,13 @@ void CALifeMonsterDetailPathManager::update()
 }
 
 void CALifeMonsterDetailPathManager::make_inactual() { m_path.clear(); }
-void CALifeMonsterDetailPathManager::actualize()
+void CALifeMonsterDetailPathManager::actualize(CGraphEngine& engine)
 {
     m_path.clear();
 
     typedef GraphEngineSpace::CGameVertexParams CGameVertexParams;
     CGameVertexParams temp = CGameVertexParams(object().m_tpaTerrain);
-    bool failed = !ai().graph_engine().search(
+    bool failed = !engine.search(
         ai().game_graph(), object().get_object().m_tGraphID, m_destination.m_game_vertex_id, &m_path, temp);
 
 #ifdef DEBUG
@@ -172,7 +172,7 @@ void CALifeMonsterDetailPathManager::update(const ALife::_TIME_ID& time_delta)
 
     if (!actual())
     {
-        actualize();
+        actualize(ai().graph_engine());
 
         if (failed())
             return;
@@ -181,6 +181,15 @@ void CALifeMonsterDetailPathManager::update(const ALife::_TIME_ID& time_delta)
     follow_path(time_delta);
 }
 
+void CALifeMonsterDetailPathManager::prepare_update(CGraphEngine& engine)
+{
+    // Path for the current destination, update() will find it actual
+    if (!m_last_update_time || completed() || actual())
+        return;
+
+    actualize(engine);
+}
+
 void CALifeMonsterDetailPathManager::setup_current_speed()
 {
     if (ai().game_graph().vertex(object().get_object().m_tGraphID)->level_id() == ai().level_graph().level_id())
@@ -13,6 +13,7 @@
 
 class CMovementManagerHolder;
 class CALifeSmartTerrainTask;
+class CGraphEngine;
 
 class CALifeMonsterDetailPathManager
 {
@@ -47,7 +48,7 @@ private:
     // efficiently implemented in std::vector
 
 private:
-    void actualize();
+    void actualize(CGraphEngine& engine);
     void setup_current_speed();
     void follow_path(const ALife::_TIME_ID& time_delta);
     void update(const ALife::_TIME_ID& time_delta);
@@ -64,6 +65,7 @@ public:
 
 public:
     void update();
+    void prepare_update(CGraphEngine& engine);
     void on_switch_online();
     void on_switch_offline();
     IC void speed(const float& speed);
@@ -56,5 +56,12 @@ void CALifeMonsterMovementManager::update()
     };
 }
 
+void CALifeMonsterMovementManager::prepare_update(CGraphEngine& engine)
+{
+    // patrol path target is selected in update()
+    if (MovementManager::ePathTypeGamePath == path_type())
+        detail().prepare_update(engine);
+}
+
 void CALifeMonsterMovementManager::on_switch_online() { detail().on_switch_online(); }
 void CALifeMonsterMovementManager::on_switch_offline() { detail().on_switch_offline(); }
@@ -13,6 +13,7 @@
 class CMovementManagerHolder;
 class CALifeMonsterDetailPathManager;
 class CALifeMonsterPatrolPathManager;
+class CGraphEngine;
 
 //namespace MovementManager
 //{
@@ -43,6 +44,7 @@ public:
 
 public:
     void update();
+    void prepare_update(CGraphEngine& engine);
     void on_switch_online();
     void on_switch_offline();
     IC void path_type(const EPathType& path_type);
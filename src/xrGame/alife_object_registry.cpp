@@ -24,22 +24,31 @@ CALifeObjectRegistry::~CALifeObjectRegistry()
         xr_delete((*I).second);
 }
 
-void CALifeObjectRegistry::save(IWriter& memory_stream, CSE_ALifeDynamicObject* object, u32& object_count)
+void CALifeObjectRegistry::save(IWriter& memory_stream, CSE_ALifeDynamicObject* object, u32& object_count,
+    SAVED_OBJECTS& saved, bool changed_only)
 {
-    ++object_count;
-
-    NET_Packet tNetPacket;
+    NET_Packet tSpawnPacket, tUpdatePacket;
     // Spawn
-    object->Spawn_Write(tNetPacket, TRUE);
-    memory_stream.w_u16(u16(tNetPacket.B.count));
-    memory_stream.w(tNetPacket.B.data, tNetPacket.B.count);
+    object->Spawn_Write(tSpawnPacket, TRUE);
 
     // Update
-    tNetPacket.w_begin(M_UPDATE);
-    object->UPDATE_Write(tNetPacket);
+    tUpdatePacket.w_begin(M_UPDATE);
+    object->UPDATE_Write(tUpdatePacket);
+
+    const u32 crc = crc32(tUpdatePacket.B.data, tUpdatePacket.B.count,
+        crc32(tSpawnPacket.B.data, tSpawnPacket.B.count));
+    const u64 state = (u64(tSpawnPacket.B.count + tUpdatePacket.B.count) << 32) | crc;
+    saved.emplace(object->ID, state);
 
-    memory_stream.w_u16(u16(tNetPacket.B.count));
-    memory_stream.w(tNetPacket.B.data, tNetPacket.B.count);
+    SAVED_OBJECTS::const_iterator J = m_saved_objects.find(object->ID);
+    if (!changed_only || J == m_saved_objects.end() || (*J).second != state)
+    {
+        ++object_count;
+        memory_stream.w_u16(u16(tSpawnPacket.B.count));
+        memory_stream.w(tSpawnPacket.B.data, tSpawnPacket.B.count);
+        memory_stream.w_u16(u16(tUpdatePacket.B.count));
+        memory_stream.w(tUpdatePacket.B.data, tUpdatePacket.B.count);
+    }
 
     ALife::OBJECT_VECTOR::const_iterator I = object->children.begin();
     ALife::OBJECT_VECTOR::const_iterator E = object->children.end();
@@ -52,18 +61,17 @@ void CALifeObjectRegistry::save(IWriter& memory_stream, CSE_ALifeDynamicObject*
         if (!child->can_save())
             continue;
 
-        save(memory_stream, child, object_count);
+        save(memory_stream, child, object_count, saved, changed_only);
     }
 }
 
-void CALifeObjectRegistry::save(IWriter& memory_stream)
+u32 CALifeObjectRegistry::save(IWriter& memory_stream, SAVED_OBJECTS& saved, bool changed_only)
 {
-    Msg("* Saving objects...");
-    memory_stream.open_chunk(OBJECT_CHUNK_DATA);
-
     u32 position = memory_stream.tell();
     memory_stream.w_u32(u32(-1));
 
+    saved.reserve(m_objects.size());
+
     u32 object_count = 0;
     OBJECT_REGISTRY::iterator I = m_objects.begin();
     OBJECT_REGISTRY::iterator E = m_objects.end();
@@ -78,7 +86,7 @@ void CALifeObjectRegistry::save(IWriter& memory_stream)
         if ((*I).second->ID_Parent != 0xffff)
             continue;
 
-        save(memory_stream, (*I).second, object_count);
+        save(memory_stream, (*I).second, object_count, saved, changed_only);
     }
 
     u32 last_position = memory_stream.tell();
@@ -86,11 +94,58 @@ void CALifeObjectRegistry::save(IWriter& memory_stream)
     memory_stream.w_u32(object_count);
     memory_stream.seek(last_position);
 
+    return object_count;
+}
+
+void CALifeObjectRegistry::save(IWriter& memory_stream)
+{
+    Msg("* Saving objects...");
+    memory_stream.open_chunk(OBJECT_CHUNK_DATA);
+
+    SAVED_OBJECTS saved;
+    const u32 object_count = save(memory_stream, saved, false);
+    m_saved_objects.swap(saved);
+
     memory_stream.close_chunk();
 
     Msg("* %d objects are successfully saved", object_count);
 }
 
+void CALifeObjectRegistry::save_delta(IWriter& memory_stream)
+{
+    Msg("* Saving changed objects...");
+    memory_stream.open_chunk(OBJECT_DELTA_CHUNK_DATA);
+
+    SAVED_OBJECTS saved;
+    const u32 object_count = save(memory_stream, saved, true);
+
+    u32 position = memory_stream.tell();
+    memory_stream.w_u32(u32(-1));
+
+    u32 removed_count = 0;
+    SAVED_OBJECTS::const_iterator I = m_saved_objects.begin();
+    SAVED_OBJECTS::const_iterator E = m_saved_objects.end();
+    for (; I != E; ++I)
+    {
+        if (saved.find((*I).first) != saved.end())
+            continue;
+
+        ++removed_count;
+        memory_stream.w_u16((*I).first);
+    }
+
+    u32 last_position = memory_stream.tell();
+    memory_stream.seek(position);
+    memory_stream.w_u32(removed_count);
+    memory_stream.seek(last_position);
+
+    m_saved_objects.swap(saved);
+
+    memory_stream.close_chunk();
+
+    Msg("* %d objects are successfully saved, %d objects are removed", object_count, removed_count);
+}
+
 CSE_ALifeDynamicObject* CALifeObjectRegistry::get_object(IReader& file_stream)
 {
     NET_Packet tNetPacket;
@@ -126,6 +181,62 @@ CSE_ALifeDynamicObject* CALifeObjectRegistry::get_object(IReader& file_stream)
     return (tpALifeDynamicObject);
 }
 
+ALife::_OBJECT_ID CALifeObjectRegistry::skip_object(IReader& file_stream)
+{
+    NET_Packet tNetPacket;
+    u16 u_id;
+    // Spawn
+    tNetPacket.B.count = file_stream.r_u16();
+    file_stream.r(tNetPacket.B.data, tNetPacket.B.count);
+    tNetPacket.r_begin(u_id);
+    R_ASSERT2(M_SPAWN == u_id, "Invalid packet ID (!= M_SPAWN)");
+
+    // See CSE_Abstract::Spawn_Write
+    tNetPacket.skip_stringZ(); // s_name
+    tNetPacket.skip_stringZ(); // s_name_replace
+    tNetPacket.r_advance(2 * sizeof(u8) + 2 * sizeof(Fvector) + sizeof(u16));
+    ALife::_OBJECT_ID id = tNetPacket.r_u16();
+
+    // Update
+    file_stream.advance(file_stream.r_u16());
+
+    return (id);
+}
+
+void CALifeObjectRegistry::merge(IReader& file_stream, const xr_vector<IReader*>& deltas, IWriter& memory_stream)
+{
+    // Ordered by ID, so the actor is the first one as in the full snapshot
+    typedef xr_map<ALife::_OBJECT_ID, std::pair<const void*, u32>> OBJECT_DATA;
+    OBJECT_DATA objects;
+
+    const auto read_objects = [&objects](IReader& stream)
+    {
+        for (u32 count = stream.r_u32(); count; --count)
+        {
+            const u8* data = static_cast<const u8*>(stream.pointer());
+            const ALife::_OBJECT_ID id = skip_object(stream);
+            objects[id] = std::make_pair(data, u32(static_cast<const u8*>(stream.pointer()) - data));
+        }
+    };
+
+    R_ASSERT2(file_stream.find_chunk(OBJECT_CHUNK_DATA), "Can't find chunk OBJECT_CHUNK_DATA!");
+    read_objects(file_stream);
+
+    for (IReader* delta : deltas)
+    {
+        R_ASSERT2(delta->find_chunk(OBJECT_DELTA_CHUNK_DATA), "Can't find chunk OBJECT_DELTA_CHUNK_DATA!");
+        read_objects(*delta);
+        for (u32 count = delta->r_u32(); count; --count)
+            objects.erase(delta->r_u16());
+    }
+
+    memory_stream.open_chunk(OBJECT_CHUNK_DATA);
+    memory_stream.w_u32(u32(objects.size()));
+    for (const auto& object : objects)
+        memory_stream.w(object.second.first, object.second.second);
+    memory_stream.close_chunk();
+}
+
 void CALifeObjectRegistry::load(IReader& file_stream)
 {
     Msg("* Loading objects...");
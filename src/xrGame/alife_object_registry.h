@@ -15,20 +15,31 @@ class CALifeObjectRegistry
 {
 public:
     typedef xr_map<ALife::_OBJECT_ID, CSE_ALifeDynamicObject*> OBJECT_REGISTRY;
+    // Size and CRC of the saved object data
+    typedef xr_unordered_map<ALife::_OBJECT_ID, u64> SAVED_OBJECTS;
 
 protected:
     OBJECT_REGISTRY m_objects;
+    // Objects written by the last save() or save_delta(), used to find objects changed since then
+    SAVED_OBJECTS m_saved_objects;
 
 private:
-    void save(IWriter& memory_stream, CSE_ALifeDynamicObject* object, u32& object_count);
+    void save(IWriter& memory_stream, CSE_ALifeDynamicObject* object, u32& object_count, SAVED_OBJECTS& saved,
+        bool changed_only);
+    u32 save(IWriter& memory_stream, SAVED_OBJECTS& saved, bool changed_only);
 
 public:
     static CSE_ALifeDynamicObject* get_object(IReader& file_stream);
+    static ALife::_OBJECT_ID skip_object(IReader& file_stream);
+    // Writes OBJECT_CHUNK_DATA of the snapshot made of the full snapshot and its deltas
+    static void merge(IReader& file_stream, const xr_vector<IReader*>& deltas, IWriter& memory_stream);
 
 public:
     CALifeObjectRegistry(LPCSTR section);
     virtual ~CALifeObjectRegistry();
     virtual void save(IWriter& memory_stream);
+    // Writes OBJECT_DELTA_CHUNK_DATA with the objects changed, added or removed since the last save
+    void save_delta(IWriter& memory_stream);
     void load(IReader& file_stream);
     IC void add(CSE_ALifeDynamicObject* object);
     IC void remove(const ALife::_OBJECT_ID& id, bool no_assert = false);
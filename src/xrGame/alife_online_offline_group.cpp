@@ -62,6 +62,15 @@ void CSE_ALifeOnlineOfflineGroup::update()
     return;
 }
 
+void CSE_ALifeOnlineOfflineGroup::prepare_update(CGraphEngine& engine)
+{
+    // location is taken from the commander in update()
+    if (m_bOnline || !bfActive())
+        return;
+
+    brain().movement().prepare_update(engine);
+}
+
 void CSE_ALifeOnlineOfflineGroup::on_location_change() const { brain().on_location_change(); }
 void CSE_ALifeOnlineOfflineGroup::register_member(ALife::_OBJECT_ID member_id)
 {
@@ -0,0 +1,171 @@
+#include "StdAfx.h"
+#include "alife_prefetch_manager.h"
+#include "xrCore/Threading/ScopeLock.hpp"
+#include "xrEngine/GameFont.h"
+#include "Include/xrRender/RenderVisual.h"
+
+namespace
+{
+constexpr float prefetch_budget_ms = 2.f;
+constexpr u32 prefetch_timeout = 30000; // ms without touch from the switch manager
+} // namespace
+
+bool CALifePrefetchManager::touch(ALife::_OBJECT_ID id)
+{
+    ScopeLock lock(&m_lock);
+    const auto I = m_entries.find(id);
+    if (I == m_entries.end())
+        return false;
+
+    (*I).second.touch_time = Device.dwTimeGlobal;
+    return true;
+}
+
+void CALifePrefetchManager::request(ALife::_OBJECT_ID id, xr_vector<shared_str>&& visuals)
+{
+    if (visuals.empty())
+        return;
+
+    ScopeLock lock(&m_lock);
+    SEntry& entry = m_entries[id];
+    entry.visuals = std::move(visuals);
+    entry.state = eStatePending;
+    entry.touch_time = Device.dwTimeGlobal;
+    entry.loaded = 0;
+    entry.bytes = 0;
+    m_queue.push_back(id);
+    ++m_stats.requested;
+}
+
+void CALifePrefetchManager::on_cancel(const SEntry& entry)
+{
+    if (!entry.loaded)
+        return;
+
+    ++m_stats.cancelled;
+    m_stats.bytes_wasted += entry.bytes;
+}
+
+void CALifePrefetchManager::cancel(ALife::_OBJECT_ID id)
+{
+    ScopeLock lock(&m_lock);
+    const auto I = m_entries.find(id);
+    if (I == m_entries.end())
+        return;
+
+    on_cancel((*I).second);
+    m_entries.erase(I);
+}
+
+void CALifePrefetchManager::on_switch_online(ALife::_OBJECT_ID id)
+{
+    ScopeLock lock(&m_lock);
+    const auto I = m_entries.find(id);
+    if (I == m_entries.end())
+    {
+        ++m_stats.misses;
+        return;
+    }
+
+    if ((*I).second.state == eStateLoaded)
+        ++m_stats.hits;
+    else
+        ++m_stats.late;
+
+    m_entries.erase(I);
+}
+
+void CALifePrefetchManager::process()
+{
+    CTimer timer;
+    timer.Start();
+
+    {
+        ScopeLock lock(&m_lock);
+        for (auto I = m_entries.begin(); I != m_entries.end();)
+        {
+            // object disappeared or the switch manager doesn't reach it anymore
+            if (Device.dwTimeGlobal - (*I).second.touch_time > prefetch_timeout)
+            {
+                on_cancel((*I).second);
+                I = m_entries.erase(I);
+            }
+            else
+                ++I;
+        }
+    }
+
+    while (timer.GetElapsed_sec() * 1000.f < prefetch_budget_ms)
+    {
+        ALife::_OBJECT_ID id = ALife::_OBJECT_ID(-1);
+        shared_str visual;
+        {
+            ScopeLock lock(&m_lock);
+            for (; !m_queue.empty(); m_queue.pop_front())
+            {
+                const auto I = m_entries.find(m_queue.front());
+                if (I == m_entries.end() || (*I).second.state != eStatePending)
+                    continue;
+
+                // the id stays in the queue until all of its visuals are loaded
+                id = (*I).first;
+                visual = (*I).second.visuals[(*I).second.loaded];
+                break;
+            }
+        }
+        if (!visual)
+            break;
+
+        // Model pool loads geometry, shaders, textures and motions of the base model,
+        // the instance is returned to the pool and picked up by the client object
+        IRenderVisual* V = GEnv.Render->model_Create(visual.c_str());
+        GEnv.Render->model_Delete(V, false);
+
+        u32 bytes = 0;
+        string_path file_name;
+        if (FS.exist(file_name, "$game_meshes$", visual.c_str(), ".ogf"))
+            bytes = u32(FS.file_length(file_name));
+
+        ScopeLock lock(&m_lock);
+        m_stats.bytes_loaded += bytes;
+
+        // the object could be cancelled or requested again while its visual was loading
+        const auto I = m_entries.find(id);
+        if (I == m_entries.end() || (*I).second.state != eStatePending ||
+            (*I).second.visuals[(*I).second.loaded] != visual)
+        {
+            m_stats.bytes_wasted += bytes;
+            continue;
+        }
+
+        SEntry& entry = (*I).second;
+        entry.bytes += bytes;
+        if (++entry.loaded == entry.visuals.size())
+            entry.state = eStateLoaded;
+    }
+}
+
+void CALifePrefetchManager::clear()
+{
+    ScopeLock lock(&m_lock);
+    m_entries.clear();
+    m_queue.clear();
+    m_stats = {};
+}
+
+void CALifePrefetchManager::DumpStatistics(IGameFont& font) const
+{
+    ScopeLock lock(&m_lock);
+    u32 loaded = 0;
+    for (const auto& it : m_entries)
+        if (it.second.state == eStateLoaded)
+            ++loaded;
+
+    const u32 switched = m_stats.hits + m_stats.late + m_stats.misses;
+    font.OutNext("ALife prefetch:");
+    font.OutNext("- entries:    %d pending, %d loaded", u32(m_entries.size()) - loaded, loaded);
+    font.OutNext("- hit rate:   %2.1f%% (%d hits, %d late, %d misses)",
+        switched ? 100.f * float(m_stats.hits) / float(switched) : 0.f, m_stats.hits, m_stats.late, m_stats.misses);
+    font.OutNext("- loaded:     %2.2fMb, %d requests", float(m_stats.bytes_loaded) / (1024.f * 1024.f), m_stats.requested);
+    font.OutNext("- wasted:     %2.2fMb, %d cancelled", float(m_stats.bytes_wasted) / (1024.f * 1024.f), m_stats.cancelled);
+}
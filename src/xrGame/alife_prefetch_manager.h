@@ -0,0 +1,61 @@
+#pragma once
+
+#include "alife_space.h"
+#include "xrCore/Threading/Lock.hpp"
+
+class IGameFont;
+
+// Loads visuals of offline objects inside of the prefetch ring around the actor,
+// so client objects spawned by switch_online find instances ready in the model pool.
+// Loaded instances stay in the pool, cancelled ones are reused by the next object with the same visual.
+// Requests come from the switch manager (possibly on the ALife thread),
+// loading is done on the main thread within a time budget per frame, without holding the lock.
+class CALifePrefetchManager
+{
+    enum EState
+    {
+        eStatePending,
+        eStateLoaded,
+    };
+
+    struct SEntry
+    {
+        xr_vector<shared_str> visuals; // object and its children
+        EState state;
+        u32 touch_time;
+        u32 loaded; // visuals loaded so far
+        u32 bytes;
+    };
+
+    struct SStats
+    {
+        u32 requested;
+        u32 hits; // loaded before the object switched online
+        u32 late; // still pending when the object switched online
+        u32 misses; // switched online without a request
+        u32 cancelled; // left the ring or disappeared after loading
+        u64 bytes_loaded;
+        u64 bytes_wasted; // loaded for cancelled objects
+    };
+
+    xr_map<ALife::_OBJECT_ID, SEntry> m_entries;
+    xr_deque<ALife::_OBJECT_ID> m_queue;
+    SStats m_stats{};
+    mutable Lock m_lock;
+
+    void on_cancel(const SEntry& entry);
+
+public:
+    // Called for offline objects by the switch manager.
+    // Returns false if the object isn't requested yet.
+    bool touch(ALife::_OBJECT_ID id);
+    void request(ALife::_OBJECT_ID id, xr_vector<shared_str>&& visuals);
+    void cancel(ALife::_OBJECT_ID id);
+    void on_switch_online(ALife::_OBJECT_ID id);
+
+    // Main thread
+    void process();
+    void clear();
+
+    void DumpStatistics(IGameFont& font) const;
+};
@@ -8,8 +8,14 @@
 
 #include "StdAfx.h"
 #include "alife_schedule_registry.h"
+#include "ai_space.h"
+#include "xrAICore/Navigation/game_graph.h"
+#include "xrAICore/Navigation/graph_engine.h"
+#include "xrCore/Threading/ParallelFor.hpp"
+#include "xrCore/Threading/ScopeLock.hpp"
+#include "Common/object_broker.h"
 
-CALifeScheduleRegistry::~CALifeScheduleRegistry() {}
+CALifeScheduleRegistry::~CALifeScheduleRegistry() { delete_data(m_graph_engines); }
 void CALifeScheduleRegistry::add(CSE_ALifeDynamicObject* object)
 {
     CSE_ALifeSchedulable* schedulable = smart_cast<CSE_ALifeSchedulable*>(object);
@@ -30,3 +36,56 @@ void CALifeScheduleRegistry::remove(CSE_ALifeDynamicObject* object, bool no_asse
 
     inherited::remove(object->ID, no_assert || !schedulable->need_update(object));
 }
+
+CGraphEngine* CALifeScheduleRegistry::acquire_graph_engine()
+{
+    ScopeLock lock(&m_graph_engines_lock);
+    if (m_graph_engines.empty())
+        return xr_new<CGraphEngine>(ai().game_graph().header().vertex_count());
+
+    CGraphEngine* engine = m_graph_engines.back();
+    m_graph_engines.pop_back();
+    return engine;
+}
+
+void CALifeScheduleRegistry::release_graph_engine(CGraphEngine* engine)
+{
+    ScopeLock lock(&m_graph_engines_lock);
+    m_graph_engines.push_back(engine);
+}
+
+u32 CALifeScheduleRegistry::update_parallel()
+{
+    m_batch.clear();
+    inherited::update(CCollectPredicate(m_objects_per_update, m_batch), false);
+
+    m_batch_ids.clear();
+    for (CSE_ALifeSchedulable* schedulable : m_batch)
+        m_batch_ids.push_back(schedulable->base()->ID);
+
+    // Game paths are searched in parallel, objects don't see each other here
+    START_PROFILE("ALife/scheduled/prepare")
+    xr_parallel_for(TaskRange<size_t>(0, m_batch.size()), [this](const TaskRange<size_t>& range)
+    {
+        CGraphEngine* engine = acquire_graph_engine();
+        for (size_t i = range.begin(); i != range.end(); ++i)
+            m_batch[i]->prepare_update(*engine);
+        release_graph_engine(engine);
+    });
+    STOP_PROFILE
+
+    // Interactions, scripts and registry changes stay serial and in the registry order,
+    // so the result doesn't depend on the number of threads
+    for (const ALife::_OBJECT_ID id : m_batch_ids)
+    {
+        // update of the previous object could remove this one
+        CSE_ALifeSchedulable* schedulable = object(id, true);
+        if (!schedulable)
+            continue;
+
+        START_PROFILE("ALife/scheduled/update")
+        schedulable->update();
+        STOP_PROFILE
+    }
+    return u32(m_batch_ids.size());
+}
@@ -11,7 +11,11 @@
 #include "safe_map_iterator.h"
 #include "xrServer_Objects_ALife.h"
 #include "ai_debug.h"
+#include "mt_config.h"
 #include "xrEngine/profiler.h"
+#include "xrCore/Threading/Lock.hpp"
+
+class CGraphEngine;
 
 class CALifeScheduleRegistry
     : public CSafeMapIterator<ALife::_OBJECT_ID, CSE_ALifeSchedulable, std::less<ALife::_OBJECT_ID>, false>
@@ -50,18 +54,43 @@ private:
         }
     };
 
+    // Selects the same objects as CUpdatePredicate, but only collects them
+    struct CCollectPredicate : public CUpdatePredicate
+    {
+        xr_vector<CSE_ALifeSchedulable*>* m_batch;
+
+        IC CCollectPredicate(const u32& count, xr_vector<CSE_ALifeSchedulable*>& batch) : CUpdatePredicate(count)
+        {
+            m_batch = &batch;
+        }
+
+        using CUpdatePredicate::operator();
+
+        IC void operator()(_iterator& i, u64 cycle_count) const { m_batch->push_back((*i).second); }
+    };
+
 protected:
     typedef CSafeMapIterator<ALife::_OBJECT_ID, CSE_ALifeSchedulable, std::less<ALife::_OBJECT_ID>, false> inherited;
 
 protected:
     u32 m_objects_per_update;
 
+private:
+    xr_vector<CSE_ALifeSchedulable*> m_batch;
+    xr_vector<ALife::_OBJECT_ID> m_batch_ids;
+    xr_vector<CGraphEngine*> m_graph_engines; // free engines for prepare_update
+    Lock m_graph_engines_lock;
+
+    CGraphEngine* acquire_graph_engine();
+    void release_graph_engine(CGraphEngine* engine);
+    u32 update_parallel();
+
 public:
     IC CALifeScheduleRegistry();
     virtual ~CALifeScheduleRegistry();
     void add(CSE_ALifeDynamicObject* object);
     void remove(CSE_ALifeDynamicObject* object, bool no_assert = false);
-    IC void update();
+    IC u32 update(); // returns number of updated objects
     IC CSE_ALifeSchedulable* object(const ALife::_OBJECT_ID& id, bool no_assert = false) const;
     IC const u32& objects_per_update() const;
     IC void objects_per_update(const u32& objects_per_update);
@@ -15,16 +15,19 @@ IC void CALifeScheduleRegistry::objects_per_update(const u32& objects_per_update
     m_objects_per_update = objects_per_update;
 }
 
-IC void CALifeScheduleRegistry::update()
+IC u32 CALifeScheduleRegistry::update()
 {
-    //	u32							count =
-    objects().empty() ? 0 : inherited::update(CUpdatePredicate(m_objects_per_update), false);
+    if (!objects().empty() && g_mt_config.test(mtALifeParallel))
+        return update_parallel();
+
+    const u32 count = objects().empty() ? 0 : inherited::update(CUpdatePredicate(m_objects_per_update), false);
 #ifdef DEBUG
     if (psAI_Flags.test(aiALife))
     {
         //		Msg						("[LSS][SU][%d : %d]",count, objects().size());
     }
 #endif
+    return count;
 }
 
 IC CSE_ALifeSchedulable* CALifeScheduleRegistry::object(const ALife::_OBJECT_ID& id, bool no_assert) const
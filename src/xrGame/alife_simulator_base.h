@@ -109,7 +109,7 @@ protected:
 
 public:
     void register_object(CSE_ALifeDynamicObject* object, bool add_object = false);
-    void unregister_object(CSE_ALifeDynamicObject* object, bool alife_query = true);
+    virtual void unregister_object(CSE_ALifeDynamicObject* object, bool alife_query = true);
     void release(CSE_Abstract* object, bool alife_query = true);
     void create(
         CSE_ALifeDynamicObject*& object, CSE_ALifeDynamicObject* spawn_object, const ALife::_SPAWN_ID& spawn_id);
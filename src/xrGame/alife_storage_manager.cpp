@@ -21,13 +21,41 @@
 #include "saved_game_wrapper.h"
 #include "xrEngine/IGame_Persistent.h"
 #include "autosave_manager.h"
+#include "mt_config.h"
+
+#include "xrCore/Threading/ParallelFor.hpp"
+
 XRCORE_API string_path g_bug_report_file;
 
 using namespace ALife;
 
 extern string_path g_last_saved_game;
 
-CALifeStorageManager::~CALifeStorageManager() { *g_last_saved_game = 0; }
+namespace
+{
+// Replaces destination with source, destination is never left missing or half-written
+bool replace_file(pcstr source, pcstr destination)
+{
+#if defined(XR_PLATFORM_WINDOWS)
+    return !!MoveFileEx(source, destination, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    string_path src, dest;
+    xr_strcpy(src, source);
+    xr_strcpy(dest, destination);
+    convert_path_separators(src);
+    convert_path_separators(dest);
+    return 0 == rename(src, dest);
+#endif
+}
+} // namespace
+
+CALifeStorageManager::~CALifeStorageManager()
+{
+    // Level may be already destroyed, so nobody is notified
+    wait_for_save(false);
+    *g_last_saved_game = 0;
+}
+
 void CALifeStorageManager::save(LPCSTR save_name_no_check, bool update_name)
 {
     pcstr gameSaveExtension = SAVE_EXTENSION;
@@ -57,43 +85,202 @@ void CALifeStorageManager::save(LPCSTR save_name_no_check, bool update_name)
         }
     }
 
-    u32 source_count;
-    u32 dest_count;
-    void* dest_data;
-    {
-        CMemoryWriter stream;
-        header().save(stream);
-        time_manager().save(stream);
-        spawns().save(stream);
-        objects().save(stream);
-        registry().save(stream);
-
-        source_count = stream.tell();
-        void* source_data = stream.pointer();
-        dest_count = rtc_csize(source_count);
-        dest_data = xr_malloc(dest_count);
-        dest_count = rtc_compress(dest_data, dest_count, source_data, source_count);
+    // The previous snapshot should be written before it's replaced
+    wait_for_save();
+
+    FS.update_path(m_save_file_name, "$game_saves$", m_save_name);
+    xr_fs_strlwr(m_save_file_name);
+    m_save_delta = can_save_delta(m_save_file_name);
+
+    m_save_stream.clear();
+    header().save(m_save_stream);
+    time_manager().save(m_save_stream);
+    spawns().save(m_save_stream);
+    if (m_save_delta)
+        objects().save_delta(m_save_stream);
+    else
+        objects().save(m_save_stream);
+    registry().save(m_save_stream);
+
+    if (m_save_delta)
+    {
+        // Delta is appended in place, incomplete one is ignored on load
+        m_save_writer = FS.w_open_append(m_save_file_name);
+        xr_strcpy(m_save_temp_name, "");
+    }
+    else
+    {
+        string_path temp;
+        strconcat(sizeof(temp), temp, m_save_file_name, ".tmp");
+        m_save_writer = FS.w_open(temp);
+        xr_strcpy(m_save_temp_name, m_save_writer->fName.c_str());
     }
 
-    string_path temp;
-    FS.update_path(temp, "$game_saves$", m_save_name);
-    IWriter* writer = FS.w_open(temp);
-    writer->w_u32(u32(-1));
-    writer->w_u32(ALIFE_VERSION);
+    m_save_done = false;
+    m_save_in_progress = true;
+    CALifeStorageManager* self = this;
+    TaskScheduler->AddTask("CALifeStorageManager::save", [](Task&, void* data)
+    {
+        (*static_cast<CALifeStorageManager**>(data))->write_saved_game();
+    }, sizeof(self), &self);
+
+    if (g_mt_config.test(mtSaveGame))
+        Device.seqFrame.Add(this, REG_PRIORITY_LOW);
+    else
+        wait_for_save();
+
+    if (!update_name)
+        xr_strcpy(m_save_name, saveBackup);
+}
+
+bool CALifeStorageManager::can_save_delta(pcstr file_name) const
+{
+    if (xr_strcmp(m_delta_file_name, file_name))
+        return false;
+
+    // Compact the saved game
+    if (m_delta_count >= CSavedGameWrapper::MAX_DELTA_COUNT)
+        return false;
+    if (m_delta_file_size - m_delta_base_size > m_delta_base_size / 2)
+        return false;
+
+    // The saved game may be deleted or replaced by a file with the same name
+    return FS.file_length(file_name) == int(m_delta_file_size);
+}
+
+void CALifeStorageManager::write_saved_game()
+{
+    // Chunks are compressed independently, so they can be compressed and decompressed in parallel
+    constexpr u32 chunk_size = CSavedGameWrapper::CHUNK_SIZE;
+    const u32 source_count = u32(m_save_stream.size());
+    const u8* source_data = m_save_stream.pointer();
+    const u32 chunk_count = (source_count + chunk_size - 1) / chunk_size;
+
+    m_save_chunks.resize(chunk_count);
+    xr_parallel_for(TaskRange<u32>(0, chunk_count, 1), [&](const TaskRange<u32>& range)
+    {
+        for (u32 i = range.begin(); i != range.end(); ++i)
+        {
+            const u32 offset = i * chunk_size;
+            const u32 size = std::min(chunk_size, source_count - offset);
+            xr_vector<u8>& chunk = m_save_chunks[i];
+            chunk.resize(rtc_csize(size));
+            chunk.resize(rtc_compress(chunk.data(), chunk.size(), source_data + offset, size));
+        }
+    });
+
+    CMemoryWriter record_header;
+    record_header.w_u32(source_count);
+    record_header.w_u32(chunk_size);
+    record_header.w_u32(chunk_count);
+    for (const xr_vector<u8>& chunk : m_save_chunks)
+        record_header.w_u32(u32(chunk.size()));
+
+    u32 record_size = u32(record_header.size());
+    for (const xr_vector<u8>& chunk : m_save_chunks)
+        record_size += u32(chunk.size());
+
+    IWriter* writer = m_save_writer;
+    if (m_save_delta)
+    {
+        u32 crc = crc32(record_header.pointer(), u32(record_header.size()));
+        for (const xr_vector<u8>& chunk : m_save_chunks)
+            crc = crc32(chunk.data(), u32(chunk.size()), crc);
+
+        writer->w_u32(CSavedGameWrapper::DELTA_SIGNATURE);
+        writer->w_u32(record_size);
+        writer->w_u32(crc);
+    }
+    else
+    {
+        writer->w_u32(CSavedGameWrapper::SIGNATURE_CHUNKED);
+        writer->w_u32(ALIFE_VERSION);
+    }
+    writer->w(record_header.pointer(), record_header.size());
+    for (const xr_vector<u8>& chunk : m_save_chunks)
+        writer->w(chunk.data(), chunk.size());
+
+    m_save_size = record_size + 2 * sizeof(u32) + (m_save_delta ? sizeof(u32) : 0);
+    m_save_succeeded = writer->valid();
+    xr_delete(m_save_writer); // closes the file, it's registered in FS when the save is finished
+
+    m_save_done.store(true, std::memory_order_release);
+}
+
+void CALifeStorageManager::finish_save(bool notify)
+{
+    VERIFY(m_save_in_progress && m_save_done);
+    m_save_in_progress = false;
+    Device.seqFrame.Remove(this);
 
-    writer->w_u32(source_count);
-    writer->w(dest_data, dest_count);
-    xr_free(dest_data);
-    FS.w_close(writer);
 #ifdef DEBUG
-    Msg("* Game %s is successfully saved to file '%s' (%d bytes compressed to %d)", m_save_name, temp, source_count,
-        dest_count + 4);
+    u32 dest_count = 0;
+    for (const xr_vector<u8>& chunk : m_save_chunks)
+        dest_count += u32(chunk.size());
+    const u32 source_count = u32(m_save_stream.size());
+#endif // DEBUG
+    m_save_chunks.clear();
+    m_save_stream.free();
+
+    if (!m_save_delta)
+    {
+        if (m_save_succeeded)
+            m_save_succeeded = replace_file(m_save_temp_name, m_save_file_name);
+        if (!m_save_succeeded)
+            xr_unlink(m_save_temp_name);
+    }
+
+    if (!m_save_succeeded)
+        xr_strcpy(m_delta_file_name, "");
+    else if (m_save_delta)
+    {
+        ++m_delta_count;
+        m_delta_file_size += m_save_size;
+    }
+    else
+    {
+        xr_strcpy(m_delta_file_name, m_save_file_name);
+        m_delta_file_size = m_save_size;
+        m_delta_base_size = m_save_size;
+        m_delta_count = 0;
+    }
+
+    // Update sizes of the replaced files
+    const FS_Path* saves_path = FS.get_path("$game_saves$");
+    FS.rescan_path(saves_path->m_Path, saves_path->m_Flags.is(FS_Path::flRecurse));
+
+    if (m_save_succeeded)
+    {
+#ifdef DEBUG
+        Msg("* Game is successfully saved to file '%s'%s (%d bytes compressed to %d)", m_save_file_name,
+            m_save_delta ? " as delta" : "", source_count, dest_count);
 #else // DEBUG
-    Msg("* Game %s is successfully saved to file '%s'", m_save_name, temp);
+        Msg("* Game is successfully saved to file '%s'%s", m_save_file_name, m_save_delta ? " as delta" : "");
 #endif // DEBUG
+    }
+    else
+        Msg("! Cannot save game to file '%s'", m_save_file_name);
 
-    if (!update_name)
-        xr_strcpy(m_save_name, saveBackup);
+    if (!notify || !g_pGameLevel)
+        return;
+
+    Level().autosave_manager().on_game_saved(m_save_file_name, m_save_succeeded);
+}
+
+void CALifeStorageManager::wait_for_save(bool notify)
+{
+    if (!m_save_in_progress)
+        return;
+
+    while (!m_save_done.load(std::memory_order_acquire))
+        TaskScheduler->ExecuteOneTask();
+    finish_save(notify);
+}
+
+void CALifeStorageManager::OnFrame()
+{
+    if (m_save_done.load(std::memory_order_acquire))
+        finish_save(true);
 }
 
 void CALifeStorageManager::load(void* buffer, const u32& buffer_size, LPCSTR file_name)
@@ -161,6 +348,12 @@ bool CALifeStorageManager::load(LPCSTR save_name_no_check)
     string_path file_name;
     FS.update_path(file_name, "$game_saves$", m_save_name);
 
+    // The file may be still being written
+    wait_for_save();
+
+    // Objects of the loaded game are unknown to the registry, the next save writes the full snapshot
+    xr_strcpy(m_delta_file_name, "");
+
     xr_strcpy(g_last_saved_game, save_name);
     xrDebug::SetBugReportFile(file_name);
 
@@ -194,9 +387,8 @@ bool CALifeStorageManager::load(LPCSTR save_name_no_check)
     unload();
     reload(m_section);
 
-    const u32 source_count = stream->r_u32();
-    void* source_data = xr_malloc(source_count);
-    rtc_decompress(source_data, source_count, stream->pointer(), stream->length() - 3 * sizeof(u32));
+    u32 source_count;
+    void* source_data = CSavedGameWrapper::decompress(*stream, source_count);
     FS.r_close(stream);
     load(source_data, source_count, file_name);
     xr_free(source_data);
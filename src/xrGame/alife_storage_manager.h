@@ -9,10 +9,13 @@
 #pragma once
 
 #include "alife_simulator_base.h"
+#include "xrEngine/pure.h"
+
+#include <atomic>
 
 class NET_Packet;
 
-class CALifeStorageManager : public virtual CALifeSimulatorBase
+class CALifeStorageManager : public virtual CALifeSimulatorBase, public pureFrame
 {
     friend class CALifeUpdatePredicate;
 
@@ -23,9 +26,34 @@ protected:
     string_path m_save_name;
     LPCSTR m_section;
 
+private:
+    // Background save: the snapshot is serialized on the main thread,
+    // then it is compressed and written to a temporary file on the task scheduler.
+    // The temporary file replaces the saved game on the main thread, when the task is done.
+    CMemoryWriter m_save_stream;
+    xr_vector<xr_vector<u8>> m_save_chunks;
+    IWriter* m_save_writer;
+    string_path m_save_file_name;
+    string_path m_save_temp_name;
+    std::atomic_bool m_save_done;
+    bool m_save_in_progress;
+    bool m_save_succeeded;
+    bool m_save_delta;
+    u32 m_save_size;
+
+    // Saved game written last. Saving to it again appends the objects changed since then,
+    // until there are too many deltas and the whole snapshot is rewritten.
+    string_path m_delta_file_name;
+    u32 m_delta_file_size;
+    u32 m_delta_base_size;
+    u32 m_delta_count;
+
 private:
     void prepare_objects_for_save();
     void load(void* buffer, const u32& buffer_size, LPCSTR file_name);
+    bool can_save_delta(pcstr file_name) const;
+    void write_saved_game();
+    void finish_save(bool notify);
 
 public:
     IC CALifeStorageManager(IPureServer* server, LPCSTR section);
@@ -33,6 +61,9 @@ public:
     bool load(LPCSTR save_name = 0);
     void save(LPCSTR save_name = 0, bool update_name = true);
     void save(NET_Packet& net_packet);
+    IC bool save_in_progress() const;
+    void wait_for_save(bool notify = true);
+    virtual void OnFrame();
 };
 
 #include "alife_storage_manager_inline.h"
@@ -12,4 +12,16 @@ IC CALifeStorageManager::CALifeStorageManager(IPureServer* server, LPCSTR sectio
 {
     m_section = section;
     xr_strcpy(m_save_name, "");
+    m_save_writer = nullptr;
+    m_save_done = true;
+    m_save_in_progress = false;
+    m_save_succeeded = false;
+    m_save_delta = false;
+    m_save_size = 0;
+    xr_strcpy(m_delta_file_name, "");
+    m_delta_file_size = 0;
+    m_delta_base_size = 0;
+    m_delta_count = 0;
 }
+
+IC bool CALifeStorageManager::save_in_progress() const { return m_save_in_progress; }
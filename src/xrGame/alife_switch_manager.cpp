@@ -9,6 +9,7 @@
 #include "StdAfx.h"
 #include "alife_switch_manager.h"
 #include "xrServer_Objects_ALife.h"
+#include "xrServer_Objects_ALife_Monsters.h"
 #include "alife_graph_registry.h"
 #include "alife_object_registry.h"
 #include "alife_schedule_registry.h"
@@ -111,6 +112,8 @@ void CALifeSwitchManager::switch_online(CSE_ALifeDynamicObject* object)
         Device.dwTimeGlobal, object->name_replace(), object->ID, VPUSH(graph().actor()->o_Position),
         VPUSH(object->o_Position), "*SERVER*");
 #endif
+    m_prefetch.on_switch_online(object->ID);
+    ++m_online_switches;
     object->switch_online();
     STOP_PROFILE
 }
@@ -124,6 +127,7 @@ void CALifeSwitchManager::switch_offline(CSE_ALifeDynamicObject* object)
         Device.dwTimeGlobal, object->name_replace(), object->ID, VPUSH(graph().actor()->o_Position),
         VPUSH(object->o_Position), "*SERVER*");
 #endif
+    ++m_offline_switches;
     object->switch_offline();
     STOP_PROFILE
 }
@@ -235,6 +239,64 @@ void CALifeSwitchManager::try_switch_offline(CSE_ALifeDynamicObject* I)
     STOP_PROFILE
 }
 
+void CALifeSwitchManager::update_prefetch(CSE_ALifeDynamicObject* I)
+{
+    START_PROFILE("ALife/switch/update_prefetch")
+    if (0xffff != I->ID_Parent || !graph().actor())
+        return;
+
+    // Squad members are out of the level graph registry, the squad switches them online
+    const Fvector& actor_position = graph().actor()->o_Position;
+    CSE_ALifeOnlineOfflineGroup* group = smart_cast<CSE_ALifeOnlineOfflineGroup*>(I);
+    float distance = actor_position.distance_to(I->o_Position);
+    if (group)
+    {
+        for (const auto& it : group->squad_members())
+            distance = _min(distance, actor_position.distance_to(it.second->o_Position));
+    }
+
+    if (distance > prefetch_distance())
+    {
+        m_prefetch.cancel(I->ID);
+        return;
+    }
+
+    // The entry stays until switch_online consumes it, objects inside of the online radius are too late to request
+    if (m_prefetch.touch(I->ID) || distance <= online_distance())
+        return;
+
+    xr_vector<shared_str> visuals;
+    const auto add_visual = [&visuals](CSE_Abstract* object)
+    {
+        CSE_Visual* visual = object ? object->visual() : nullptr;
+        if (visual && visual->get_visual() && visual->get_visual()[0])
+            visuals.emplace_back(visual->get_visual());
+    };
+    const auto add_object = [&](CSE_ALifeDynamicObject* object)
+    {
+        add_visual(object);
+        for (const ALife::_OBJECT_ID& id : object->children)
+            add_visual(objects().object(id, true));
+    };
+
+    if (group)
+    {
+        for (const auto& it : group->squad_members())
+            add_object(it.second);
+    }
+    else
+        add_object(I);
+
+    m_prefetch.request(I->ID, std::move(visuals));
+    STOP_PROFILE
+}
+
+void CALifeSwitchManager::unregister_object(CSE_ALifeDynamicObject* object, bool alife_query)
+{
+    m_prefetch.cancel(object->ID);
+    inherited::unregister_object(object, alife_query);
+}
+
 void CALifeSwitchManager::switch_object(CSE_ALifeDynamicObject* I)
 {
     if (I->redundant())
@@ -249,7 +311,10 @@ void CALifeSwitchManager::switch_object(CSE_ALifeDynamicObject* I)
     if (I->m_bOnline)
         try_switch_offline(I);
     else
+    {
+        update_prefetch(I);
         try_switch_online(I);
+    }
 
     if (I->redundant())
         release(I);
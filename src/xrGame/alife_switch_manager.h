@@ -8,6 +8,7 @@
 
 #pragma once
 #include "alife_simulator_base.h"
+#include "alife_prefetch_manager.h"
 
 // XXX: WTF is this? CALifeSwitchManager IS-A CRandom??? I think NOT! CRandom should be aggregated, NOT inherited from!
 class CALifeSwitchManager : public virtual CALifeSimulatorBase, CRandom
@@ -21,12 +22,18 @@ protected:
     float m_switch_factor;
     float m_online_distance;
     float m_offline_distance;
+    float m_prefetch_factor;
+    float m_prefetch_distance;
 
 private:
     OBJECT_VECTOR m_saved_chidren;
+    CALifePrefetchManager m_prefetch;
+    u32 m_online_switches;
+    u32 m_offline_switches;
 
 protected:
     bool synchronize_location(CSE_ALifeDynamicObject* object);
+    void update_prefetch(CSE_ALifeDynamicObject* object);
 
 public:
     void try_switch_online(CSE_ALifeDynamicObject* object);
@@ -39,12 +46,18 @@ public:
 public:
     IC CALifeSwitchManager(IPureServer* server, LPCSTR section);
     virtual ~CALifeSwitchManager();
+    virtual void unregister_object(CSE_ALifeDynamicObject* object, bool alife_query = true);
     void switch_object(CSE_ALifeDynamicObject* object);
     IC float online_distance() const noexcept;
     IC float offline_distance() const noexcept;
     IC float switch_distance() const noexcept;
+    IC float prefetch_distance() const noexcept;
     IC void set_switch_distance(float switch_distance) noexcept;
     IC void set_switch_factor(float switch_factor) noexcept;
+    IC u32 online_switches() const noexcept;
+    IC u32 offline_switches() const noexcept;
+    IC CALifePrefetchManager& prefetch() noexcept;
+    IC const CALifePrefetchManager& prefetch() const noexcept;
 };
 
 #include "alife_switch_manager_inline.h"
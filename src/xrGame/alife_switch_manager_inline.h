@@ -12,6 +12,9 @@ IC CALifeSwitchManager::CALifeSwitchManager(IPureServer* server, LPCSTR section)
 {
     m_switch_distance = pSettings->r_float(section, "switch_distance");
     m_switch_factor = pSettings->r_float(section, "switch_factor");
+    m_prefetch_factor = READ_IF_EXISTS(pSettings, r_float, section, "prefetch_factor", 1.25f);
+    m_online_switches = 0;
+    m_offline_switches = 0;
     set_switch_distance(m_switch_distance);
     seed(u32(CPU::QPC() & 0xffffffff));
 }
@@ -19,11 +22,13 @@ IC CALifeSwitchManager::CALifeSwitchManager(IPureServer* server, LPCSTR section)
 IC float CALifeSwitchManager::online_distance() const noexcept { return (m_online_distance); }
 IC float CALifeSwitchManager::offline_distance() const noexcept { return (m_offline_distance); }
 IC float CALifeSwitchManager::switch_distance() const noexcept { return (m_switch_distance); }
+IC float CALifeSwitchManager::prefetch_distance() const noexcept { return (m_prefetch_distance); }
 IC void CALifeSwitchManager::set_switch_distance(float switch_distance) noexcept
 {
     m_switch_distance = switch_distance;
     m_online_distance = m_switch_distance * (1.f - m_switch_factor);
     m_offline_distance = m_switch_distance * (1.f + m_switch_factor);
+    m_prefetch_distance = m_online_distance * m_prefetch_factor;
 }
 
 IC void CALifeSwitchManager::set_switch_factor(float switch_factor) noexcept
@@ -31,3 +36,8 @@ IC void CALifeSwitchManager::set_switch_factor(float switch_factor) noexcept
     m_switch_factor = switch_factor;
     set_switch_distance(switch_distance());
 }
+
+IC u32 CALifeSwitchManager::online_switches() const noexcept { return (m_online_switches); }
+IC u32 CALifeSwitchManager::offline_switches() const noexcept { return (m_offline_switches); }
+IC CALifePrefetchManager& CALifeSwitchManager::prefetch() noexcept { return (m_prefetch); }
+IC const CALifePrefetchManager& CALifeSwitchManager::prefetch() const noexcept { return (m_prefetch); }
@@ -24,3 +24,8 @@ IC ALife::_TIME_ID CALifeTimeManager::game_time() const
 IC float CALifeTimeManager::time_factor() const { return (m_time_factor); }
 IC float CALifeTimeManager::normal_time_factor() const { return (m_normal_time_factor); }
 IC void CALifeTimeManager::change_game_time(u32 value) { m_game_time += value; }
+IC void CALifeTimeManager::set_game_time(ALife::_TIME_ID game_time)
+{
+    m_game_time = game_time;
+    m_start_time = Device.dwTimeGlobal;
+}
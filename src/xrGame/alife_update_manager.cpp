@@ -21,6 +21,7 @@
 #include "xrEngine/x_ray.h"
 #include "restriction_space.h"
 #include "xrEngine/profiler.h"
+#include "xrEngine/XR_IOConsole.h"
 #include "mt_config.h"
 #include "xrNetServer/NET_Messages.h"
 
@@ -97,6 +98,7 @@ void CALifeUpdateManager::update_scheduled(bool init_ef)
 
 void CALifeUpdateManager::update()
 {
+    MemoryTagScope scope(MemoryTag::ALife);
     update_switch();
     update_scheduled(false);
 }
@@ -114,11 +116,61 @@ void CALifeUpdateManager::shedule_Update(u32 dt)
         return;
     }
 
+    const bool first_time = m_first_time;
     m_first_time = false;
 
     START_PROFILE("ALife/update")
     update();
     STOP_PROFILE
+
+    // Run from the command line: -alife_benchmark <game hours> -load <save> or -start server(...) client(...)
+    pcstr benchmark_param = first_time ? strstr(Core.Params, "-alife_benchmark ") : nullptr;
+    if (benchmark_param)
+    {
+        float hours = 24.f;
+        sscanf(benchmark_param + xr_strlen("-alife_benchmark "), "%f", &hours);
+        benchmark(hours);
+        Console->Execute("quit");
+    }
+}
+
+void CALifeUpdateManager::benchmark(float hours)
+{
+    // Game time of one frame at 30 fps and normal speed of the game
+    const u32 frame_time = iFloor(time_manager().normal_time_factor() * 1000.f / 30.f);
+    const ALife::_TIME_ID duration = ALife::_TIME_ID(hours * 60.f * 60.f * 1000.f);
+    const u32 online_switches_start = online_switches();
+    const u32 offline_switches_start = offline_switches();
+    const size_t memory_start = Memory.mem_usage();
+    const ALife::_TIME_ID game_time_start = time_manager().game_time();
+
+    Msg("* ALife benchmark: %.1f game hours, %d objects, %d scheduled, %d on the level", hours,
+        u32(objects().objects().size()), u32(scheduled().objects().size()), u32(graph().level().objects().size()));
+
+    init_ef_storage();
+
+    u32 updated = 0;
+    u32 frames = 0;
+    CTimer timer;
+    timer.Start();
+    for (ALife::_TIME_ID time = 0; time < duration; time += frame_time, ++frames)
+    {
+        time_manager().change_game_time(frame_time);
+        graph().level().update(CSwitchPredicate(this), false);
+        updated += scheduled().update();
+    }
+    const float seconds = std::max(timer.GetElapsed_sec(), EPS_S);
+
+    // Simulated hours must not be left in the game, objects are kept where the run has moved them
+    time_manager().set_game_time(game_time_start);
+
+    Msg("* ALife benchmark: %d frames in %.3fs, %.1f game hours/s", frames, seconds, hours / seconds);
+    Msg("* - updates:  %u, %.0f objects/s, %.3fms per frame", updated, float(updated) / seconds,
+        seconds * 1000.f / float(std::max(frames, 1u)));
+    Msg("* - switches: %d online, %d offline", online_switches() - online_switches_start,
+        offline_switches() - offline_switches_start);
+    Msg("* - memory:   %.3fMb, %+.3fMb during the run", float(Memory.mem_usage()) / 1048576.f,
+        (float(Memory.mem_usage()) - float(memory_start)) / 1048576.f);
 }
 
 void CALifeUpdateManager::set_process_time(int microseconds)
@@ -49,6 +49,8 @@ public:
     virtual bool shedule_Needed() { return true; };
     void update_switch();
     void update_scheduled(bool init_ef = true);
+    // Advances game time at maximum speed and reports the simulation throughput
+    void benchmark(float hours);
     void load(LPCSTR game_name = 0, bool no_assert = false, bool new_only = false);
     bool load_game(LPCSTR game_name, bool no_assert = false);
     float update_monster_factor() const { return m_update_monster_factor; }
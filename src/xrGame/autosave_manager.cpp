@@ -16,6 +16,7 @@
 #include "Actor.h"
 #include "MainMenu.h"
 #include "xrNetServer/NET_Messages.h"
+#include "alife_simulator.h"
 
 extern LPCSTR alife_section;
 
@@ -52,7 +53,8 @@ void CAutosaveManager::shedule_Update(u32 dt)
     if (last_autosave_time() + autosave_interval() >= Device.dwTimeGlobal)
         return;
 
-    if (Device.dwPrecacheFrame || !g_actor || !ready_for_autosave() || !Actor()->g_Alive())
+    if (Device.dwPrecacheFrame || !g_actor || !ready_for_autosave() || !Actor()->g_Alive() ||
+        ai().alife().save_in_progress())
     {
         delay_autosave();
         return;
@@ -81,3 +83,14 @@ void CAutosaveManager::shedule_Update(u32 dt)
 }
 
 void CAutosaveManager::on_game_loaded() { m_last_autosave_time = Device.dwTimeGlobal; }
+// Saves are written in background, this is called when the file is in place
+void CAutosaveManager::on_game_saved(pcstr file_name, bool succeeded)
+{
+    if (succeeded)
+        return;
+
+    // retry after the usual delay instead of the whole interval
+    Msg("! Autosave manager: game wasn't saved to '%s'", file_name);
+    m_last_autosave_time = Device.dwTimeGlobal - autosave_interval();
+    delay_autosave();
+}
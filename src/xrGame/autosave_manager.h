@@ -28,6 +28,7 @@ public:
     virtual float shedule_Scale();
     virtual bool shedule_Needed() { return true; }
     void on_game_loaded();
+    void on_game_saved(pcstr file_name, bool succeeded);
 
 public:
     IC u32 autosave_interval() const;
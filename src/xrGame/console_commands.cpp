@@ -4,6 +4,7 @@
 #include "xrEngine/CustomHUD.h"
 #include "xrEngine/FDemoRecord.h"
 #include "xrEngine/FDemoPlay.h"
+#include "xrEngine/Feel_Vision.h"
 #include "xrMessages.h"
 #include "xrServer.h"
 #include "Level.h"
@@ -119,7 +120,7 @@ void register_mp_console_commands();
 BOOL g_bCheckTime = FALSE;
 int net_cl_inputupdaterate = 50;
 Flags32 g_mt_config = {mtLevelPath | mtDetailPath | mtObjectHandler | mtSoundPlayer | mtAiVision | mtBullets |
-    mtLUA_GC | mtLevelSounds | mtALife | mtMap};
+    mtLUA_GC | mtLevelSounds | mtALife | mtMap | mtSaveGame | mtALifeParallel};
 #ifdef DEBUG
 Flags32 dbg_net_Draw_Flags = {0};
 #endif
@@ -163,6 +164,7 @@ static void full_memory_stats()
     Msg("* [ Render ]: textures[%d K]", (m_base + m_lmaps) / 1024);
     Msg("* [ x-ray  ]: process heap[%u K]", _process_heap / 1024);
     Msg("* [ x-ray  ]: economy: strings[%d K], smem[%d K]", _eco_strings / 1024, _eco_smem);
+    Memory.tag_dump();
 #ifdef FS_DEBUG
     Msg("* [ x-ray  ]: file mapping: memory[%d K], count[%d]", g_file_mapped_memory / 1024, g_file_mapped_count);
     dump_file_mappings();
@@ -398,6 +400,28 @@ public:
     }
 };
 
+class CCC_ALifeBenchmark : public IConsole_Command
+{
+public:
+    CCC_ALifeBenchmark(LPCSTR N) : IConsole_Command(N){};
+    virtual void Execute(LPCSTR args)
+    {
+        if ((GameID() == eGameIDSingle) && ai().get_alife())
+        {
+            game_sv_Single* tpGame = smart_cast<game_sv_Single*>(Level().Server->GetGameState());
+            VERIFY(tpGame);
+            float id1 = 0.0f;
+            sscanf(args, "%f", &id1);
+            if (id1 < EPS_L)
+                Msg("Invalid benchmark duration! (%.4f)", id1);
+            else
+                tpGame->alife().benchmark(id1);
+        }
+        else
+            Log("!Not a single player game!");
+    }
+};
+
 class CCC_ALifeSwitchFactor : public IConsole_Command
 {
 public:
@@ -1160,6 +1184,27 @@ public:
     }
 };
 
+#ifndef MASTER_GOLD
+class CCC_PHBenchmark : public IConsole_Command
+{
+public:
+    CCC_PHBenchmark(LPCSTR N) : IConsole_Command(N) { bEmptyArgsHandled = true; };
+    virtual void Execute(LPCSTR args)
+    {
+        if (!physics_world())
+        {
+            Msg("! Physics world is not created");
+            return;
+        }
+        int steps_count = 0;
+        if (!xr_strlen(args) || 1 != sscanf(args, "%d", &steps_count) || steps_count <= 0)
+            steps_count = 1000;
+        physics_world()->Benchmark(u32(steps_count));
+    }
+    virtual void Info(TInfo& I) { xr_strcpy(I, "replay current physics scene in single thread and parallel modes, [steps count]"); }
+};
+#endif // MASTER_GOLD
+
 #ifdef DEBUG
 class CCC_PHGravity : public IConsole_Command
 {
@@ -1932,6 +1977,7 @@ void CCC_RegisterCommands()
     CMD1(CCC_ALifeProcessTime, "al_process_time"); // set process time
     CMD1(CCC_ALifeObjectsPerUpdate, "al_objects_per_update"); // set process time
     CMD1(CCC_ALifeSwitchFactor, "al_switch_factor"); // set switch factor
+    CMD1(CCC_ALifeBenchmark, "al_benchmark"); // simulate game hours at maximum speed
 #endif // #ifndef MASTER_GOLD
 
     CMD3(CCC_Mask, "hud_weapon", &psHUD_Flags, HUD_WEAPON);
@@ -1959,6 +2005,7 @@ void CCC_RegisterCommands()
 #ifndef MASTER_GOLD
     // ai
     CMD3(CCC_Mask, "mt_ai_vision", &g_mt_config, mtAiVision);
+    CMD4(CCC_Integer, "ai_vision_rays_per_frame", &Feel::g_vision_service.max_rays_per_frame, 16, 8192);
     CMD3(CCC_Mask, "mt_level_path", &g_mt_config, mtLevelPath);
     CMD3(CCC_Mask, "mt_detail_path", &g_mt_config, mtDetailPath);
     CMD3(CCC_Mask, "mt_object_handler", &g_mt_config, mtObjectHandler);
@@ -1968,6 +2015,8 @@ void CCC_RegisterCommands()
     CMD3(CCC_Mask, "mt_level_sounds", &g_mt_config, mtLevelSounds);
     CMD3(CCC_Mask, "mt_alife", &g_mt_config, mtALife);
     CMD3(CCC_Mask, "mt_map", &g_mt_config, mtMap);
+    CMD3(CCC_Mask, "mt_save_game", &g_mt_config, mtSaveGame);
+    CMD3(CCC_Mask, "mt_alife_parallel", &g_mt_config, mtALifeParallel);
 #endif // MASTER_GOLD
 
 #ifndef MASTER_GOLD
@@ -2065,6 +2114,11 @@ void CCC_RegisterCommands()
     // Physics
     CMD1(CCC_PHFps, "ph_frequency");
     CMD1(CCC_PHIterations, "ph_iterations");
+    CMD4(CCC_Integer, "ph_mt_islands", &ph_console::ph_mt_islands, 0, 1);
+    CMD4(CCC_Integer, "ph_mt_islands_min", &ph_console::ph_mt_islands_min, 2, 1024);
+#ifndef MASTER_GOLD
+    CMD1(CCC_PHBenchmark, "ph_benchmark");
+#endif // MASTER_GOLD
 
 #ifdef DEBUG
     CMD1(CCC_PHGravity, "ph_gravity");
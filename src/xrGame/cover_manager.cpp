@@ -9,6 +9,7 @@
 #include "StdAfx.h"
 
 #include "xrCore/Threading/ParallelFor.hpp"
+#include "xrEngine/IGame_Level.h"
 
 #include "xrAICore/Navigation/level_graph.h"
 #include "cover_manager.h"
@@ -25,6 +26,7 @@
 CCoverManager::CCoverManager()
 {
     m_covers = 0;
+    m_region = nullptr;
     m_smart_covers_storage = 0;
     m_smart_covers_actual = false;
 }
@@ -102,15 +104,22 @@ void CCoverManager::compute_static_cover()
         }
     });
 
+    // Static covers live until the level is unloaded, don't spread thousands of them over the heap
+    m_region = g_pGameLevel ? &g_pGameLevel->Region() : nullptr;
     for (u32 i = 0; i < levelVertexCount; ++i)
-        if (m_temp[i] && critical_cover(i))
-            m_covers->insert(xr_new<CCoverPoint>(ai().level_graph().vertex_position(ai().level_graph().vertex(i)), i));
+    {
+        if (!m_temp[i] || !critical_cover(i))
+            continue;
+
+        const Fvector& position = ai().level_graph().vertex_position(ai().level_graph().vertex(i));
+        m_covers->insert(m_region ? region_new<CCoverPoint>(*m_region, position, i) : xr_new<CCoverPoint>(position, i));
+    }
 
     VERIFY(!m_smart_covers_storage);
     m_smart_covers_storage = xr_new<smart_cover::storage>();
 }
 
-void CCoverManager::clear_covers(PointVector& covers)
+void CCoverManager::clear_covers(PointVector& covers) const
 {
     PointVector::iterator I = covers.begin();
     PointVector::iterator E = covers.end();
@@ -118,7 +127,10 @@ void CCoverManager::clear_covers(PointVector& covers)
     {
         if (!(*I)->m_is_smart_cover)
         {
-            xr_delete(*I);
+            if (m_region)
+                region_delete(*I);
+            else
+                xr_delete(*I);
             continue;
         }
 
@@ -134,11 +146,22 @@ void CCoverManager::clear()
     if (!get_covers())
         return;
 
-    covers().all(m_nearest);
-    clear_covers(m_nearest);
+    if (m_region)
+    {
+        // Static covers need no destruction, their memory goes away with the level region
+        static_assert(std::is_trivially_destructible_v<CCoverPoint>);
+        for (Cover* cover : m_smart_covers)
+            xr_delete(cover);
+    }
+    else
+    {
+        covers().all(m_nearest);
+        clear_covers(m_nearest);
+    }
     m_covers->clear();
     xr_delete(m_smart_covers_storage);
     m_smart_covers.clear();
+    m_region = nullptr;
 }
 
 namespace smart_cover
@@ -12,6 +12,7 @@
 #include "quadtree.h"
 
 class CCoverPoint;
+class xrMemoryRegion;
 
 namespace LevelGraph
 {
@@ -46,6 +47,7 @@ protected:
     CPointQuadTree* m_covers;
     xr_vector<bool> m_temp;
     mutable PointVector m_nearest;
+    xrMemoryRegion* m_region; // of the level, static covers are allocated there
 
 private:
     Storage* m_smart_covers_storage;
@@ -63,7 +65,7 @@ private:
     IC bool inertia(
         Fvector const& position, float radius, _evaluator_type& evaluator, const _restrictor_type& restrictor) const;
 
-    static void clear_covers(PointVector& covers);
+    void clear_covers(PointVector& covers) const;
     void remove_nearby_covers(smart_cover::cover const& cover, smart_cover::object const& object) const;
     void actualize_smart_covers() const;
 
@@ -184,6 +184,7 @@ public:
 
     virtual CVisualMemoryManager* visual_memory() const { return (0); }
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
 
     virtual Fvector predict_position(const float& time_to_check) const;
     virtual Fvector target_position() const;
@@ -21,7 +21,7 @@ void game_sv_Single::Create(shared_str& options)
 {
     inherited::Create(options);
     if (strstr(*options, "/alife"))
-        m_alife_simulator = xr_new<CALifeSimulator>(&server(), &options);
+        m_alife_simulator = xr_new_tagged<CALifeSimulator>(MemoryTag::ALife, &server(), &options);
     switch_Phase(GAME_PHASE_INPROGRESS);
 }
 
@@ -159,6 +159,8 @@ void game_sv_Single::OnDetach(u16 eid_who, u16 eid_what)
 void game_sv_Single::Update()
 {
     inherited::Update();
+    if (ai().get_alife())
+        alife().prefetch().process();
     /*	switch(phase) 	{
             case GAME_PHASE_PENDING : {
                 OnRoundStart();
@@ -332,7 +334,7 @@ void game_sv_Single::restart_simulator(LPCSTR saved_game_name)
     xr_strcpy(g_pGamePersistent->m_game_params.m_new_or_load, "load");
 
     pApp->LoadBegin();
-    m_alife_simulator = xr_new<CALifeSimulator>(&server(), &options);
+    m_alife_simulator = xr_new_tagged<CALifeSimulator>(MemoryTag::ALife, &server(), &options);
     g_pGamePersistent->SetLoadStageTitle("st_client_synchronising");
     g_pGamePersistent->LoadTitle();
     Device.PreCache(60, true, true);
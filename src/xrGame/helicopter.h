@@ -294,6 +294,7 @@ public:
     virtual void net_Export(NET_Packet& P){};
     virtual void net_Import(NET_Packet& P){};
     virtual void net_Relcase(IGameObject* O);
+    virtual bool net_NeedRelcase() const { return true; }
     virtual void save(NET_Packet& output_packet);
     virtual void load(IReader& input_packet);
 
@@ -17,6 +17,8 @@
 #include "alife_simulator.h"
 #include "alife_spawn_registry.h"
 
+#include "xrCore/Threading/ParallelFor.hpp"
+
 extern LPCSTR alife_section;
 
 pcstr CSavedGameWrapper::saved_game_full_name(pcstr saved_game_name, string_path& result, pcstr extension)
@@ -40,7 +42,8 @@ bool CSavedGameWrapper::valid_saved_game(IReader& stream)
     if (stream.length() < 8)
         return (false);
 
-    if (stream.r_u32() != u32(-1))
+    const u32 signature = stream.r_u32();
+    if (signature != SIGNATURE && signature != SIGNATURE_CHUNKED)
         return (false);
 
     if (stream.r_u32() < ALIFE_VERSION)
@@ -49,6 +52,120 @@ bool CSavedGameWrapper::valid_saved_game(IReader& stream)
     return (true);
 }
 
+u8* CSavedGameWrapper::decompress_chunks(IReader& stream, u32& source_count)
+{
+    source_count = stream.r_u32();
+    u8* source_data = static_cast<u8*>(xr_malloc(source_count));
+
+    const u32 chunk_size = stream.r_u32();
+    const u32 chunk_count = stream.r_u32();
+    xr_vector<u32> offsets(chunk_count + 1);
+    offsets[0] = 0;
+    for (u32 i = 0; i < chunk_count; ++i)
+        offsets[i + 1] = offsets[i] + stream.r_u32();
+    R_ASSERT2(offsets[chunk_count] <= u32(stream.elapsed()), "Saved game is corrupted");
+
+    // Chunks are independent, so they are decompressed in parallel
+    const u8* data = static_cast<const u8*>(stream.pointer());
+    xr_parallel_for(TaskRange<u32>(0, chunk_count, 1), [&](const TaskRange<u32>& range)
+    {
+        for (u32 i = range.begin(); i != range.end(); ++i)
+        {
+            const u32 offset = i * chunk_size;
+            rtc_decompress(source_data + offset, std::min(chunk_size, source_count - offset), data + offsets[i],
+                offsets[i + 1] - offsets[i]);
+        }
+    });
+    stream.advance(offsets[chunk_count]);
+    return source_data;
+}
+
+void* CSavedGameWrapper::apply_deltas(
+    u8* base_data, u32 base_count, const xr_vector<std::pair<u8*, u32>>& deltas, u32& source_count)
+{
+    IReader base(base_data, base_count);
+    xr_vector<IReader*> delta_streams;
+    delta_streams.reserve(deltas.size());
+    for (const auto& delta : deltas)
+        delta_streams.push_back(xr_new<IReader>(delta.first, delta.second));
+
+    // The last delta has everything but the objects, which are merged from the whole chain
+    CMemoryWriter result;
+    IReader& last = *delta_streams.back();
+    last.seek(0);
+    while (!last.eof())
+    {
+        const u32 chunk_id = last.r_u32();
+        const u32 chunk_size = last.r_u32();
+        const size_t next_chunk = last.tell() + chunk_size;
+        if (chunk_id == OBJECT_DELTA_CHUNK_DATA)
+            CALifeObjectRegistry::merge(base, delta_streams, result);
+        else
+        {
+            result.w_u32(chunk_id);
+            result.w_u32(chunk_size);
+            result.w(last.pointer(), chunk_size);
+        }
+        last.seek(next_chunk);
+    }
+
+    for (IReader*& delta : delta_streams)
+        xr_delete(delta);
+
+    source_count = u32(result.size());
+    void* source_data = xr_malloc(source_count);
+    CopyMemory(source_data, result.pointer(), source_count);
+    return source_data;
+}
+
+void* CSavedGameWrapper::decompress(IReader& stream, u32& source_count)
+{
+    stream.seek(0);
+    const u32 signature = stream.r_u32();
+    stream.r_u32(); // version
+
+    if (signature != SIGNATURE_CHUNKED)
+    {
+        source_count = stream.r_u32();
+        void* source_data = xr_malloc(source_count);
+        rtc_decompress(source_data, source_count, stream.pointer(), stream.elapsed());
+        return source_data;
+    }
+
+    u8* source_data = decompress_chunks(stream, source_count);
+
+    xr_vector<std::pair<u8*, u32>> deltas;
+    while (stream.elapsed() >= intptr_t(3 * sizeof(u32)))
+    {
+        if (stream.r_u32() != DELTA_SIGNATURE)
+            break;
+
+        const u32 size = stream.r_u32();
+        const u32 crc = stream.r_u32();
+        if (size > u32(stream.elapsed()) || crc != crc32(stream.pointer(), size))
+        {
+            Msg("! Incomplete delta of the saved game is ignored");
+            break;
+        }
+
+        IReader record(stream.pointer(), size);
+        u32 delta_count;
+        u8* delta_data = decompress_chunks(record, delta_count);
+        deltas.emplace_back(delta_data, delta_count);
+        stream.advance(size);
+    }
+
+    if (deltas.empty())
+        return source_data;
+
+    const u32 base_count = source_count;
+    void* result = apply_deltas(source_data, base_count, deltas, source_count);
+    xr_free(source_data);
+    for (auto& delta : deltas)
+        xr_free(delta.first);
+    return result;
+}
+
 bool CSavedGameWrapper::valid_saved_game(LPCSTR saved_game_name)
 {
     string_path file_name;
@@ -83,9 +200,8 @@ CSavedGameWrapper::CSavedGameWrapper(LPCSTR saved_game_name)
         return;
     }
 
-    u32 source_count = stream->r_u32();
-    void* source_data = xr_malloc(source_count);
-    rtc_decompress(source_data, source_count, stream->pointer(), stream->length() - 3 * sizeof(u32));
+    u32 source_count;
+    void* source_data = decompress(*stream, source_count);
     FS.r_close(stream);
 
     IReader reader(source_data, source_count);
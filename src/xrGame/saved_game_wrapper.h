@@ -17,6 +17,18 @@ public:
     typedef ALife::_TIME_ID _TIME_ID;
     typedef GameGraph::_LEVEL_ID _LEVEL_ID;
 
+    // Saved game starts with one of the signatures, ALIFE_VERSION and the uncompressed data size
+    static constexpr u32 SIGNATURE = u32(-1); // data is compressed as a single block
+    static constexpr u32 SIGNATURE_CHUNKED = u32(-2); // data is compressed in independent chunks
+    static constexpr u32 CHUNK_SIZE = 1024 * 1024;
+
+    // Chunked saved game may be followed by delta records with the objects changed since the previous save:
+    // DELTA_SIGNATURE, record size, record CRC and the record compressed in chunks as the saved game itself.
+    // Incomplete or corrupted record at the end of the file is ignored.
+    static constexpr u32 DELTA_SIGNATURE = u32(-3);
+    // Saved game is rewritten as a whole after this many deltas
+    static constexpr u32 MAX_DELTA_COUNT = 8;
+
 private:
     _TIME_ID m_game_time;
     _LEVEL_ID m_level_id;
@@ -29,6 +41,16 @@ public:
     static bool saved_game_exist(LPCSTR saved_game_name);
     static bool valid_saved_game(IReader& stream);
     static bool valid_saved_game(LPCSTR saved_game_name);
+    // Decompresses data of the stream checked by valid_saved_game and applies its deltas,
+    // result should be freed with xr_free
+    static void* decompress(IReader& stream, u32& source_count);
+
+private:
+    static u8* decompress_chunks(IReader& stream, u32& source_count);
+    static void* apply_deltas(u8* base_data, u32 base_count, const xr_vector<std::pair<u8*, u32>>& deltas,
+        u32& source_count);
+
+public:
     inline const _TIME_ID& game_time() const;
     inline const _LEVEL_ID& level_id() const;
     inline LPCSTR level_name() const;
@@ -141,6 +141,9 @@ void CScriptBinder::set_object(CScriptBinderObject* object)
         Msg("* Core object %s is binded with the script object", owner->cName());
 #endif // _DEBUG
         m_object = object;
+        // Objects registered later are subscribed by net_Register
+        if (g_pGameLevel)
+            g_pGameLevel->Objects.relcase_subscribe(owner);
     }
     else
     {
@@ -35,6 +35,7 @@ public:
     virtual void net_Relcase(IGameObject* object);
     void set_object(CScriptBinderObject* object);
     IC CScriptBinderObject* object();
+    IC const CScriptBinderObject* object() const;
 };
 
 #include "script_binder_inline.h"
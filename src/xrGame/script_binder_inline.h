@@ -9,3 +9,4 @@
 #pragma once
 
 IC CScriptBinderObject* CScriptBinder::object() { return (m_object); }
+IC const CScriptBinderObject* CScriptBinder::object() const { return (m_object); }
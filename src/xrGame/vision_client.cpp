@@ -10,6 +10,7 @@
 #include "vision_client.h"
 #include "Entity.h"
 #include "visual_memory_manager.h"
+#include "mt_config.h"
 
 IC const CEntity& vision_client::object() const
 {
@@ -62,7 +63,8 @@ void vision_client::eye_pp_s2()
     u32 dwTime = Device.dwTimeGlobal;
     u32 dwDT = dwTime - m_time_stamp;
     m_time_stamp = dwTime;
-    feel_vision_update(m_object, m_position, float(dwDT) / 1000.f, visual().transparency_threshold());
+    feel_vision_update(m_object, m_position, float(dwDT) / 1000.f, visual().transparency_threshold(),
+        !!g_mt_config.test(mtAiVision));
 
     Level().AIStats.VisRayTests.End();
 }
@@ -11,6 +11,7 @@
 #include "game_sv_mp.h"
 #include "game_cl_base_weapon_usage_statistic.h"
 #include "ai_space.h"
+#include "alife_simulator.h"
 #include "xrEngine/IGame_Persistent.h"
 #include "Common/object_broker.h"
 #include "xrEngine/Engine.h"
@@ -964,6 +965,8 @@ void xrServer::DumpStatistics(IGameFont& font, IPerformanceAlert* alert)
     font.OutNext("- compress:   %2.2fms", m_updator.CompressStats.result);
     m_updator.CompressStats.FrameStart();
     stats.FrameStart();
+    if (ai().get_alife())
+        ai().alife().prefetch().DumpStatistics(font);
 }
 
 shared_str xrServer::level_name(const shared_str& server_options) const { return (game->level_name(server_options)); }
@@ -31,6 +31,10 @@ class ParticleActions
     bool m_bLocked;
 
 public:
+    // Every list draws random numbers from its own generator, so effects
+    // emit the same particles whatever order or thread they are updated in
+    CRandom random;
+
     ParticleActions()
     {
         actions.reserve(4);
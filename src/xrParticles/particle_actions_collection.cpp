@@ -2,11 +2,14 @@
 
 #include "particle_actions_collection.h"
 #include "particle_effect.h"
+#include "particle_simd.h"
 
 #include "xrCore/Threading/ParallelFor.hpp"
 
 using namespace PAPI;
 
+bool PAPI::simd_actions = true;
+
 void PAPI::PAAvoid::Execute(ParticleEffect* effect, const float dt, float& tm_max)
 {
     float magdt = magnitude * dt;
@@ -708,7 +711,33 @@ void PADamping::Execute(ParticleEffect* effect, const float dt, float& tm_max)
     pVector one(1, 1, 1);
     pVector scale(one - (one - damping) * dt);
 
-    for (u32 i = 0; i < effect->p_count; i++)
+    u32 i = 0;
+    if (simd_actions)
+    {
+        const __m128 _scale_x = _mm_set1_ps(scale.x);
+        const __m128 _scale_y = _mm_set1_ps(scale.y);
+        const __m128 _scale_z = _mm_set1_ps(scale.z);
+        const __m128 _vlowSqr = _mm_set1_ps(vlowSqr);
+        const __m128 _vhighSqr = _mm_set1_ps(vhighSqr);
+
+        for (const u32 n = simd::count(effect->p_count); i < n; i += simd::width)
+        {
+            Particle* p = effect->particles + i;
+            const simd::vec3x4 vel = simd::load(p, &Particle::vel);
+            const __m128 vSqr = simd::length2(vel);
+            const __m128 mask = _mm_and_ps(_mm_cmpge_ps(vSqr, _vlowSqr), _mm_cmple_ps(vSqr, _vhighSqr));
+
+            const simd::vec3x4 damped =
+            {
+                _mm_mul_ps(vel.x, _scale_x),
+                _mm_mul_ps(vel.y, _scale_y),
+                _mm_mul_ps(vel.z, _scale_z)
+            };
+            simd::store(p, &Particle::vel, simd::select(mask, damped, vel));
+        }
+    }
+
+    for (; i < effect->p_count; i++)
     {
         Particle& m = effect->particles[i];
         float vSqr = m.vel.length2();
@@ -856,7 +885,27 @@ void PAGravity::Execute(ParticleEffect* effect, const float dt, float& tm_max)
 {
     pVector ddir(direction * dt);
 
-    for (u32 i = 0; i < effect->p_count; i++)
+    u32 i = 0;
+    if (simd_actions)
+    {
+        const __m128 _ddir_x = _mm_set1_ps(ddir.x);
+        const __m128 _ddir_y = _mm_set1_ps(ddir.y);
+        const __m128 _ddir_z = _mm_set1_ps(ddir.z);
+
+        for (const u32 n = simd::count(effect->p_count); i < n; i += simd::width)
+        {
+            Particle* p = effect->particles + i;
+            const simd::vec3x4 vel = simd::load(p, &Particle::vel);
+            simd::store(p, &Particle::vel,
+            {
+                _mm_add_ps(vel.x, _ddir_x),
+                _mm_add_ps(vel.y, _ddir_y),
+                _mm_add_ps(vel.z, _ddir_z)
+            });
+        }
+    }
+
+    for (; i < effect->p_count; i++)
     {
         // Step velocity with acceleration
         effect->particles[i].vel += ddir;
@@ -980,13 +1029,32 @@ void PAKillOld::Execute(ParticleEffect* effect, const float dt, float& tm_max)
 {
     // Must traverse list in reverse order so Remove will work
     tm_max = age_limit;
-    for (int i = effect->p_count - 1; i >= 0; i--)
+
+    // Particles which don't fill the whole group are checked first by the scalar code
+    const int simd_count = simd_actions ? int(simd::count(effect->p_count)) : 0;
+    for (int i = effect->p_count - 1; i >= simd_count; i--)
     {
         Particle& m = effect->particles[i];
 
         if (!((m.age < age_limit) ^ kill_less_than))
             effect->Remove(i);
     }
+
+    const __m128 _age_limit = _mm_set1_ps(age_limit);
+    for (int i = simd_count - int(simd::width); i >= 0; i -= simd::width)
+    {
+        // Remove only touches particles above i, so the whole group can be tested at once
+        const int younger = _mm_movemask_ps(_mm_cmplt_ps(simd::load(effect->particles + i, &Particle::age), _age_limit));
+        const int kill = kill_less_than ? younger : ~younger;
+        if (!(kill & 0xf))
+            continue;
+
+        for (int k = simd::width - 1; k >= 0; k--)
+        {
+            if (kill & (1 << k))
+                effect->Remove(i + k);
+        }
+    }
 }
 void PAKillOld::Transform(const Fmatrix&) { ; }
 //-------------------------------------------------------------------------------------------------
@@ -1050,8 +1118,30 @@ void PAMatchVelocity::Transform(const Fmatrix&) { ; }
 
 void PAMove::Execute(ParticleEffect* effect, const float dt, float& tm_max)
 {
+    u32 i = 0;
+    if (simd_actions)
+    {
+        const __m128 _dt = _mm_set1_ps(dt);
+
+        for (const u32 n = simd::count(effect->p_count); i < n; i += simd::width)
+        {
+            Particle* p = effect->particles + i;
+            const simd::vec3x4 pos = simd::load(p, &Particle::pos);
+            const simd::vec3x4 vel = simd::load(p, &Particle::vel);
+
+            simd::store(p, &Particle::age, _mm_add_ps(simd::load(p, &Particle::age), _dt));
+            simd::store(p, &Particle::posB, pos);
+            simd::store(p, &Particle::pos,
+            {
+                _mm_add_ps(pos.x, _mm_mul_ps(vel.x, _dt)),
+                _mm_add_ps(pos.y, _mm_mul_ps(vel.y, _dt)),
+                _mm_add_ps(pos.z, _mm_mul_ps(vel.z, _dt))
+            });
+        }
+    }
+
     // Step particle positions forward by dt, and age the particles.
-    for (u32 i = 0; i < effect->p_count; i++)
+    for (; i < effect->p_count; i++)
     {
         Particle& m = effect->particles[i];
         // move
@@ -1173,7 +1263,30 @@ void PAOrbitPoint::Transform(const Fmatrix& m) { m.transform_tiny(center, center
 // Accelerate in random direction each time step
 void PARandomAccel::Execute(ParticleEffect* effect, const float dt, float& tm_max)
 {
-    for (u32 i = 0; i < effect->p_count; i++)
+    u32 i = 0;
+    if (simd_actions)
+    {
+        const __m128 _dt = _mm_set1_ps(dt);
+
+        for (const u32 n = simd::count(effect->p_count); i < n; i += simd::width)
+        {
+            // Random numbers are taken in the same order as in the scalar code
+            pVector a[simd::width];
+            for (pVector& acceleration : a)
+                gen_acc.Generate(acceleration);
+
+            Particle* p = effect->particles + i;
+            const simd::vec3x4 vel = simd::load(p, &Particle::vel);
+            simd::store(p, &Particle::vel,
+            {
+                _mm_add_ps(vel.x, _mm_mul_ps(_mm_set_ps(a[3].x, a[2].x, a[1].x, a[0].x), _dt)),
+                _mm_add_ps(vel.y, _mm_mul_ps(_mm_set_ps(a[3].y, a[2].y, a[1].y, a[0].y), _dt)),
+                _mm_add_ps(vel.z, _mm_mul_ps(_mm_set_ps(a[3].z, a[2].z, a[1].z, a[0].z), _dt))
+            });
+        }
+    }
+
+    for (; i < effect->p_count; i++)
     {
         Particle& m = effect->particles[i];
 
@@ -1443,7 +1556,43 @@ void PATargetColor::Execute(ParticleEffect* effect, const float dt, float& tm_ma
     float scaleFac = scale * dt;
     Fcolor c_p, c_t;
 
-    for (u32 i = 0; i < effect->p_count; i++)
+    u32 i = 0;
+    if (simd_actions)
+    {
+        const __m128 _scaleFac = _mm_set1_ps(scaleFac);
+        const __m128 _color_r = _mm_set1_ps(color.x);
+        const __m128 _color_g = _mm_set1_ps(color.y);
+        const __m128 _color_b = _mm_set1_ps(color.z);
+        const __m128 _color_a = _mm_set1_ps(alpha);
+        const __m128 _timeFrom = _mm_set1_ps(timeFrom * tm_max);
+        const __m128 _timeTo = _mm_set1_ps(timeTo * tm_max);
+
+        for (const u32 n = simd::count(effect->p_count); i < n; i += simd::width)
+        {
+            Particle* p = effect->particles + i;
+            const __m128 age = simd::load(p, &Particle::age);
+            const __m128 skip = _mm_or_ps(_mm_cmplt_ps(age, _timeFrom), _mm_cmpgt_ps(age, _timeTo));
+            if (_mm_movemask_ps(skip) == 0xf)
+                continue;
+
+            const __m128i dw = simd::load(p, &Particle::color);
+            const __m128 a = simd::from_8bit(dw, 24);
+            const __m128 r = simd::from_8bit(dw, 16);
+            const __m128 g = simd::from_8bit(dw, 8);
+            const __m128 b = simd::from_8bit(dw, 0);
+
+            const __m128i t_a = simd::to_8bit(_mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_color_a, a), _scaleFac)));
+            const __m128i t_r = simd::to_8bit(_mm_add_ps(r, _mm_mul_ps(_mm_sub_ps(_color_r, r), _scaleFac)));
+            const __m128i t_g = simd::to_8bit(_mm_add_ps(g, _mm_mul_ps(_mm_sub_ps(_color_g, g), _scaleFac)));
+            const __m128i t_b = simd::to_8bit(_mm_add_ps(b, _mm_mul_ps(_mm_sub_ps(_color_b, b), _scaleFac)));
+
+            const __m128i result = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(t_a, 24), _mm_slli_epi32(t_r, 16)),
+                _mm_or_si128(_mm_slli_epi32(t_g, 8), t_b));
+            simd::store(p, &Particle::color, simd::select(_mm_castps_si128(skip), dw, result));
+        }
+    }
+
+    for (; i < effect->p_count; i++)
     {
         Particle& m = effect->particles[i];
         if (m.age < timeFrom * tm_max || m.age > timeTo * tm_max)
@@ -1465,7 +1614,30 @@ void PATargetSize::Execute(ParticleEffect* effect, const float dt, float& tm_max
     float scaleFac_y = scale.y * dt;
     float scaleFac_z = scale.z * dt;
 
-    for (u32 i = 0; i < effect->p_count; i++)
+    u32 i = 0;
+    if (simd_actions)
+    {
+        const __m128 _scaleFac_x = _mm_set1_ps(scaleFac_x);
+        const __m128 _scaleFac_y = _mm_set1_ps(scaleFac_y);
+        const __m128 _scaleFac_z = _mm_set1_ps(scaleFac_z);
+        const __m128 _size_x = _mm_set1_ps(size.x);
+        const __m128 _size_y = _mm_set1_ps(size.y);
+        const __m128 _size_z = _mm_set1_ps(size.z);
+
+        for (const u32 n = simd::count(effect->p_count); i < n; i += simd::width)
+        {
+            Particle* p = effect->particles + i;
+            const simd::vec3x4 sz = simd::load(p, &Particle::size);
+            simd::store(p, &Particle::size,
+            {
+                _mm_add_ps(sz.x, _mm_mul_ps(_mm_sub_ps(_size_x, sz.x), _scaleFac_x)),
+                _mm_add_ps(sz.y, _mm_mul_ps(_mm_sub_ps(_size_y, sz.y), _scaleFac_y)),
+                _mm_add_ps(sz.z, _mm_mul_ps(_mm_sub_ps(_size_z, sz.z), _scaleFac_z))
+            });
+        }
+    }
+
+    for (; i < effect->p_count; i++)
     {
         Particle& m = effect->particles[i];
         pVector dif(size - m.size);
@@ -1518,9 +1690,13 @@ void PAVortex::Execute(ParticleEffect* effect, const float dt, float& tm_max)
     float magdt = magnitude * dt;
     float max_radiusSqr = max_radius * max_radius;
 
+    u32 i = 0;
+    if (simd_actions)
+        i = ExecuteSIMD(effect, magdt, max_radiusSqr);
+
     if (max_radiusSqr < P_MAXFLOAT)
     {
-        for (u32 i = 0; i < effect->p_count; i++)
+        for (; i < effect->p_count; i++)
         {
             Particle& m = effect->particles[i];
 
@@ -1564,7 +1740,7 @@ void PAVortex::Execute(ParticleEffect* effect, const float dt, float& tm_max)
     }
     else
     {
-        for (u32 i = 0; i < effect->p_count; i++)
+        for (; i < effect->p_count; i++)
         {
             Particle& m = effect->particles[i];
 
@@ -1603,6 +1779,73 @@ void PAVortex::Execute(ParticleEffect* effect, const float dt, float& tm_max)
         }
     }
 }
+// Same as the scalar loops above, sin and cos are still taken per particle
+u32 PAVortex::ExecuteSIMD(ParticleEffect* effect, const float magdt, const float max_radiusSqr)
+{
+    const bool bounded = max_radiusSqr < P_MAXFLOAT;
+    const __m128 _max_radiusSqr = _mm_set1_ps(max_radiusSqr);
+    const __m128 _epsilon = _mm_set1_ps(epsilon);
+    const __m128 _magdt = _mm_set1_ps(magdt);
+    const __m128 _one = _mm_set1_ps(1.0f);
+    const simd::vec3x4 _center = { _mm_set1_ps(center.x), _mm_set1_ps(center.y), _mm_set1_ps(center.z) };
+    const simd::vec3x4 _axis = { _mm_set1_ps(axis.x), _mm_set1_ps(axis.y), _mm_set1_ps(axis.z) };
+
+    u32 i = 0;
+    for (const u32 n = simd::count(effect->p_count); i < n; i += simd::width)
+    {
+        Particle* p = effect->particles + i;
+        const simd::vec3x4 pos = simd::load(p, &Particle::pos);
+
+        const simd::vec3x4 offset =
+        {
+            _mm_sub_ps(pos.x, _center.x),
+            _mm_sub_ps(pos.y, _center.y),
+            _mm_sub_ps(pos.z, _center.z)
+        };
+        const __m128 rSqr = simd::length2(offset);
+
+        // Don't do anything to particle if too far, NaN passes like in the scalar code
+        const __m128 mask = bounded ? _mm_cmpngt_ps(rSqr, _max_radiusSqr) : _mm_castsi128_ps(_mm_set1_epi32(-1));
+        if (_mm_movemask_ps(mask) == 0)
+            continue;
+
+        const __m128 r = _mm_sqrt_ps(rSqr);
+        const __m128 invs = _mm_div_ps(_one, r);
+        const simd::vec3x4 offnorm = { _mm_mul_ps(offset.x, invs), _mm_mul_ps(offset.y, invs), _mm_mul_ps(offset.z, invs) };
+
+        const __m128 axisProj = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offnorm.x, _axis.x), _mm_mul_ps(offnorm.y, _axis.y)),
+            _mm_mul_ps(offnorm.z, _axis.z));
+
+        const simd::vec3x4 w = { _mm_mul_ps(_axis.x, axisProj), _mm_mul_ps(_axis.y, axisProj), _mm_mul_ps(_axis.z, axisProj) };
+        const simd::vec3x4 u = { _mm_sub_ps(offnorm.x, w.x), _mm_sub_ps(offnorm.y, w.y), _mm_sub_ps(offnorm.z, w.z) };
+        const simd::vec3x4 v =
+        {
+            _mm_sub_ps(_mm_mul_ps(_axis.y, u.z), _mm_mul_ps(_axis.z, u.y)),
+            _mm_sub_ps(_mm_mul_ps(_axis.z, u.x), _mm_mul_ps(_axis.x, u.z)),
+            _mm_sub_ps(_mm_mul_ps(_axis.x, u.y), _mm_mul_ps(_axis.y, u.x))
+        };
+
+        alignas(16) float theta[simd::width], sin_theta[simd::width], cos_theta[simd::width];
+        _mm_store_ps(theta, _mm_div_ps(_magdt, _mm_add_ps(rSqr, _epsilon)));
+        for (u32 k = 0; k < simd::width; k++)
+        {
+            sin_theta[k] = _sin(theta[k]);
+            cos_theta[k] = _cos(theta[k]);
+        }
+        const __m128 s = _mm_load_ps(sin_theta);
+        const __m128 c = _mm_load_ps(cos_theta);
+
+        const simd::vec3x4 result =
+        {
+            _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u.x, c), _mm_mul_ps(v.x, s)), w.x), r), _center.x),
+            _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u.y, c), _mm_mul_ps(v.y, s)), w.y), r), _center.y),
+            _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u.z, c), _mm_mul_ps(v.z, s)), w.z), r), _center.z)
+        };
+        simd::store(p, &Particle::pos, simd::select(mask, result, pos));
+    }
+    return i;
+}
+
 void PAVortex::Transform(const Fmatrix& m)
 {
     m.transform_tiny(center, centerL);
@@ -1618,14 +1861,6 @@ extern void noise3Init();
 
 #ifndef _EDITOR
 
-#if defined(XR_ARCHITECTURE_X86) || defined(XR_ARCHITECTURE_X64) || defined(XR_ARCHITECTURE_E2K)
-#include <xmmintrin.h>
-#elif defined(XR_ARCHITECTURE_ARM) || defined(XR_ARCHITECTURE_ARM64)
-#include "sse2neon/sse2neon.h"
-#else
-#error Add your platform here
-#endif
-
 ICF __m128 _mm_load_fvector(const Fvector& v)
 {
     __m128 R1, R2;
@@ -288,6 +288,9 @@ struct PARTICLES_API PAVortex : public ParticleAction
     float max_radius; // Only influence particles within max_radius
 
     _METHODS;
+
+private:
+    u32 ExecuteSIMD(ParticleEffect* effect, const float magdt, const float max_radiusSqr);
 };
 
 struct PARTICLES_API PATurbulence : public ParticleAction
@@ -24,7 +24,7 @@ float PAPI::NRand(float sigma)
     }
     while (drand48() > expf(-_sqr(y - 1.0f) * 0.5f));
 
-    if (rand() & 0x1)
+    if (random().randI() & 0x1)
         return y * sigma * ONE_OVER_SIGMA_EXP;
     return -y * sigma * ONE_OVER_SIGMA_EXP;
 }
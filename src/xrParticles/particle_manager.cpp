@@ -6,9 +6,25 @@
 
 using namespace PAPI;
 
+namespace
+{
+thread_local CRandom* s_random = nullptr;
+
+// Makes the action list generator current while its actions are executed
+class random_scope
+{
+    CRandom* m_saved;
+
+public:
+    random_scope(CRandom& random) : m_saved(s_random) { s_random = &random; }
+    ~random_scope() { s_random = m_saved; }
+};
+} // namespace
+
 // system
 CParticleManager PM;
 PARTICLES_API IParticleManager* PAPI::ParticleManager() { return &PM; }
+PARTICLES_API CRandom& PAPI::random() { return s_random ? *s_random : ::Random; }
 //
 CParticleManager::CParticleManager() {}
 CParticleManager::~CParticleManager() {}
@@ -72,6 +88,8 @@ int CParticleManager::CreateActionList()
     }
 
     m_alist_vec[list_id] = xr_new<ParticleActions>();
+    // Seed depends on the slot only, the same effects created in the same order repeat themselves
+    m_alist_vec[list_id]->random.seed(s32(u32(list_id + 1) * 0x9E3779B1u >> 1));
 
     return list_id;
 }
@@ -147,6 +165,7 @@ void CParticleManager::Update(int effect_id, int alist_id, float dt)
     VERIFY(pe);
 
     pa->lock();
+    random_scope scope(pa->random);
 
     // Step through all the actions in the action list.
     float kill_old_time = 1.0f;
@@ -0,0 +1,127 @@
+#pragma once
+
+#if defined(XR_ARCHITECTURE_X86) || defined(XR_ARCHITECTURE_X64) || defined(XR_ARCHITECTURE_E2K)
+#include <emmintrin.h>
+#elif defined(XR_ARCHITECTURE_ARM) || defined(XR_ARCHITECTURE_ARM64)
+#include "sse2neon/sse2neon.h"
+#else
+#error Add your platform here
+#endif
+
+// Helpers for the SIMD paths of particle actions.
+// Particles stay in AoS layout (renderer and callbacks work with PAPI::Particle),
+// groups of 4 particles are transposed into SoA registers while processing.
+// Kernels must do the same operations in the same order as the scalar code,
+// so the results are bit-identical.
+namespace PAPI
+{
+namespace simd
+{
+constexpr u32 width = 4;
+
+struct vec3x4
+{
+    __m128 x, y, z;
+};
+
+ICF u32 count(const u32 p_count) { return p_count & ~(width - 1); }
+
+ICF vec3x4 load(const Particle* p, pVector Particle::*field)
+{
+    // Each load takes one float past the vector, it's still inside of the particle
+    static_assert(sizeof(Particle) == 64, "Check the fields layout before loading 4 floats");
+    __m128 r0 = _mm_loadu_ps(&(p[0].*field).x);
+    __m128 r1 = _mm_loadu_ps(&(p[1].*field).x);
+    __m128 r2 = _mm_loadu_ps(&(p[2].*field).x);
+    __m128 r3 = _mm_loadu_ps(&(p[3].*field).x);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    return { r0, r1, r2 };
+}
+
+ICF void store3(pVector& v, const __m128 r)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(&v.x), r);
+    _mm_store_ss(&v.z, _mm_movehl_ps(r, r));
+}
+
+ICF void store(Particle* p, pVector Particle::*field, const vec3x4& v)
+{
+    __m128 r0 = v.x, r1 = v.y, r2 = v.z, r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    store3(p[0].*field, r0);
+    store3(p[1].*field, r1);
+    store3(p[2].*field, r2);
+    store3(p[3].*field, r3);
+}
+
+ICF __m128 load(const Particle* p, float Particle::*field)
+{
+    return _mm_set_ps(p[3].*field, p[2].*field, p[1].*field, p[0].*field);
+}
+
+ICF void store(Particle* p, float Particle::*field, const __m128 v)
+{
+    alignas(16) float r[width];
+    _mm_store_ps(r, v);
+    p[0].*field = r[0];
+    p[1].*field = r[1];
+    p[2].*field = r[2];
+    p[3].*field = r[3];
+}
+
+ICF __m128i load(const Particle* p, u32 Particle::*field)
+{
+    return _mm_set_epi32(p[3].*field, p[2].*field, p[1].*field, p[0].*field);
+}
+
+ICF void store(Particle* p, u32 Particle::*field, const __m128i v)
+{
+    alignas(16) u32 r[width];
+    _mm_store_si128(reinterpret_cast<__m128i*>(r), v);
+    p[0].*field = r[0];
+    p[1].*field = r[1];
+    p[2].*field = r[2];
+    p[3].*field = r[3];
+}
+
+// mask ? a : b
+ICF __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+ICF vec3x4 select(const __m128 mask, const vec3x4& a, const vec3x4& b)
+{
+    return { select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z) };
+}
+
+ICF __m128i select(const __m128i mask, const __m128i a, const __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// x * x + y * y + z * z, same order as pVector::length2()
+ICF __m128 length2(const vec3x4& v)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(v.x, v.x), _mm_mul_ps(v.y, v.y)), _mm_mul_ps(v.z, v.z));
+}
+
+// Same as clamp_to_8bit(iFloor(v * 255.f)) for each lane
+ICF __m128i to_8bit(const __m128 v)
+{
+    const __m128 max = _mm_set1_ps(255.f);
+    // Clamping before conversion gives the same result for any value that fits in int
+    // and allows to truncate instead of floor. NaN turns into 0 like in the scalar code.
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, max), _mm_setzero_ps()), max);
+    return _mm_cvttps_epi32(clamped);
+}
+
+ICF __m128 from_8bit(const __m128i color, const int shift)
+{
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128i channel = _mm_and_si128(_mm_srli_epi32(color, shift), mask);
+    // same as Fcolor::set(u32)
+    return _mm_mul_ps(_mm_set1_ps(1.f / 255.f), _mm_cvtepi32_ps(channel));
+}
+} // namespace simd
+} // namespace PAPI
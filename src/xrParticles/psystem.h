@@ -22,7 +22,13 @@
 #define P_MAXINT 0x7fffffff
 #endif
 
-#define drand48() ::Random.randF()
+namespace PAPI
+{
+// Generator of the action list being executed on this thread, see ParticleActions::random
+PARTICLES_API CRandom& random();
+} // namespace PAPI
+
+#define drand48() PAPI::random().randF()
 //#define drand48() (((float) rand())/((float) RAND_MAX))
 
 namespace PAPI
@@ -223,4 +229,8 @@ public:
 };
 
 PARTICLES_API IParticleManager* ParticleManager();
+
+// Process particles in groups of 4 in actions which support it.
+// Results are bit-identical to the scalar code.
+PARTICLES_API extern bool simd_actions;
 }
@@ -24,10 +24,18 @@ public:
         CStatTimer Collision; // collision
         CStatTimer Core; // integrate
         CStatTimer MovCollision; // movement+collision
+        u32 Islands; // active islands stepped
+        u32 ParallelSteps; // steps with islands integrated concurrently
+        u32 Bodies; // bodies in active islands
+        u32 Contacts; // contact joints created by collision
 
         PHWorldStatistics() { FrameStart(); }
         void FrameStart()
         {
+            Islands = 0;
+            ParallelSteps = 0;
+            Bodies = 0;
+            Contacts = 0;
             Collision.FrameStart();
             Core.FrameStart();
             MovCollision.FrameStart();
@@ -52,6 +60,7 @@ public:
     virtual void Freeze() = 0;
     virtual void UnFreeze() = 0;
     virtual void Step() = 0;
+    virtual void Benchmark(u32 steps_count) = 0;
     virtual void SetStep(float s) = 0;
     virtual void StepNumIterations(int num_it) = 0;
     virtual void set_default_contact_shotmark(ContactCallbackFun* f) = 0;
@@ -75,6 +84,7 @@ extern "C" XRPHYSICS_API void __stdcall create_physics_world(
 extern "C" XRPHYSICS_API void __stdcall destroy_physics_world();
 class CGameMtlLibrary;
 extern "C" XRPHYSICS_API CObjectSpace* __stdcall create_object_space();
+extern "C" XRPHYSICS_API CObjectSpace* __stdcall file_create_object_space(LPCSTR file_name);
 struct hdrCFORM;
 extern "C" XRPHYSICS_API CObjectSpace* __stdcall mesh_create_object_space(
     Fvector* verts, CDB::TRI* tris, const hdrCFORM& H, CDB::build_callback build_callback);
@@ -25,6 +25,8 @@
 #include "xrEngine/defines.h"
 #include "xrCDB/xr_area.h"
 #include "xrCore/FS_internal.h"
+#include "xrCore/Threading/ParallelFor.hpp"
+#include <ode/misc.h>
 #ifdef DEBUG
 //				void DBG_ObjAfterPhDataUpdate	( CPHObject *obj );
 //				void DBG_ObjBeforePhDataUpdate	( CPHObject *obj );
@@ -59,8 +61,12 @@ void __stdcall destroy_physics_world()
 
 CObjectSpace* __stdcall create_object_space()
 {
-    // CFileReader* fr =	new CFileReader("D:/STALKER/resources/gamedata/levels/stohe_selo/level.cform");
-    CFileReader* fr = xr_new<CFileReader>("ActorEditorLevel.cform");
+    // return file_create_object_space("D:/STALKER/resources/gamedata/levels/stohe_selo/level.cform");
+    return file_create_object_space("ActorEditorLevel.cform");
+}
+CObjectSpace* __stdcall file_create_object_space(LPCSTR file_name)
+{
+    CFileReader* fr = xr_new<CFileReader>(file_name);
     CObjectSpace* os = xr_new<CObjectSpace>();
     g_SpatialSpace = xr_new<ISpatial_DB>("Spatial obj");
     g_SpatialSpacePhysic = xr_new<ISpatial_DB>("Spatial phys");
@@ -116,7 +122,7 @@ CPHWorld::CPHWorld()
     : // IPHWorldUpdateCallbck		*_update_callback
       m_update_callback(&empty_update_callback),
       m_default_contact_shotmark(0), m_default_character_contact_shotmark(0), physics_step_time_callback(0),
-      m_object_space(0), m_level_objects(0)
+      m_object_space(0), m_level_objects(0), m_benchmark_snapshot(nullptr)
 {
     disable_count = 0;
     m_frame_time = 0.f;
@@ -264,6 +270,8 @@ void CPHWorld::DumpStatistics(IGameFont& font, IPerformanceAlert* alert)
     font.OutNext("Physics:      %2.2fms, %2.1f%%", stats.MovCollision.result, percentage);
     font.OutNext("- collider:   %2.2fms", stats.Collision.result);
     font.OutNext("- solver:     %2.2fms, %d", stats.Core.result, stats.Core.count);
+    font.OutNext("- islands:    %u, parallel steps: %u", stats.Islands, stats.ParallelSteps);
+    font.OutNext("- bodies:     %u, contacts: %u", stats.Bodies, stats.Contacts);
     if (alert && stats.MovCollision.result > 5.0f)
         alert->Print(font, "Physics   > 5ms:  %3.1f", stats.MovCollision.result);
 }
@@ -360,31 +368,7 @@ void CPHWorld::Step()
     m_update_callback->update_step();
     //	m_commander						->update();
     //////////////////////////////////////////////////////////////////////
-    for (i_object = m_objects.begin(); m_objects.end() != i_object;)
-    {
-        CPHObject* obj = (*i_object);
-        ++i_object;
-#ifdef DEBUG
-        if (debug_output().ph_dbg_draw_mask().test(phDbgDrawObjectStatistics))
-        {
-            if (obj->Island().IsActive())
-            {
-                debug_output().dbg_islands_num()++;
-                debug_output().dbg_joints_num() += obj->Island().nj;
-                debug_output().dbg_bodies_num() += obj->Island().nb;
-            }
-        }
-#endif
-
-#ifdef DEBUG
-        debug_output().DBG_ObjBeforeStep(obj);
-#endif
-        obj->IslandStep(fixed_step);
-
-#ifdef DEBUG
-        debug_output().DBG_ObjAfterStep(obj);
-#endif
-    }
+    StepIslands();
 
     stats.Core.End();
 
@@ -414,6 +398,7 @@ void CPHWorld::Step()
         obj->PhDataUpdate(fixed_step);
     }
 
+    stats.Contacts += ContactGroup->num;
 #ifdef DEBUG
     debug_output().dbg_contacts_num() = ContactGroup->num;
 #endif
@@ -428,6 +413,231 @@ void CPHWorld::Step()
     };
 }
 
+void CPHWorld::StepIslands()
+{
+    // Islands which are active after collision are disjoint by construction:
+    // merged islands are stepped through their active owner only.
+    // Each island gets its own random seed drawn here in the objects order,
+    // so the result doesn't depend on the execution order or threads count.
+    m_step_islands.clear();
+    for (PH_OBJECT_I i_object = m_objects.begin(); m_objects.end() != i_object; ++i_object)
+    {
+        CPHObject* obj = (*i_object);
+#ifdef DEBUG
+        if (debug_output().ph_dbg_draw_mask().test(phDbgDrawObjectStatistics))
+        {
+            if (obj->Island().IsActive())
+            {
+                debug_output().dbg_islands_num()++;
+                debug_output().dbg_joints_num() += obj->Island().nj;
+                debug_output().dbg_bodies_num() += obj->Island().nb;
+            }
+        }
+#endif
+        if (obj->Island().IsActive())
+        {
+            m_step_islands.push_back({ obj, dRand() });
+            stats.Bodies += obj->Island().nb;
+        }
+    }
+
+    const u32 count = m_step_islands.size();
+    stats.Islands += count;
+
+    // Stepping overwrites the seed of the thread, the main one continues
+    // with the sequence it had after drawing, whichever island it stepped last
+    const unsigned long seed = dRandGetSeed();
+
+    const auto stepIsland = [](const SIslandStep& island)
+    {
+        dRandSetSeed(island.seed);
+        island.object->IslandStep(fixed_step);
+    };
+
+    const bool parallel = ph_console::ph_mt_islands && count >= u32(ph_console::ph_mt_islands_min) &&
+        TaskScheduler->GetWorkersCount() > 1;
+
+#ifdef DEBUG
+    // debug output hooks are not thread safe
+    const bool debugHooks = !!debug_output().ph_dbg_draw_mask().test(phDbgDrawObjectStatistics);
+#else
+    constexpr bool debugHooks = false;
+#endif
+
+    if (!parallel || debugHooks)
+    {
+        for (const SIslandStep& island : m_step_islands)
+        {
+#ifdef DEBUG
+            debug_output().DBG_ObjBeforeStep(island.object);
+#endif
+            stepIsland(island);
+#ifdef DEBUG
+            debug_output().DBG_ObjAfterStep(island.object);
+#endif
+        }
+        dRandSetSeed(seed);
+        return;
+    }
+
+    ++stats.ParallelSteps;
+    // Islands differ a lot in cost, so let the scheduler split them one by one
+    xr_parallel_for(TaskRange<u32>(0, count, 1), [&](const TaskRange<u32>& range)
+    {
+        for (u32 i = range.begin(); i != range.end(); ++i)
+            stepIsland(m_step_islands[i]);
+    });
+    dRandSetSeed(seed);
+}
+
+struct CPHWorld::SBenchmarkSnapshot
+{
+    enum EActivation : u8
+    {
+        eInactive,
+        eActive,
+        eFreezed
+    };
+
+    xr_map<CPHObject*, EActivation> objects;
+    xr_map<CPHSynchronize*, SPHNetState> states;
+
+    // Objects activated during the run are added before they are stepped, so their state is the initial one
+    void add(CPHObject* object, EActivation activation)
+    {
+        if (!objects.emplace(object, activation).second)
+            return;
+
+        const u16 els = object->get_elements_number();
+        for (u16 i = 0; els > i; ++i)
+        {
+            CPHSynchronize* sync = object->get_element_sync(i);
+            SPHNetState& state = states[sync];
+            sync->get_State(state);
+            if (eInactive == activation)
+                state.enabled = false;
+        }
+    }
+
+    void restore() const
+    {
+        for (const auto& it : states)
+            it.first->set_State(it.second);
+
+        for (const auto& it : objects)
+        {
+            CPHObject* object = it.first;
+            switch (it.second)
+            {
+            case eInactive: object->deactivate(); break;
+            case eActive: object->activate(); break;
+            case eFreezed:
+                // Setting the state may have unfrozen it
+                object->activate();
+                object->Freeze();
+                break;
+            }
+        }
+    }
+
+    void get_result(xr_map<CPHSynchronize*, SPHNetState>& result) const
+    {
+        result.clear();
+        for (const auto& it : states)
+            it.first->get_State(result[it.first]);
+    }
+};
+
+void CPHWorld::Benchmark(u32 steps_count)
+{
+    if (IsFreezed() || b_processing)
+    {
+        Msg("! Physics benchmark: world is busy or frozen");
+        return;
+    }
+
+    // The benchmark replays the same scene from the same snapshot
+    // in single threaded and in parallel modes and compares results.
+    // Game side callbacks are detached so the replay doesn't affect the level.
+    SBenchmarkSnapshot snapshot;
+    for (PH_OBJECT_I it = m_objects.begin(); m_objects.end() != it; ++it)
+        snapshot.add(*it, SBenchmarkSnapshot::eActive);
+    for (PH_OBJECT_I it = m_freezed_objects.begin(); m_freezed_objects.end() != it; ++it)
+        snapshot.add(*it, SBenchmarkSnapshot::eFreezed);
+    const size_t elements = snapshot.states.size();
+    m_benchmark_snapshot = &snapshot;
+
+    xr_map<CPHSynchronize*, SPHNetState> serial_state, parallel_state;
+
+    const BOOL mt_islands = ph_console::ph_mt_islands;
+    IPHWorldUpdateCallbck* update_callback = m_update_callback;
+    PhysicsStepTimeCallback* step_time_callback = physics_step_time_callback;
+    m_update_callback = &empty_update_callback;
+    physics_step_time_callback = nullptr;
+    ph_object_contact_callbacks = false;
+
+    const unsigned long seed = dRandGetSeed();
+    const u64 steps_num = m_steps_num;
+
+    const auto run = [&](BOOL mt, xr_map<CPHSynchronize*, SPHNetState>& result)
+    {
+        snapshot.restore();
+        dRandSetSeed(seed);
+        ph_console::ph_mt_islands = mt;
+        stats.Islands = 0;
+
+        b_processing = true;
+        CTimer timer;
+        timer.Start();
+        for (u32 i = 0; i < steps_count; ++i)
+            Step();
+        const float time = timer.GetElapsed_sec() * 1000.f;
+        b_processing = false;
+
+        snapshot.get_result(result);
+        return time;
+    };
+
+    const float serial_time = run(FALSE, serial_state);
+    const float parallel_time = run(TRUE, parallel_state);
+    const u32 islands = stats.Islands;
+
+    // Elements woken up in one of the runs only have no pair and are counted as mismatched
+    float max_error = 0.f;
+    u32 mismatched = 0;
+    for (const auto& it : serial_state)
+    {
+        const auto parallel = parallel_state.find(it.first);
+        if (parallel == parallel_state.end() || parallel->second.enabled != it.second.enabled)
+        {
+            ++mismatched;
+            continue;
+        }
+        max_error = _max(max_error, it.second.position.distance_to(parallel->second.position));
+    }
+    for (const auto& it : parallel_state)
+    {
+        if (serial_state.find(it.first) == serial_state.end())
+            ++mismatched;
+    }
+
+    m_benchmark_snapshot = nullptr;
+    snapshot.restore();
+    dRandSetSeed(seed);
+    m_steps_num = steps_num;
+    ph_console::ph_mt_islands = mt_islands;
+    m_update_callback = update_callback;
+    physics_step_time_callback = step_time_callback;
+    ph_object_contact_callbacks = true;
+
+    Msg("* Physics benchmark: %u steps, %zu elements, %2.1f islands per step", steps_count, elements,
+        steps_count ? float(islands) / steps_count : 0.f);
+    Msg("* - single thread: %2.3fms, %2.3fms per step", serial_time, serial_time / _max(steps_count, 1u));
+    Msg("* - parallel:      %2.3fms, %2.3fms per step (%zu workers)", parallel_time,
+        parallel_time / _max(steps_count, 1u), TaskScheduler->GetWorkersCount());
+    Msg("* - max divergence: %f, %u elements with different activation", max_error, mismatched);
+}
+
 void CPHWorld::StepTouch()
 {
     PH_OBJECT_I i_object;
@@ -527,6 +737,8 @@ void CPHWorld::FrameStep(dReal step)
 
 void CPHWorld::AddObject(CPHObject* object)
 {
+    if (m_benchmark_snapshot)
+        m_benchmark_snapshot->add(object, SBenchmarkSnapshot::eInactive);
     m_objects.push_back(object);
     // xr_list <CPHObject*> ::iterator i= m_objects.end();
     // return (--m_objects.end());
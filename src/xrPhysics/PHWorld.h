@@ -58,6 +58,17 @@ private:
     PH_OBJECT_STORAGE m_recently_disabled_objects;
     PH_UPDATE_OBJECT_STORAGE m_update_objects;
     PH_UPDATE_OBJECT_STORAGE m_freezed_update_objects;
+
+    struct SIslandStep
+    {
+        CPHObject* object;
+        unsigned long seed;
+    };
+    xr_vector<SIslandStep> m_step_islands;
+
+    // Physics benchmark restores the scene from it, objects are added when they are activated
+    struct SBenchmarkSnapshot;
+    SBenchmarkSnapshot* m_benchmark_snapshot;
     dGeomID m_motion_ray;
     // CPHCommander				*m_commander;
     IPHWorldUpdateCallbck* m_update_callback;
@@ -110,6 +121,7 @@ public:
     void FrameStep(dReal step = 0.025f);
     void Step();
     void StepTouch();
+    void Benchmark(u32 steps_count) override;
     void CutVelocity(float l_limit, float a_limit);
     void GetState(V_PH_WORLD_STATE& state);
     void Freeze();
@@ -150,6 +162,7 @@ public:
 
 private:
     void StepNumIterations(int num_it);
+    void StepIslands();
     iphysics_scripted& get_scripted() { return *this; }
     void set_step_time_callback(PhysicsStepTimeCallback* cb) { physics_step_time_callback = cb; }
     void set_update_callback(IPHWorldUpdateCallbck* cb)
@@ -27,6 +27,8 @@ extern CPHWorld* ph_world;
 #include "ExtendedGeom.h"
 // PhysicsStepTimeCallback		*physics_step_time_callback				= 0;
 
+bool ph_object_contact_callbacks = true;
+
 const float default_w_limit = 9.8174770f; //(M_PI/16.f/(fixed_step=0.02f));
 const float default_l_limit = 150.f; //(3.f/fixed_step=0.02f);
 const float default_l_scale = 1.01f;
@@ -213,12 +215,12 @@ IC static int CollideIntoGroup(
             surface.bounce = std::min(material_1->fPHBouncing, material_2->fPHBouncing);
         }
         /////////////////////////////////////////////////////////////////////////////////////////////////
-        if (usr_data_2 && usr_data_2->object_callbacks)
+        if (usr_data_2 && usr_data_2->object_callbacks && ph_object_contact_callbacks)
         {
             usr_data_2->object_callbacks->Call(do_collide, false, c, material_1, material_2);
         }
 
-        if (usr_data_1 && usr_data_1->object_callbacks)
+        if (usr_data_1 && usr_data_1->object_callbacks && ph_object_contact_callbacks)
         {
             usr_data_1->object_callbacks->Call(do_collide, true, c, material_1, material_2);
         }
@@ -41,3 +41,5 @@ class CPHElement;
 class CPHShell;
 extern dJointGroupID ContactGroup;
 extern Fbox phBoundaries;
+// Game side contact callbacks are skipped while it's false, e.g. when the scene is replayed
+extern bool ph_object_contact_callbacks;
@@ -11,3 +11,6 @@ float ph_console::phBreakCommonFactor = 0.01f;
 float ph_console::phRigidBreakWeaponFactor = 1.f;
 
 float ph_console::ph_step_time = fixed_step;
+
+BOOL ph_console::ph_mt_islands = 1;
+int ph_console::ph_mt_islands_min = 4;
@@ -8,4 +8,6 @@ struct XRPHYSICS_API ph_console
     static float phBreakCommonFactor; //= 0.01f;
     static float phRigidBreakWeaponFactor; //= 1.f;
     static float ph_step_time; //=fixed_step;
+    static BOOL ph_mt_islands; //= 1;
+    static int ph_mt_islands_min; //= 4;
 };
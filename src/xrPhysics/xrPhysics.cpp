@@ -9,7 +9,12 @@
 #pragma managed(push, off)
 #endif
 
-static void* ode_alloc(size_t size) { return xr_malloc(size); }
+static void* ode_alloc(size_t size)
+{
+    MemoryTagScope scope(MemoryTag::Physics);
+    return xr_malloc(size);
+}
+
 static void* ode_realloc(void* ptr, size_t oldsize, size_t newsize) { return xr_realloc(ptr, newsize); }
 static void ode_free(void* ptr, size_t size) { return xr_free(ptr); }
 
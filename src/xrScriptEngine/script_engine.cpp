@@ -51,6 +51,7 @@ static void* lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
         xr_free(ptr);
         return nullptr;
     }
+    MemoryTagScope scope(MemoryTag::Scripts);
     return xr_realloc(ptr, nsize);
 }
 
@@ -62,6 +63,7 @@ static void* __cdecl luabind_allocator(void* context, const void* pointer, size_
         xr_free(non_const_pointer);
         return nullptr;
     }
+    MemoryTagScope scope(MemoryTag::Scripts);
     if (!pointer)
     {
         return xr_malloc(size);
@@ -17,6 +17,7 @@
 #define OBJECT_CHUNK_DATA 0x0002
 #define GAME_TIME_CHUNK_DATA 0x0005
 #define REGISTRY_CHUNK_DATA 0x0009
+#define OBJECT_DELTA_CHUNK_DATA 0x000a
 #define SECTION_HEADER "location_"
 #define SAVE_EXTENSION ".scop"
 #define SAVE_EXTENSION_LEGACY ".sav"
@@ -28,6 +28,7 @@ class CSE_ALifeDynamicObject;
 class CSE_ALifeObject;
 #ifdef XRGAME_EXPORTS
 class CALifeSmartTerrainTask;
+class CGraphEngine;
 #endif //#ifdef XRGAME_EXPORTS
 class CALifeMonsterAbstract;
 class CSE_ALifeInventoryItem;
@@ -85,6 +86,9 @@ public:
         CSE_ALifeSchedulable* tpALifeSchedulable, int iGroupIndex, bool bMutualDetection) = 0;
     virtual bool bfActive() = 0;
     virtual CSE_ALifeDynamicObject* tpfGetBestDetector() = 0;
+    // Thread-safe part of update(), called in parallel for the whole batch before updating it.
+    // Must touch nothing but the object itself and read-only navigation data.
+    virtual void prepare_update(CGraphEngine& /*engine*/) {}
 #endif
 };
 
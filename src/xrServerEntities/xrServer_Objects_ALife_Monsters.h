@@ -352,6 +352,7 @@ public:
     virtual void update(){};
 #else
     virtual void update();
+    virtual void prepare_update(CGraphEngine& engine);
     virtual CSE_ALifeItemWeapon* tpfGetBestWeapon(ALife::EHitType& tHitType, float& fHitPower);
     virtual ALife::EMeetActionType tfGetActionType(
         CSE_ALifeSchedulable* tpALifeSchedulable, int iGroupIndex, bool bMutualDetection);
@@ -698,6 +699,7 @@ public:
     virtual bool bfActive();
     virtual CSE_ALifeDynamicObject* tpfGetBestDetector();
     virtual void update();
+    virtual void prepare_update(CGraphEngine& engine);
     virtual bool need_update(CSE_ALifeDynamicObject* object);
     void register_member(ALife::_OBJECT_ID member_id);
     void unregister_member(ALife::_OBJECT_ID member_id);
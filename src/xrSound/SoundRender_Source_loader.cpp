@@ -149,6 +149,7 @@ bool CSoundRender_Source::LoadWave(pcstr pName, bool crashOnError)
 
 bool CSoundRender_Source::load(pcstr name, bool replaceWithNoSound /*= true*/, bool crashOnError /*= true*/)
 {
+    MemoryTagScope scope(MemoryTag::Sounds);
     string_path fn, N;
     xr_strcpy(N, name);
 #ifdef XR_PLATFORM_WINDOWS
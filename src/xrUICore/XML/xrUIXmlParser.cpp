@@ -21,6 +21,16 @@ shared_str CUIXml::correct_file_name(pcstr path, pcstr fn)
     return fn;
 }
 
+pcstr CUIXml::cache_variant() const
+{
+#ifdef XRUICORE_EXPORTS
+    // Widescreen variants of files are picked by get_xml_name()
+    return UI().is_widescreen() ? "ui_16" : "ui";
+#else
+    return "";
+#endif
+}
+
 CUIXml::CUIXml()
 {}
 
@@ -10,4 +10,5 @@ public:
     virtual ~CUIXml();
 
     virtual shared_str correct_file_name(pcstr path, pcstr fn);
+    pcstr cache_variant() const override;
 };
@@ -235,6 +235,7 @@ void UICore::OnUIReset()
 {
     CUIXmlInitBase::DeleteColorDefs();
     CUITextureMaster::FreeTexInfo();
+    XMLDocument::ClearCache();
 
     ReadTextureInfo();
     CUIXmlInitBase::InitColorDefs();